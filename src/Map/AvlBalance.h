@@ -0,0 +1,170 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_MAP_AVL_BALANCE_H_
+#define CPP2_S21_CONTAINERS_SRC_MAP_AVL_BALANCE_H_
+
+namespace s21 {
+
+// AVL balancing policy for BTree. Keeps the height below 1.44 * log2(n + 2),
+// so lookups visit fewer levels than in a red-black tree at the price of more
+// rotations on removal. Suits read-heavy trees
+struct AvlBalance {
+  // Balance factor height(right) - height(left) is stored shifted by one
+  static constexpr unsigned kLeftHeavy = 0;
+  static constexpr unsigned kBalanced = 1;
+  static constexpr unsigned kRightHeavy = 2;
+  static constexpr bool kCloneable = true;
+
+  template <typename Tree>
+  static void afterInsert(Tree& tree, typename Tree::node_type* node) {
+    using node_type = typename Tree::node_type;
+    node->setBalance(kBalanced);
+    for (node_type* parent = node->parent(); parent != nullptr;
+         parent = node->parent()) {
+      if (node == parent->right) {
+        if (parent->balance() == kRightHeavy) {
+          if (node->balance() == kLeftHeavy) {
+            rotateRightLeft(tree, parent);
+          } else {
+            rotateLeft(tree, parent);
+          }
+          return;
+        }
+        if (parent->balance() == kLeftHeavy) {
+          parent->setBalance(kBalanced);
+          return;
+        }
+        parent->setBalance(kRightHeavy);
+      } else {
+        if (parent->balance() == kLeftHeavy) {
+          if (node->balance() == kRightHeavy) {
+            rotateLeftRight(tree, parent);
+          } else {
+            rotateRight(tree, parent);
+          }
+          return;
+        }
+        if (parent->balance() == kRightHeavy) {
+          parent->setBalance(kBalanced);
+          return;
+        }
+        parent->setBalance(kLeftHeavy);
+      }
+      node = parent;
+    }
+  }
+
+  // Walks up from the shrunk subtree while the height keeps decreasing
+  template <typename Tree>
+  static void afterRemove(Tree& tree, const typename Tree::Removal& removal) {
+    using node_type = typename Tree::node_type;
+    bool shrunkLeft = removal.left;
+    for (node_type* parent = removal.parent; parent != nullptr;) {
+      node_type* grand = parent->parent();
+      bool parentLeft = grand != nullptr && grand->left == parent;
+      if (shrunkLeft) {
+        if (parent->balance() == kRightHeavy) {
+          node_type* sibling = parent->right;
+          if (sibling->balance() == kLeftHeavy) {
+            rotateRightLeft(tree, parent);
+          } else if (sibling->balance() == kBalanced) {
+            tree.rotateLeft(parent);
+            parent->setBalance(kRightHeavy);
+            sibling->setBalance(kLeftHeavy);
+            return;
+          } else {
+            rotateLeft(tree, parent);
+          }
+        } else if (parent->balance() == kBalanced) {
+          parent->setBalance(kRightHeavy);
+          return;
+        } else {
+          parent->setBalance(kBalanced);
+        }
+      } else {
+        if (parent->balance() == kLeftHeavy) {
+          node_type* sibling = parent->left;
+          if (sibling->balance() == kRightHeavy) {
+            rotateLeftRight(tree, parent);
+          } else if (sibling->balance() == kBalanced) {
+            tree.rotateRight(parent);
+            parent->setBalance(kLeftHeavy);
+            sibling->setBalance(kRightHeavy);
+            return;
+          } else {
+            rotateRight(tree, parent);
+          }
+        } else if (parent->balance() == kBalanced) {
+          parent->setBalance(kLeftHeavy);
+          return;
+        } else {
+          parent->setBalance(kBalanced);
+        }
+      }
+      shrunkLeft = parentLeft;
+      parent = grand;
+    }
+  }
+
+  // Links sorted nodes into a tree of minimal height, the left subtree of
+  // every node is at least as large as the right one
+  template <typename Tree>
+  static typename Tree::node_type* build(Tree& tree,
+                                         typename Tree::node_type** nodes,
+                                         typename Tree::size_type count) {
+    using node_type = typename Tree::node_type;
+    using size_type = typename Tree::size_type;
+    return tree.linkMedians(
+        nodes, count, nullptr, 0,
+        [](node_type* node, size_type, size_type left, size_type right) {
+          node->setBalance(Tree::medianHeight(left) > Tree::medianHeight(right)
+                               ? kLeftHeavy
+                               : kBalanced);
+        });
+  }
+
+ private:
+  // Single rotation of a doubly heavy node whose heavy child leans the same way
+  template <typename Tree>
+  static void rotateLeft(Tree& tree, typename Tree::node_type* node) {
+    typename Tree::node_type* pivot = node->right;
+    tree.rotateLeft(node);
+    node->setBalance(kBalanced);
+    pivot->setBalance(kBalanced);
+  }
+
+  template <typename Tree>
+  static void rotateRight(Tree& tree, typename Tree::node_type* node) {
+    typename Tree::node_type* pivot = node->left;
+    tree.rotateRight(node);
+    node->setBalance(kBalanced);
+    pivot->setBalance(kBalanced);
+  }
+
+  // Double rotations, the grandchild becomes the subtree root
+  template <typename Tree>
+  static void rotateRightLeft(Tree& tree, typename Tree::node_type* node) {
+    typename Tree::node_type* child = node->right;
+    typename Tree::node_type* pivot = child->left;
+    unsigned balance = pivot->balance();
+    tree.rotateRight(child);
+    tree.rotateLeft(node);
+    node->setBalance(balance == kRightHeavy ? kLeftHeavy : kBalanced);
+    child->setBalance(balance == kLeftHeavy ? kRightHeavy : kBalanced);
+    pivot->setBalance(kBalanced);
+  }
+
+  template <typename Tree>
+  static void rotateLeftRight(Tree& tree, typename Tree::node_type* node) {
+    typename Tree::node_type* child = node->left;
+    typename Tree::node_type* pivot = child->right;
+    unsigned balance = pivot->balance();
+    tree.rotateLeft(child);
+    tree.rotateRight(node);
+    node->setBalance(balance == kLeftHeavy ? kRightHeavy : kBalanced);
+    child->setBalance(balance == kRightHeavy ? kLeftHeavy : kBalanced);
+    pivot->setBalance(kBalanced);
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_MAP_AVL_BALANCE_H_
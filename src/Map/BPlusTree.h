@@ -0,0 +1,1065 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_MAP_B_PLUS_TREE_H_
+#define CPP2_S21_CONTAINERS_SRC_MAP_B_PLUS_TREE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "BTree.h"
+#include "NodePool.h"
+
+namespace s21 {
+
+// B+-tree with nodes of about NodeBytes bytes. Every node holds many keys in a
+// contiguous array, so a lookup touches one node (a few cache lines) per level
+// and the tree is several times shallower than a binary one. Entries live in
+// the leaves only, leaves are linked for iteration. Keys and values have to be
+// default constructible. Insertion and removal move entries inside a node, so
+// they invalidate iterators into that node
+template <typename KT, typename VT = KT, std::size_t NodeBytes = 256,
+          typename Compare = std::less<KT>>
+class BPlusTree : public CompareHolder<Compare> {
+  struct Inner;
+  struct Leaf;
+
+ public:
+  class iterator;
+  class const_iterator;
+
+  using node_type = Leaf;
+  // Entries live in leaf arrays, there are no nodes to hand out
+  using node_handle = NoNodeHandle;
+  using size_type = std::size_t;
+  // What iterators and search hand out as the value, the key itself in a
+  // key-only tree
+  using mapped_type =
+      std::conditional_t<std::is_same_v<VT, KeyOnly>, const KT, VT>;
+
+  BPlusTree();
+  explicit BPlusTree(const Compare&);
+  BPlusTree(const BPlusTree&) = delete;
+  BPlusTree(BPlusTree&&) noexcept;
+  ~BPlusTree();
+  BPlusTree& operator=(const BPlusTree&) = delete;
+  BPlusTree& operator=(BPlusTree&&) noexcept;
+  iterator insert(KT, VT);
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplaceUnique(K&&, Args&&...);
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplaceHint(iterator, K&&, Args&&...);
+  template <typename It>
+  void assignSorted(It first, It last);
+  void assign(const BPlusTree&);
+  template <typename K>
+  mapped_type* search(const K&);
+  template <typename K>
+  iterator searchNode(const K&);
+  template <typename K>
+  const_iterator searchNode(const K&) const;
+  template <typename K>
+  iterator lowerBound(const K&) const;
+  template <typename K>
+  iterator upperBound(const K&) const;
+  template <typename K>
+  std::pair<iterator, iterator> equalRange(const K&) const;
+  void erase(iterator);
+  size_type mergeUnique(BPlusTree&);
+  void clear() noexcept;
+  void swap(BPlusTree&) noexcept;
+  iterator begin() const;
+  iterator end() const;
+  size_type height() const;
+  iterator nth(size_type index) const;
+  template <typename K>
+  size_type rank(const K& key) const;
+
+ private:
+  struct Header {
+    Inner* parent;
+    size_type count;
+    bool leaf;
+  };
+
+  static constexpr size_type kHeaderBytes = sizeof(Header) + 2 * sizeof(void*);
+  static constexpr size_type kLeafSlots = std::max<size_type>(
+      4, (NodeBytes - kHeaderBytes) / (sizeof(KT) + sizeof(VT)));
+  static constexpr size_type kInnerSlots = std::max<size_type>(
+      4, (NodeBytes - kHeaderBytes) / (sizeof(KT) + sizeof(void*)));
+  static constexpr size_type kLeafMin = kLeafSlots / 2;
+  static constexpr size_type kInnerMin = kInnerSlots / 2;
+  static constexpr bool kLinearScan =
+      std::is_arithmetic_v<KT> && std::is_same_v<Compare, std::less<KT>>;
+
+  struct Leaf : Header {
+    Leaf* next;
+    Leaf* prev;
+    KT keys[kLeafSlots];
+    VT values[kLeafSlots];
+
+    mapped_type& mapped(size_type index) {
+      if constexpr (std::is_same_v<VT, KeyOnly>) {
+        return keys[index];
+      } else {
+        return values[index];
+      }
+    }
+  };
+
+  struct Inner : Header {
+    KT keys[kInnerSlots];
+    Header* children[kInnerSlots + 1];
+  };
+
+  Header* root_;
+  Leaf* first_;
+  NodePool<Leaf> leaves_;
+  NodePool<Inner> inners_;
+
+  Leaf* newLeaf();
+  Inner* newInner();
+  template <typename K>
+  size_type lowerBound(const KT* keys, size_type count, const K& key) const;
+  template <typename K>
+  size_type upperBound(const KT* keys, size_type count, const K& key) const;
+  template <typename K>
+  Leaf* findLeaf(const K& key) const;
+  Leaf* lastLeaf() const;
+  template <typename K>
+  iterator insertAt(Leaf* leaf, size_type pos, K&& key, VT value);
+  static size_type childIndex(const Inner* parent, const Header* child);
+  void insertIntoParent(Header* left, const KT& separator, Header* right);
+  void rebalanceLeaf(Leaf* leaf);
+  void removeFromInner(Inner* node, size_type keyIndex, size_type childIndex);
+  void rebalanceInner(Inner* node);
+  void destroy(Header* node) noexcept;
+  template <typename It, typename Split>
+  void build(It first, It last, Split split);
+  void fillLeaves(std::vector<Header*>& level);
+  Header* linkLevels(std::vector<Header*>& level,
+                     std::vector<Inner*>& inners);
+};
+
+// Selects the B+-tree engine for Map and Set, e.g. Map<KT, VT, BPlusLayout<>>
+template <std::size_t NodeBytes = 256>
+struct BPlusLayout {};
+
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+struct TreeEngine<KT, VT, BPlusLayout<NodeBytes>, Compare> {
+  using type = BPlusTree<KT, VT, NodeBytes, Compare>;
+};
+
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+BPlusTree<KT, VT, NodeBytes, Compare>::BPlusTree()
+    : root_(nullptr), first_(nullptr), leaves_(), inners_() {}
+
+// Empty tree ordered by compare
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+BPlusTree<KT, VT, NodeBytes, Compare>::BPlusTree(const Compare& compare)
+    : CompareHolder<Compare>(compare),
+      root_(nullptr),
+      first_(nullptr),
+      leaves_(),
+      inners_() {}
+
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+BPlusTree<KT, VT, NodeBytes, Compare>::BPlusTree(BPlusTree&& other) noexcept
+    : BPlusTree(other.keyCompare()) {
+  swap(other);
+}
+
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+BPlusTree<KT, VT, NodeBytes, Compare>::~BPlusTree() {
+  clear();
+}
+
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+BPlusTree<KT, VT, NodeBytes, Compare>&
+BPlusTree<KT, VT, NodeBytes, Compare>::operator=(BPlusTree&& other) noexcept {
+  if (this == &other) return *this;
+  clear();
+  swap(other);
+  return *this;
+}
+
+// Inserts an entry after all equal keys, splitting full nodes on the way up
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::iterator
+BPlusTree<KT, VT, NodeBytes, Compare>::insert(KT key, VT value) {
+  if (root_ == nullptr) {
+    first_ = newLeaf();
+    root_ = first_;
+  }
+  Leaf* leaf = findLeaf(key);
+  size_type pos = upperBound(leaf->keys, leaf->count, key);
+  return insertAt(leaf, pos, std::move(key), std::move(value));
+}
+
+// Finds the key or the place for it in one descent. The value is built from
+// args only when the key is missing. Leaf slots always hold constructed
+// entries, so the new key and value are moved into their slot, never copied
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+template <typename K, typename... Args>
+std::pair<typename BPlusTree<KT, VT, NodeBytes, Compare>::iterator, bool>
+BPlusTree<KT, VT, NodeBytes, Compare>::emplaceUnique(K&& key, Args&&... args) {
+  if (root_ == nullptr) {
+    first_ = newLeaf();
+    root_ = first_;
+  }
+  Leaf* leaf = findLeaf(key);
+  size_type pos = lowerBound(leaf->keys, leaf->count, key);
+  if (pos < leaf->count && !this->keyCompare()(key, leaf->keys[pos])) {
+    return {iterator(leaf, pos, this), false};
+  }
+  return {insertAt(leaf, pos, std::forward<K>(key),
+                   VT(std::forward<Args>(args)...)),
+          true};
+}
+
+// Like emplaceUnique, but a key within the key range of the hint's leaf is
+// placed without a descent from the root. Keys outside that range may belong
+// to a neighbour leaf under the separators and take the full path
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+template <typename K, typename... Args>
+std::pair<typename BPlusTree<KT, VT, NodeBytes, Compare>::iterator, bool>
+BPlusTree<KT, VT, NodeBytes, Compare>::emplaceHint(iterator hint, K&& key,
+                                                   Args&&... args) {
+  Leaf* leaf = hint.leaf_;
+  const Compare& less = this->keyCompare();
+  if (leaf == nullptr || less(key, leaf->keys[0]) ||
+      less(leaf->keys[leaf->count - 1], key)) {
+    return emplaceUnique(std::forward<K>(key), std::forward<Args>(args)...);
+  }
+  size_type pos = lowerBound(leaf->keys, leaf->count, key);
+  if (!less(key, leaf->keys[pos])) {
+    return {iterator(leaf, pos, this), false};
+  }
+  return {insertAt(leaf, pos, std::forward<K>(key),
+                   VT(std::forward<Args>(args)...)),
+          true};
+}
+
+// Puts the entry at pos of the leaf, splitting the leaf when it is full
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+template <typename K>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::iterator
+BPlusTree<KT, VT, NodeBytes, Compare>::insertAt(Leaf* leaf, size_type pos,
+                                                K&& key, VT value) {
+  if (leaf->count == kLeafSlots) {
+    Leaf* right = newLeaf();
+    size_type half = kLeafSlots / 2;
+    std::move(leaf->keys + half, leaf->keys + kLeafSlots, right->keys);
+    std::move(leaf->values + half, leaf->values + kLeafSlots, right->values);
+    right->count = kLeafSlots - half;
+    leaf->count = half;
+    right->next = leaf->next;
+    right->prev = leaf;
+    if (leaf->next) {
+      leaf->next->prev = right;
+    }
+    leaf->next = right;
+    insertIntoParent(leaf, right->keys[0], right);
+    if (pos > half) {
+      leaf = right;
+      pos -= half;
+    }
+  }
+  std::move_backward(leaf->keys + pos, leaf->keys + leaf->count,
+                     leaf->keys + leaf->count + 1);
+  std::move_backward(leaf->values + pos, leaf->values + leaf->count,
+                     leaf->values + leaf->count + 1);
+  leaf->keys[pos] = std::forward<K>(key);
+  leaf->values[pos] = std::move(value);
+  ++leaf->count;
+  return iterator(leaf, pos, this);
+}
+
+// Replaces the contents with [first, last), which has to be in key order. The
+// elements are (key, value) pairs or, for sets, plain keys
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+template <typename It>
+void BPlusTree<KT, VT, NodeBytes, Compare>::assignSorted(It first, It last) {
+  if constexpr (std::is_same_v<VT, KeyOnly>) {
+    build(first, last, [](It& it) -> std::pair<const KT&, const VT&> {
+      return {*it, key_only};
+    });
+  } else if constexpr (std::is_convertible_v<decltype(*first), const KT&>) {
+    build(first, last, [](It& it) -> std::pair<const KT&, const VT&> {
+      return {*it, *it};
+    });
+  } else {
+    build(first, last, [](It& it) -> std::pair<const KT&, const VT&> {
+      return {it->first, it->second};
+    });
+  }
+}
+
+// Replaces the contents with a copy of other
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+void BPlusTree<KT, VT, NodeBytes, Compare>::assign(const BPlusTree& other) {
+  if (this == &other) return;
+  CompareHolder<Compare>::operator=(other);
+  build(other.begin(), other.end(),
+        [](iterator& it) -> std::pair<const KT&, const VT&> {
+          return {it.first(), it.second()};
+        });
+}
+
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+template <typename K>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::mapped_type*
+BPlusTree<KT, VT, NodeBytes, Compare>::search(const K& key) {
+  iterator it = searchNode(key);
+  return it == end() ? nullptr : &it.second();
+}
+
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+template <typename K>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::iterator
+BPlusTree<KT, VT, NodeBytes, Compare>::searchNode(const K& key) {
+  const_iterator it = std::as_const(*this).searchNode(key);
+  return iterator(it.leaf_, it.index_, this);
+}
+
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+template <typename K>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::const_iterator
+BPlusTree<KT, VT, NodeBytes, Compare>::searchNode(const K& key) const {
+  if (root_ == nullptr) {
+    return end();
+  }
+  Leaf* leaf = findLeaf(key);
+  size_type pos = lowerBound(leaf->keys, leaf->count, key);
+  if (pos == leaf->count || this->keyCompare()(key, leaf->keys[pos])) {
+    return end();
+  }
+  return const_iterator(leaf, pos, this);
+}
+
+// Iterator to the first entry not less than key. When all keys in the leaf
+// that would hold key are smaller, that is the first entry of the next leaf
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+template <typename K>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::iterator
+BPlusTree<KT, VT, NodeBytes, Compare>::lowerBound(const K& key) const {
+  if (root_ == nullptr) {
+    return end();
+  }
+  Leaf* leaf = findLeaf(key);
+  size_type pos = lowerBound(leaf->keys, leaf->count, key);
+  if (pos == leaf->count) {
+    return leaf->next ? iterator(leaf->next, 0, this) : end();
+  }
+  return iterator(leaf, pos, this);
+}
+
+// Iterator to the first entry greater than key
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+template <typename K>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::iterator
+BPlusTree<KT, VT, NodeBytes, Compare>::upperBound(const K& key) const {
+  if (root_ == nullptr) {
+    return end();
+  }
+  Leaf* leaf = findLeaf(key);
+  size_type pos = upperBound(leaf->keys, leaf->count, key);
+  if (pos == leaf->count) {
+    return leaf->next ? iterator(leaf->next, 0, this) : end();
+  }
+  return iterator(leaf, pos, this);
+}
+
+// Range of the entries equivalent to key, at most one as keys are unique
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+template <typename K>
+std::pair<typename BPlusTree<KT, VT, NodeBytes, Compare>::iterator,
+          typename BPlusTree<KT, VT, NodeBytes, Compare>::iterator>
+BPlusTree<KT, VT, NodeBytes, Compare>::equalRange(const K& key) const {
+  return {lowerBound(key), upperBound(key)};
+}
+
+// Removes the entry, underfull nodes borrow from or merge with a sibling
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+void BPlusTree<KT, VT, NodeBytes, Compare>::erase(iterator pos) {
+  Leaf* leaf = pos.leaf_;
+  if (leaf == nullptr) {
+    return;
+  }
+  std::move(leaf->keys + pos.index_ + 1, leaf->keys + leaf->count,
+            leaf->keys + pos.index_);
+  std::move(leaf->values + pos.index_ + 1, leaf->values + leaf->count,
+            leaf->values + pos.index_);
+  --leaf->count;
+  if (leaf == root_) {
+    if (leaf->count == 0) {
+      leaves_.destroy(leaf);
+      root_ = nullptr;
+      first_ = nullptr;
+    }
+    return;
+  }
+  if (leaf->count < kLeafMin) {
+    rebalanceLeaf(leaf);
+  }
+}
+
+// Moves the entries of other whose keys are missing here into this tree and
+// returns how many there were. Leaves hold entries by value, so each one is
+// moved rather than relinked, and other is rebuilt from the entries it keeps
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::size_type
+BPlusTree<KT, VT, NodeBytes, Compare>::mergeUnique(BPlusTree& other) {
+  if (&other == this) {
+    return 0;
+  }
+  size_type moved = 0;
+  std::vector<std::pair<KT, VT>> kept;
+  for (Leaf* leaf = other.first_; leaf; leaf = leaf->next) {
+    for (size_type i = 0; i < leaf->count; ++i) {
+      if (emplaceUnique(std::move(leaf->keys[i]), std::move(leaf->values[i]))
+              .second) {
+        ++moved;
+      } else {
+        kept.emplace_back(std::move(leaf->keys[i]),
+                          std::move(leaf->values[i]));
+      }
+    }
+  }
+  using kept_iterator = typename std::vector<std::pair<KT, VT>>::iterator;
+  other.build(kept.begin(), kept.end(),
+              [](kept_iterator& it) -> std::pair<KT&&, VT&&> {
+                return {std::move(it->first), std::move(it->second)};
+              });
+  return moved;
+}
+
+// Frees all nodes, whole slabs at once when nothing has to be destroyed
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+void BPlusTree<KT, VT, NodeBytes, Compare>::clear() noexcept {
+  if (root_ && (!std::is_trivially_destructible_v<Leaf> ||
+                !std::is_trivially_destructible_v<Inner>)) {
+    destroy(root_);
+  }
+  leaves_.release();
+  inners_.release();
+  root_ = nullptr;
+  first_ = nullptr;
+}
+
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+void BPlusTree<KT, VT, NodeBytes, Compare>::swap(BPlusTree& other) noexcept {
+  using std::swap;
+  swap(root_, other.root_);
+  swap(first_, other.first_);
+  leaves_.swap(other.leaves_);
+  inners_.swap(other.inners_);
+  this->swapCompare(other);
+}
+
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::iterator
+BPlusTree<KT, VT, NodeBytes, Compare>::begin() const {
+  return iterator(first_, 0, this);
+}
+
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::iterator
+BPlusTree<KT, VT, NodeBytes, Compare>::end() const {
+  return iterator(nullptr, 0, this);
+}
+
+// Returns the number of levels, all leaves are on the same one
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::size_type
+BPlusTree<KT, VT, NodeBytes, Compare>::height() const {
+  size_type result = 0;
+  for (Header* node = root_; node;
+       node = node->leaf ? nullptr : static_cast<Inner*>(node)->children[0]) {
+    ++result;
+  }
+  return result;
+}
+
+// Element with index elements before it in key order, skipping whole leaves
+// by their count, which makes it O(n / B) for B keys per leaf
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::iterator
+BPlusTree<KT, VT, NodeBytes, Compare>::nth(size_type index) const {
+  Leaf* leaf = first_;
+  while (leaf && index >= leaf->count) {
+    index -= leaf->count;
+    leaf = leaf->next;
+  }
+  return leaf ? iterator(leaf, index, this) : end();
+}
+
+// Number of keys less than key, counted a leaf at a time like nth
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+template <typename K>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::size_type
+BPlusTree<KT, VT, NodeBytes, Compare>::rank(const K& key) const {
+  size_type result = 0;
+  Leaf* leaf = first_;
+  for (; leaf && this->keyCompare()(leaf->keys[leaf->count - 1], key);
+       leaf = leaf->next) {
+    result += leaf->count;
+  }
+  return leaf ? result + lowerBound(leaf->keys, leaf->count, key) : result;
+}
+
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::Leaf*
+BPlusTree<KT, VT, NodeBytes, Compare>::newLeaf() {
+  Leaf* leaf = leaves_.create();
+  leaf->parent = nullptr;
+  leaf->count = 0;
+  leaf->leaf = true;
+  leaf->next = nullptr;
+  leaf->prev = nullptr;
+  return leaf;
+}
+
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::Inner*
+BPlusTree<KT, VT, NodeBytes, Compare>::newInner() {
+  Inner* inner = inners_.create();
+  inner->parent = nullptr;
+  inner->count = 0;
+  inner->leaf = false;
+  return inner;
+}
+
+// Position of the first key not less than key. Arithmetic keys in the default
+// order are counted with a branchless scan that the compiler vectorizes, which
+// beats a binary search over a few cache lines because it has no mispredicted
+// branches
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+template <typename K>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::size_type
+BPlusTree<KT, VT, NodeBytes, Compare>::lowerBound(const KT* keys,
+                                                  size_type count,
+                                                  const K& key) const {
+  if constexpr (kLinearScan) {
+    size_type result = 0;
+    for (size_type i = 0; i < count; ++i) {
+      result += keys[i] < key;
+    }
+    return result;
+  } else {
+    return std::lower_bound(keys, keys + count, key, this->keyCompare()) - keys;
+  }
+}
+
+// Position of the first key greater than key
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+template <typename K>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::size_type
+BPlusTree<KT, VT, NodeBytes, Compare>::upperBound(const KT* keys,
+                                                  size_type count,
+                                                  const K& key) const {
+  if constexpr (kLinearScan) {
+    size_type result = 0;
+    for (size_type i = 0; i < count; ++i) {
+      result += !(key < keys[i]);
+    }
+    return result;
+  } else {
+    return std::upper_bound(keys, keys + count, key, this->keyCompare()) - keys;
+  }
+}
+
+// Child i of an inner node holds the keys in [keys[i - 1], keys[i])
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+template <typename K>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::Leaf*
+BPlusTree<KT, VT, NodeBytes, Compare>::findLeaf(const K& key) const {
+  Header* node = root_;
+  while (!node->leaf) {
+    Inner* inner = static_cast<Inner*>(node);
+    size_type index = upperBound(inner->keys, inner->count, key);
+    node = inner->children[index];
+  }
+  return static_cast<Leaf*>(node);
+}
+
+// Rightmost leaf, where decrementing end() lands
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::Leaf*
+BPlusTree<KT, VT, NodeBytes, Compare>::lastLeaf() const {
+  Header* node = root_;
+  while (node && !node->leaf) {
+    Inner* inner = static_cast<Inner*>(node);
+    node = inner->children[inner->count];
+  }
+  return static_cast<Leaf*>(node);
+}
+
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::size_type
+BPlusTree<KT, VT, NodeBytes, Compare>::childIndex(const Inner* parent,
+                                                  const Header* child) {
+  return std::find(parent->children, parent->children + parent->count + 1,
+                   child) -
+         parent->children;
+}
+
+// Links a node split off from left into the parent, splitting the parent
+// when it is full
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+void BPlusTree<KT, VT, NodeBytes, Compare>::insertIntoParent(
+    Header* left, const KT& separator, Header* right) {
+  Inner* parent = left->parent;
+  if (parent == nullptr) {
+    parent = newInner();
+    parent->keys[0] = separator;
+    parent->children[0] = left;
+    parent->children[1] = right;
+    parent->count = 1;
+    left->parent = parent;
+    right->parent = parent;
+    root_ = parent;
+    return;
+  }
+  size_type index = childIndex(parent, left);
+  if (parent->count < kInnerSlots) {
+    std::move_backward(parent->keys + index, parent->keys + parent->count,
+                       parent->keys + parent->count + 1);
+    std::move_backward(parent->children + index + 1,
+                       parent->children + parent->count + 1,
+                       parent->children + parent->count + 2);
+    parent->keys[index] = separator;
+    parent->children[index + 1] = right;
+    right->parent = parent;
+    ++parent->count;
+    return;
+  }
+  KT keys[kInnerSlots + 1];
+  Header* children[kInnerSlots + 2];
+  std::move(parent->keys, parent->keys + index, keys);
+  keys[index] = separator;
+  std::move(parent->keys + index, parent->keys + kInnerSlots,
+            keys + index + 1);
+  std::copy(parent->children, parent->children + index + 1, children);
+  children[index + 1] = right;
+  std::copy(parent->children + index + 1, parent->children + kInnerSlots + 1,
+            children + index + 2);
+  size_type half = (kInnerSlots + 1) / 2;
+  Inner* sibling = newInner();
+  std::move(keys, keys + half, parent->keys);
+  std::copy(children, children + half + 1, parent->children);
+  parent->count = half;
+  std::move(keys + half + 1, keys + kInnerSlots + 1, sibling->keys);
+  std::copy(children + half + 1, children + kInnerSlots + 2,
+            sibling->children);
+  sibling->count = kInnerSlots - half;
+  for (size_type i = 0; i <= parent->count; ++i) {
+    parent->children[i]->parent = parent;
+  }
+  for (size_type i = 0; i <= sibling->count; ++i) {
+    sibling->children[i]->parent = sibling;
+  }
+  insertIntoParent(parent, keys[half], sibling);
+}
+
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+void BPlusTree<KT, VT, NodeBytes, Compare>::rebalanceLeaf(Leaf* leaf) {
+  Inner* parent = leaf->parent;
+  size_type index = childIndex(parent, leaf);
+  Leaf* left =
+      index > 0 ? static_cast<Leaf*>(parent->children[index - 1]) : nullptr;
+  Leaf* right = index < parent->count
+                    ? static_cast<Leaf*>(parent->children[index + 1])
+                    : nullptr;
+  if (left && left->count > kLeafMin) {
+    std::move_backward(leaf->keys, leaf->keys + leaf->count,
+                       leaf->keys + leaf->count + 1);
+    std::move_backward(leaf->values, leaf->values + leaf->count,
+                       leaf->values + leaf->count + 1);
+    --left->count;
+    leaf->keys[0] = std::move(left->keys[left->count]);
+    leaf->values[0] = std::move(left->values[left->count]);
+    ++leaf->count;
+    parent->keys[index - 1] = leaf->keys[0];
+  } else if (right && right->count > kLeafMin) {
+    leaf->keys[leaf->count] = std::move(right->keys[0]);
+    leaf->values[leaf->count] = std::move(right->values[0]);
+    ++leaf->count;
+    std::move(right->keys + 1, right->keys + right->count, right->keys);
+    std::move(right->values + 1, right->values + right->count, right->values);
+    --right->count;
+    parent->keys[index] = right->keys[0];
+  } else {
+    if (left == nullptr) {
+      left = leaf;
+      leaf = right;
+      ++index;
+    }
+    std::move(leaf->keys, leaf->keys + leaf->count, left->keys + left->count);
+    std::move(leaf->values, leaf->values + leaf->count,
+              left->values + left->count);
+    left->count += leaf->count;
+    left->next = leaf->next;
+    if (leaf->next) {
+      leaf->next->prev = left;
+    }
+    leaves_.destroy(leaf);
+    removeFromInner(parent, index - 1, index);
+  }
+}
+
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+void BPlusTree<KT, VT, NodeBytes, Compare>::removeFromInner(
+    Inner* node, size_type keyIndex, size_type childIndex) {
+  std::move(node->keys + keyIndex + 1, node->keys + node->count,
+            node->keys + keyIndex);
+  std::copy(node->children + childIndex + 1,
+            node->children + node->count + 1, node->children + childIndex);
+  --node->count;
+  if (node == root_) {
+    if (node->count == 0) {
+      root_ = node->children[0];
+      root_->parent = nullptr;
+      inners_.destroy(node);
+    }
+    return;
+  }
+  if (node->count < kInnerMin) {
+    rebalanceInner(node);
+  }
+}
+
+// Borrows through the parent from a sibling with spare keys or merges with
+// one, pulling the separator down
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+void BPlusTree<KT, VT, NodeBytes, Compare>::rebalanceInner(Inner* node) {
+  Inner* parent = node->parent;
+  size_type index = childIndex(parent, node);
+  Inner* left =
+      index > 0 ? static_cast<Inner*>(parent->children[index - 1]) : nullptr;
+  Inner* right = index < parent->count
+                     ? static_cast<Inner*>(parent->children[index + 1])
+                     : nullptr;
+  if (left && left->count > kInnerMin) {
+    std::move_backward(node->keys, node->keys + node->count,
+                       node->keys + node->count + 1);
+    std::move_backward(node->children, node->children + node->count + 1,
+                       node->children + node->count + 2);
+    node->keys[0] = std::move(parent->keys[index - 1]);
+    node->children[0] = left->children[left->count];
+    node->children[0]->parent = node;
+    parent->keys[index - 1] = std::move(left->keys[left->count - 1]);
+    --left->count;
+    ++node->count;
+  } else if (right && right->count > kInnerMin) {
+    node->keys[node->count] = std::move(parent->keys[index]);
+    node->children[node->count + 1] = right->children[0];
+    node->children[node->count + 1]->parent = node;
+    parent->keys[index] = std::move(right->keys[0]);
+    std::move(right->keys + 1, right->keys + right->count, right->keys);
+    std::copy(right->children + 1, right->children + right->count + 1,
+              right->children);
+    --right->count;
+    ++node->count;
+  } else {
+    if (left == nullptr) {
+      left = node;
+      node = right;
+      ++index;
+    }
+    left->keys[left->count] = std::move(parent->keys[index - 1]);
+    std::move(node->keys, node->keys + node->count,
+              left->keys + left->count + 1);
+    std::copy(node->children, node->children + node->count + 1,
+              left->children + left->count + 1);
+    for (size_type i = 0; i <= node->count; ++i) {
+      node->children[i]->parent = left;
+    }
+    left->count += node->count + 1;
+    inners_.destroy(node);
+    removeFromInner(parent, index - 1, index);
+  }
+}
+
+// Runs the destructors of a subtree, the recursion depth is the tree height
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+void BPlusTree<KT, VT, NodeBytes, Compare>::destroy(Header* node) noexcept {
+  if (node->leaf) {
+    static_cast<Leaf*>(node)->~Leaf();
+    return;
+  }
+  Inner* inner = static_cast<Inner*>(node);
+  for (size_type i = 0; i <= inner->count; ++i) {
+    destroy(inner->children[i]);
+  }
+  inner->~Inner();
+}
+
+// Bulk loads a sorted range bottom up in O(n): the leaves are filled one after
+// another, then every inner level is built over the level below it
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+template <typename It, typename Split>
+void BPlusTree<KT, VT, NodeBytes, Compare>::build(It first, It last,
+                                                  Split split) {
+  clear();
+  std::vector<Header*> level;
+  std::vector<Inner*> inners;
+  try {
+    Leaf* leaf = nullptr;
+    for (; first != last; ++first) {
+      if (leaf == nullptr || leaf->count == kLeafSlots) {
+        level.push_back(nullptr);
+        Leaf* next = newLeaf();
+        level.back() = next;
+        if (leaf) {
+          leaf->next = next;
+          next->prev = leaf;
+        } else {
+          first_ = next;
+        }
+        leaf = next;
+      }
+      auto [key, value] = split(first);
+      leaf->keys[leaf->count] = std::forward<decltype(key)>(key);
+      leaf->values[leaf->count] = std::forward<decltype(value)>(value);
+      ++leaf->count;
+    }
+    fillLeaves(level);
+    root_ = linkLevels(level, inners);
+  } catch (...) {
+    if (!std::is_trivially_destructible_v<Leaf> ||
+        !std::is_trivially_destructible_v<Inner>) {
+      for (Leaf* leaf = first_; leaf; leaf = leaf->next) {
+        leaf->~Leaf();
+      }
+      for (Inner* inner : inners) {
+        if (inner) {
+          inner->~Inner();
+        }
+      }
+    }
+    root_ = nullptr;
+    clear();
+    throw;
+  }
+}
+
+// Only the last leaf can be underfull after filling, it takes half of the
+// entries of its full neighbour
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+void BPlusTree<KT, VT, NodeBytes, Compare>::fillLeaves(
+    std::vector<Header*>& level) {
+  if (level.size() < 2) {
+    return;
+  }
+  Leaf* leaf = static_cast<Leaf*>(level.back());
+  Leaf* left = leaf->prev;
+  if (leaf->count >= kLeafMin) {
+    return;
+  }
+  size_type shift = (left->count - leaf->count) / 2;
+  std::move_backward(leaf->keys, leaf->keys + leaf->count,
+                     leaf->keys + leaf->count + shift);
+  std::move_backward(leaf->values, leaf->values + leaf->count,
+                     leaf->values + leaf->count + shift);
+  std::move(left->keys + left->count - shift, left->keys + left->count,
+            leaf->keys);
+  std::move(left->values + left->count - shift, left->values + left->count,
+            leaf->values);
+  left->count -= shift;
+  leaf->count += shift;
+}
+
+// Builds the inner levels over the leaves and returns the root. Children are
+// spread evenly, which keeps every inner node at least half full
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+typename BPlusTree<KT, VT, NodeBytes, Compare>::Header*
+BPlusTree<KT, VT, NodeBytes, Compare>::linkLevels(std::vector<Header*>& level,
+                                                  std::vector<Inner*>& inners) {
+  if (level.empty()) {
+    return nullptr;
+  }
+  std::vector<const KT*> lows(level.size());
+  for (size_type i = 0; i < level.size(); ++i) {
+    lows[i] = &static_cast<Leaf*>(level[i])->keys[0];
+  }
+  while (level.size() > 1) {
+    size_type parents = (level.size() + kInnerSlots) / (kInnerSlots + 1);
+    size_type share = level.size() / parents;
+    size_type extra = level.size() % parents;
+    std::vector<Header*> upper;
+    std::vector<const KT*> upperLows;
+    upper.reserve(parents);
+    upperLows.reserve(parents);
+    for (size_type i = 0, child = 0; i < parents; ++i) {
+      size_type children = share + (i < extra ? 1 : 0);
+      inners.push_back(nullptr);
+      Inner* inner = newInner();
+      inners.back() = inner;
+      upperLows.push_back(lows[child]);
+      for (size_type j = 0; j < children; ++j, ++child) {
+        if (j > 0) {
+          inner->keys[j - 1] = *lows[child];
+        }
+        inner->children[j] = level[child];
+        level[child]->parent = inner;
+      }
+      inner->count = children - 1;
+      upper.push_back(inner);
+    }
+    level.swap(upper);
+    lows.swap(upperLows);
+  }
+  return level[0];
+}
+
+// ITERATORS
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+class BPlusTree<KT, VT, NodeBytes, Compare>::iterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = std::remove_const_t<mapped_type>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = mapped_type*;
+  using reference = mapped_type&;
+
+  iterator() : leaf_(nullptr), index_(0), tree_(nullptr) {}
+  iterator(Leaf* leaf, size_type index, const BPlusTree* tree)
+      : leaf_(leaf), index_(index), tree_(tree) {}
+
+  iterator& operator++() {
+    if (!leaf_) {
+      return *this;
+    }
+    if (++index_ == leaf_->count) {
+      leaf_ = leaf_->next;
+      index_ = 0;
+    }
+    return *this;
+  }
+
+  iterator operator++(int) {
+    iterator old = *this;
+    ++*this;
+    return old;
+  }
+
+  iterator& operator--() {
+    if (!leaf_) {
+      leaf_ = tree_->lastLeaf();
+      index_ = leaf_ ? leaf_->count : 0;
+    } else if (index_ == 0) {
+      leaf_ = leaf_->prev;
+      index_ = leaf_ ? leaf_->count : 0;
+    }
+    if (leaf_) {
+      --index_;
+    }
+    return *this;
+  }
+
+  iterator operator--(int) {
+    iterator old = *this;
+    --*this;
+    return old;
+  }
+
+  mapped_type& operator*() const { return leaf_->mapped(index_); }
+
+  bool operator==(const iterator& other) const {
+    return leaf_ == other.leaf_ && index_ == other.index_;
+  }
+
+  bool operator!=(const iterator& other) const { return !(*this == other); }
+
+  node_type* getNode() { return leaf_; }
+  KT& first() { return leaf_->keys[index_]; }
+  mapped_type& second() { return leaf_->mapped(index_); }
+
+ private:
+  friend class BPlusTree;
+  friend class const_iterator;
+
+  Leaf* leaf_;
+  size_type index_;
+  const BPlusTree* tree_;
+};
+
+template <typename KT, typename VT, std::size_t NodeBytes, typename Compare>
+class BPlusTree<KT, VT, NodeBytes, Compare>::const_iterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = std::remove_const_t<mapped_type>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const mapped_type*;
+  using reference = const mapped_type&;
+
+  const_iterator() : leaf_(nullptr), index_(0), tree_(nullptr) {}
+  const_iterator(Leaf* leaf, size_type index, const BPlusTree* tree)
+      : leaf_(leaf), index_(index), tree_(tree) {}
+  const_iterator(const iterator& it)
+      : leaf_(it.leaf_), index_(it.index_), tree_(it.tree_) {}
+
+  const_iterator& operator++() {
+    if (!leaf_) {
+      return *this;
+    }
+    if (++index_ == leaf_->count) {
+      leaf_ = leaf_->next;
+      index_ = 0;
+    }
+    return *this;
+  }
+
+  const_iterator operator++(int) {
+    const_iterator old = *this;
+    ++*this;
+    return old;
+  }
+
+  const_iterator& operator--() {
+    if (!leaf_) {
+      leaf_ = tree_->lastLeaf();
+      index_ = leaf_ ? leaf_->count : 0;
+    } else if (index_ == 0) {
+      leaf_ = leaf_->prev;
+      index_ = leaf_ ? leaf_->count : 0;
+    }
+    if (leaf_) {
+      --index_;
+    }
+    return *this;
+  }
+
+  const_iterator operator--(int) {
+    const_iterator old = *this;
+    --*this;
+    return old;
+  }
+
+  const mapped_type& operator*() const { return leaf_->mapped(index_); }
+
+  bool operator==(const const_iterator& other) const {
+    return leaf_ == other.leaf_ && index_ == other.index_;
+  }
+
+  bool operator!=(const const_iterator& other) const {
+    return !(*this == other);
+  }
+
+  const KT& first() const { return leaf_->keys[index_]; }
+  const mapped_type& second() const { return leaf_->mapped(index_); }
+
+ private:
+  friend class BPlusTree;
+
+  Leaf* leaf_;
+  size_type index_;
+  const BPlusTree* tree_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_MAP_B_PLUS_TREE_H_
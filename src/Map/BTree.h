@@ -1,203 +1,1245 @@
 #ifndef CPP2_S21_CONTAINERS_SRC_MAP_BINARY_TREE_H_
 #define CPP2_S21_CONTAINERS_SRC_MAP_BINARY_TREE_H_
 
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <stack>
 #include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "AvlBalance.h"
+#include "NoBalance.h"
 #include "Node.h"
+#include "NodeHandle.h"
+#include "NodePool.h"
+#include "OrderStatistic.h"
+#include "RedBlackBalance.h"
+#include "Threaded.h"
+#include "ThreeWayCompare.h"
+#include "TreapBalance.h"
 
 namespace s21 {
 
-template <typename KT, typename VT = KT>
-class BTree {
+template <typename KT, typename VT = KT, typename Balance = RedBlackBalance,
+          typename Compare = std::less<KT>>
+class BTree : public CompareHolder<Compare> {
  public:
   class iterator;
   class const_iterator;
 
-  using node_type = Node<KT, VT>;
+  static constexpr bool kCounted = CountedPolicy<Balance>::value;
+  static constexpr bool kThreaded = ThreadedPolicy<Balance>::value;
+
+  using node_type = Node<KT, VT, kCounted, kThreaded>;
+  using node_handle = NodeHandle<KT, VT, kCounted, kThreaded>;
+  using size_type = std::size_t;
+  // What iterators and search hand out as the value, the key itself in a
+  // key-only tree
+  using mapped_type =
+      std::conditional_t<std::is_same_v<VT, KeyOnly>, const KT, VT>;
+
+  // Describes the spot a removed node left behind for the balancing policy
+  struct Removal {
+    node_type* replacement;  // node moved into the removed node's place
+    node_type* parent;       // parent of the subtree that lost a level
+    bool left;               // whether that subtree is the parent's left one
+    unsigned balance;        // balancing state of the node that left the spot
+  };
 
   BTree();
+  explicit BTree(const Compare&);
+  BTree(const BTree&) = delete;
+  BTree(BTree&&) noexcept;
+  ~BTree();
+  BTree& operator=(const BTree&) = delete;
+  BTree& operator=(BTree&&) noexcept;
   iterator insert(KT, VT);
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplaceUnique(K&&, Args&&...);
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplaceHint(iterator, K&&, Args&&...);
+  template <typename It>
+  void assignSorted(It first, It last);
+  void assign(const BTree&);
   node_type* getRoot();
-  VT* search(const KT&);
-  iterator searchNode(const KT&);
-  void removeNode(node_type*, KT);
-  void destroy(node_type*);
+  template <typename K>
+  mapped_type* search(const K&);
+  template <typename K>
+  iterator searchNode(const K&);
+  template <typename K>
+  const_iterator searchNode(const K&) const;
+  template <typename K>
+  iterator lowerBound(const K&) const;
+  template <typename K>
+  iterator upperBound(const K&) const;
+  template <typename K>
+  std::pair<iterator, iterator> equalRange(const K&) const;
+  void removeNode(node_type*);
+  node_handle extract(iterator);
+  std::pair<iterator, bool> insertUnique(node_handle&);
+  iterator insertEqual(node_handle&);
+  size_type mergeUnique(BTree&);
+  size_type mergeEqual(BTree&);
+  void erase(iterator);
+  size_type erase(iterator first, iterator last);
+  void clear() noexcept;
+  void swap(BTree&) noexcept;
   iterator begin() const;
   iterator end() const;
+  size_type height() const;
+  size_type rotations() const noexcept;
+  iterator nth(size_type index) const;
+  template <typename K>
+  size_type rank(const K& key) const;
+  template <typename K>
+  size_type count(const K& key) const;
 
  private:
+  friend Balance;
+  friend typename CountedPolicy<Balance>::base;
+
+  using three_way = ThreeWayCompare<KT, Compare>;
+
+  // Spot for a new key: the free child slot of parent on the given side,
+  // unless equal already holds the key
+  struct Place {
+    node_type* parent;
+    bool toLeft;
+    node_type* equal;
+  };
+
   node_type* root;
+  node_type* rightmost_;
+  size_type rotations_;
+  NodePool<node_type> pool_;
+
+  template <typename K, typename... Args>
+  iterator link(node_type* parent, bool toLeft, K&& key, Args&&... args);
+  iterator attach(node_type* parent, bool toLeft, node_type* node);
+  void unlink(node_type* node);
+  template <typename K>
+  Place uniquePlace(const K& key) const;
+  template <typename K>
+  Place equalPlace(const K& key) const;
+  template <bool Unique>
+  size_type merge(BTree& other);
+  static node_type* predecessor(node_type* node);
+  static node_type* successor(node_type* node);
+  static node_type* treePredecessor(node_type* node);
+  static node_type* treeSuccessor(node_type* node);
+  void threadNodes();
+  template <typename L, typename R>
+  bool less(const L& left, const R& right) const;
+  template <typename K>
+  node_type* findNode(const K& key) const;
+  template <typename K>
+  node_type* lowerNode(const K& key) const;
+  template <typename K>
+  node_type* upperNode(const K& key) const;
+
+  static size_type subtreeSize(const node_type* node);
+  static void recount(node_type* node);
+  void recountPath(node_type* node);
+  void countSubtrees();
+  void rotateLeft(node_type* node);
+  void rotateRight(node_type* node);
+  void transplant(node_type* node, node_type* child);
+  template <typename It, typename Split>
+  void build(It first, It last, Split split);
+  void clone(const node_type* source);
+  template <typename Mark>
+  static node_type* linkMedians(node_type** nodes, size_type count,
+                                node_type* parent, size_type depth,
+                                const Mark& mark);
+  static size_type medianHeight(size_type count);
+};
 
-  void updateParent(node_type* node, node_type* successor);
-  iterator insert(node_type*, KT, VT);
+// Tags for the container constructors that bulk load a range already in key
+// order, without duplicates for Map and Set
+struct sorted_unique_t {
+  explicit sorted_unique_t() = default;
 };
+inline constexpr sorted_unique_t sorted_unique{};
 
-template <typename KT, typename VT>
-BTree<KT, VT>::BTree() : root(nullptr) {}
+struct sorted_equivalent_t {
+  explicit sorted_equivalent_t() = default;
+};
+inline constexpr sorted_equivalent_t sorted_equivalent{};
+
+template <typename KT, typename VT, typename Balance, typename Compare>
+BTree<KT, VT, Balance, Compare>::BTree()
+    : root(nullptr), rightmost_(nullptr), rotations_(0), pool_() {}
 
-template <typename KT, typename VT>
-typename BTree<KT, VT>::iterator BTree<KT, VT>::insert(KT key, VT value) {
-  return insert(root, key, value);
+// Empty tree ordered by compare
+template <typename KT, typename VT, typename Balance, typename Compare>
+BTree<KT, VT, Balance, Compare>::BTree(const Compare& compare)
+    : CompareHolder<Compare>(compare),
+      root(nullptr),
+      rightmost_(nullptr),
+      rotations_(0),
+      pool_() {}
+
+template <typename KT, typename VT, typename Balance, typename Compare>
+BTree<KT, VT, Balance, Compare>::BTree(BTree&& other) noexcept
+    : BTree(other.keyCompare()) {
+  swap(other);
 }
 
-template <typename KT, typename VT>
-typename BTree<KT, VT>::node_type* BTree<KT, VT>::getRoot() {
-  return root;
+template <typename KT, typename VT, typename Balance, typename Compare>
+BTree<KT, VT, Balance, Compare>::~BTree() {
+  clear();
+}
+
+template <typename KT, typename VT, typename Balance, typename Compare>
+BTree<KT, VT, Balance, Compare>& BTree<KT, VT, Balance, Compare>::operator=(
+    BTree&& other) noexcept {
+  if (this == &other) return *this;
+  clear();
+  swap(other);
+  return *this;
+}
+
+// Inserts a node and lets the balancing policy restore its invariants, equal
+// keys are placed to the right of the existing ones
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::iterator
+BTree<KT, VT, Balance, Compare>::insert(KT key, VT value) {
+  Place place = equalPlace(key);
+  return link(place.parent, place.toLeft, std::move(key), std::move(value));
 }
 
-template <typename KT, typename VT>
-VT* BTree<KT, VT>::search(const KT& key) {
+// Finds the key or the place for it in one descent. The value is built from
+// args inside the new node only when the key is missing, and key is moved into
+// it when passed as an rvalue. Returns the node with the key and whether it
+// was inserted
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K, typename... Args>
+std::pair<typename BTree<KT, VT, Balance, Compare>::iterator, bool>
+BTree<KT, VT, Balance, Compare>::emplaceUnique(K&& key, Args&&... args) {
+  Place place = uniquePlace(key);
+  if (place.equal) {
+    return {iterator(place.equal, this), false};
+  }
+  return {link(place.parent, place.toLeft, std::forward<K>(key),
+               std::forward<Args>(args)...),
+          true};
+}
+
+// Looks for the key and the slot it would take in one descent. With a native
+// three-way comparison the descent stops at an equal key, otherwise it does
+// one comparison per level and checks the in-order predecessor of the free
+// slot for equality at the end
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K>
+typename BTree<KT, VT, Balance, Compare>::Place
+BTree<KT, VT, Balance, Compare>::uniquePlace(const K& key) const {
+  Place place{nullptr, false, nullptr};
   node_type* current = root;
-  while (current) {
-    if (current->key == key) {
-      return &current->value;
+  if constexpr (three_way::kNative) {
+    while (current) {
+      int order = three_way::compare(this->keyCompare(), key, current->key);
+      if (order == 0) {
+        place.equal = current;
+        return place;
+      }
+      place.parent = current;
+      place.toLeft = order < 0;
+      current = place.toLeft ? current->left : current->right;
     }
-    if (std::less<KT>{}(key, current->key)) {
-      current = current->left;
-    } else {
-      current = current->right;
+  } else {
+    while (current) {
+      place.parent = current;
+      place.toLeft = less(key, current->key);
+      current = place.toLeft ? current->left : current->right;
+    }
+    node_type* before = place.parent && place.toLeft
+                            ? predecessor(place.parent)
+                            : place.parent;
+    if (before && !less(before->key, key)) {
+      place.equal = before;
     }
   }
-  return nullptr;
+  return place;
 }
 
-template <typename KT, typename VT>
-typename BTree<KT, VT>::iterator BTree<KT, VT>::searchNode(const KT& key) {
+// Slot for the key after all equal keys
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K>
+typename BTree<KT, VT, Balance, Compare>::Place
+BTree<KT, VT, Balance, Compare>::equalPlace(const K& key) const {
+  Place place{nullptr, false, nullptr};
   node_type* current = root;
   while (current) {
-    if (current->key == key) {
-      return iterator(current);
+    place.parent = current;
+    place.toLeft = less(key, current->key);
+    current = place.toLeft ? current->left : current->right;
+  }
+  return place;
+}
+
+// Like emplaceUnique, but when the key belongs right before hint or right
+// after it, the node is linked there without a descent from the root. Feeding
+// keys in order with end() or the previous result as hint costs amortized
+// O(1) per insert on top of rebalancing
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K, typename... Args>
+std::pair<typename BTree<KT, VT, Balance, Compare>::iterator, bool>
+BTree<KT, VT, Balance, Compare>::emplaceHint(iterator hint, K&& key,
+                                             Args&&... args) {
+  node_type* node = hint.getNode();
+  if (node == nullptr) {
+    if (rightmost_ && less(rightmost_->key, key)) {
+      return {link(rightmost_, false, std::forward<K>(key),
+                   std::forward<Args>(args)...),
+              true};
     }
-    if (std::less<KT>{}(key, current->key)) {
-      current = current->left;
-    } else {
-      current = current->right;
+  } else if (less(key, node->key)) {
+    node_type* before = predecessor(node);
+    if (before == nullptr || less(before->key, key)) {
+      return {before && before->right == nullptr
+                  ? link(before, false, std::forward<K>(key),
+                         std::forward<Args>(args)...)
+                  : link(node, true, std::forward<K>(key),
+                         std::forward<Args>(args)...),
+              true};
+    }
+  } else if (less(node->key, key)) {
+    node_type* after = successor(node);
+    if (after == nullptr || less(key, after->key)) {
+      return {node->right == nullptr
+                  ? link(node, false, std::forward<K>(key),
+                         std::forward<Args>(args)...)
+                  : link(after, true, std::forward<K>(key),
+                         std::forward<Args>(args)...),
+              true};
     }
+  } else {
+    return {hint, false};
+  }
+  return emplaceUnique(std::forward<K>(key), std::forward<Args>(args)...);
+}
+
+// Replaces the contents with [first, last), which has to be in key order. The
+// elements are (key, value) pairs or, for sets, plain keys
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename It>
+void BTree<KT, VT, Balance, Compare>::assignSorted(It first, It last) {
+  if constexpr (std::is_same_v<VT, KeyOnly>) {
+    build(first, last, [](It& it) -> std::pair<const KT&, const VT&> {
+      return {*it, key_only};
+    });
+  } else if constexpr (std::is_convertible_v<decltype(*first), const KT&>) {
+    build(first, last, [](It& it) -> std::pair<const KT&, const VT&> {
+      return {*it, *it};
+    });
+  } else {
+    build(first, last, [](It& it) -> std::pair<const KT&, const VT&> {
+      return {it->first, it->second};
+    });
   }
-  return iterator(nullptr);
 }
 
-template <typename KT, typename VT>
-void BTree<KT, VT>::removeNode(node_type* node, KT key) {
+// Replaces the contents and the ordering with a copy of other's. The copy has
+// the same shape and balancing state unless the policy ties them to node
+// addresses
+template <typename KT, typename VT, typename Balance, typename Compare>
+void BTree<KT, VT, Balance, Compare>::assign(const BTree& other) {
+  if (this == &other) return;
+  CompareHolder<Compare>::operator=(other);
+  if constexpr (Balance::kCloneable) {
+    clear();
+    pool_.reserve(other.pool_.size());
+    try {
+      clone(other.root);
+    } catch (...) {
+      clear();
+      throw;
+    }
+    threadNodes();
+  } else {
+    build(other.begin(), other.end(),
+          [](iterator& it) -> std::pair<const KT&, const VT&> {
+            return {it.first(), it.second()};
+          });
+  }
+}
+
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::node_type*
+BTree<KT, VT, Balance, Compare>::getRoot() {
+  return root;
+}
+
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K>
+typename BTree<KT, VT, Balance, Compare>::mapped_type*
+BTree<KT, VT, Balance, Compare>::search(const K& key) {
+  node_type* node = findNode(key);
+  return node ? &node->mapped() : nullptr;
+}
+
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K>
+typename BTree<KT, VT, Balance, Compare>::iterator
+BTree<KT, VT, Balance, Compare>::searchNode(const K& key) {
+  return iterator(findNode(key), this);
+}
+
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K>
+typename BTree<KT, VT, Balance, Compare>::const_iterator
+BTree<KT, VT, Balance, Compare>::searchNode(const K& key) const {
+  return const_iterator(findNode(key), this);
+}
+
+// Iterator to the first element not less than key, in one descent
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K>
+typename BTree<KT, VT, Balance, Compare>::iterator
+BTree<KT, VT, Balance, Compare>::lowerBound(const K& key) const {
+  return iterator(lowerNode(key), this);
+}
+
+// Iterator to the first element greater than key, in one descent
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K>
+typename BTree<KT, VT, Balance, Compare>::iterator
+BTree<KT, VT, Balance, Compare>::upperBound(const K& key) const {
+  return iterator(upperNode(key), this);
+}
+
+// Range of the elements equivalent to key
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K>
+std::pair<typename BTree<KT, VT, Balance, Compare>::iterator,
+          typename BTree<KT, VT, Balance, Compare>::iterator>
+BTree<KT, VT, Balance, Compare>::equalRange(const K& key) const {
+  return {lowerBound(key), upperBound(key)};
+}
+
+// Unlinks the node from the tree and frees it
+template <typename KT, typename VT, typename Balance, typename Compare>
+void BTree<KT, VT, Balance, Compare>::removeNode(node_type* node) {
   if (node == nullptr) {
     return;
   }
-  // Сase 1
-  if (node->hasNoChild()) {
-    if (node->key != key) {
-      auto dNode = searchNode(key).getNode();
-      node->swap(*dNode);
+  unlink(node);
+  pool_.destroy(node);
+}
+
+// Takes the element out of the tree together with its node. The node stays
+// where it is in memory and the handle owns it from now on, the slab it lives
+// in is kept alive for it by one more reference
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::node_handle
+BTree<KT, VT, Balance, Compare>::extract(iterator pos) {
+  node_handle handle;
+  node_type* node = pos.getNode();
+  if (node) {
+    unlink(node);
+    handle.slab_ = pool_.lend(node);
+    handle.node_ = node;
+  }
+  return handle;
+}
+
+// Links the node of the handle if its key is missing and leaves the handle
+// empty. Otherwise the handle keeps the node. The node is adopted where it is
+// in memory, so the element is neither copied nor moved and nothing is
+// allocated
+template <typename KT, typename VT, typename Balance, typename Compare>
+std::pair<typename BTree<KT, VT, Balance, Compare>::iterator, bool>
+BTree<KT, VT, Balance, Compare>::insertUnique(node_handle& handle) {
+  if (handle.empty()) {
+    return {end(), false};
+  }
+  Place place = uniquePlace(handle.node_->key);
+  if (place.equal) {
+    return {iterator(place.equal, this), false};
+  }
+  pool_.adopt(handle.node_, handle.slab_);
+  node_type* node = std::exchange(handle.node_, nullptr);
+  return {attach(place.parent, place.toLeft, node), true};
+}
+
+// Links the node of the handle after all equal keys
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::iterator
+BTree<KT, VT, Balance, Compare>::insertEqual(node_handle& handle) {
+  if (handle.empty()) {
+    return end();
+  }
+  Place place = equalPlace(handle.node_->key);
+  pool_.adopt(handle.node_, handle.slab_);
+  node_type* node = std::exchange(handle.node_, nullptr);
+  return attach(place.parent, place.toLeft, node);
+}
+
+// Moves the nodes of other whose keys are missing here into this tree and
+// returns how many there were, the rest stays in other
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::size_type
+BTree<KT, VT, Balance, Compare>::mergeUnique(BTree& other) {
+  return merge<true>(other);
+}
+
+// Moves all nodes of other into this tree, after the equal keys already here
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::size_type
+BTree<KT, VT, Balance, Compare>::mergeEqual(BTree& other) {
+  return merge<false>(other);
+}
+
+// Relinks nodes from other in key order. Each one costs a removal from other
+// and an insertion here, O(log n) each, but no allocation and no copy of the
+// element
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <bool Unique>
+typename BTree<KT, VT, Balance, Compare>::size_type
+BTree<KT, VT, Balance, Compare>::merge(BTree& other) {
+  if (&other == this) {
+    return 0;
+  }
+  size_type moved = 0;
+  node_type* node = other.begin().getNode();
+  while (node) {
+    node_type* next = successor(node);
+    Place place = Unique ? uniquePlace(node->key) : equalPlace(node->key);
+    if (place.equal == nullptr) {
+      other.pool_.transfer(node, pool_);
+      other.unlink(node);
+      attach(place.parent, place.toLeft, node);
+      ++moved;
     }
-    updateParent(node, nullptr);
-    delete node;
-    return;
+    node = next;
   }
-  // Сase 2
-  if (node->hasOneChild()) {
-    node_type* successor = (node->left != nullptr) ? node->left : node->right;
-    removeNode(successor, key);
+  return moved;
+}
+
+// Unlinks the node from the tree and lets the balancing policy restore its
+// invariants. A node with two children is replaced by its successor, which
+// takes over the node's balancing state. The node is left as a detached leaf
+template <typename KT, typename VT, typename Balance, typename Compare>
+void BTree<KT, VT, Balance, Compare>::unlink(node_type* node) {
+  if constexpr (kThreaded) {
+    if (node->prev) {
+      node->prev->next = node->next;
+    }
+    if (node->next) {
+      node->next->prev = node->prev;
+    }
+    node->prev = nullptr;
+    node->next = nullptr;
   }
-  // Сase 3
-  if (node->hasTwoChild()) {
-    if (node->key > key) {
-      removeNode(node->left, key);
+  if (node == rightmost_) {
+    rightmost_ = node->left ? node->left : node->parent();
+    while (node->left && rightmost_->right) {
+      rightmost_ = rightmost_->right;
+    }
+  }
+  Removal removal{nullptr, node->parent(), false, node->balance()};
+  removal.left = removal.parent && removal.parent->left == node;
+  if (node->left == nullptr) {
+    removal.replacement = node->right;
+    transplant(node, node->right);
+  } else if (node->right == nullptr) {
+    removal.replacement = node->left;
+    transplant(node, node->left);
+  } else {
+    node_type* successor = node->right;
+    while (successor->left) {
+      successor = successor->left;
+    }
+    removal.replacement = successor;
+    removal.balance = successor->balance();
+    if (successor->parent() == node) {
+      removal.parent = successor;
+      removal.left = false;
     } else {
-      removeNode(node->right, key);
+      removal.parent = successor->parent();
+      removal.left = true;
+      transplant(successor, successor->right);
+      successor->right = node->right;
+      successor->right->setParent(successor);
     }
+    transplant(node, successor);
+    successor->left = node->left;
+    successor->left->setParent(successor);
+    successor->setBalance(node->balance());
+  }
+  node->left = nullptr;
+  node->right = nullptr;
+  node->setParent(nullptr);
+  node->setBalance(0);
+  if constexpr (kCounted) {
+    node->size = 1;
   }
+  recountPath(removal.parent);
+  Balance::afterRemove(*this, removal);
 }
 
-template <typename KT, typename VT>
-void BTree<KT, VT>::destroy(node_type* node) {
-  if (!node) {
-    return;
+template <typename KT, typename VT, typename Balance, typename Compare>
+void BTree<KT, VT, Balance, Compare>::erase(iterator pos) {
+  removeNode(pos.getNode());
+}
+
+// Removes the elements in [first, last) and returns how many there were. A
+// range of k elements is unlinked one by one in O(k log n) while k log n stays
+// below n. A larger range is cheaper to drop at once, relinking the remaining
+// nodes into a fresh balanced tree in O(n)
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::size_type
+BTree<KT, VT, Balance, Compare>::erase(iterator first, iterator last) {
+  size_type total = pool_.size();
+  size_type count = 0;
+  for (iterator it = first; it != last; ++it) {
+    ++count;
   }
-  destroy(node->left);
-  destroy(node->right);
+  if (count * medianHeight(total) <= total) {
+    while (first != last) {
+      iterator next = first;
+      ++next;
+      removeNode(first.getNode());
+      first = next;
+    }
+    return count;
+  }
+  std::vector<node_type*> nodes;
+  nodes.reserve(total);
+  for (iterator it = begin(); it != end(); ++it) {
+    nodes.push_back(it.getNode());
+  }
+  size_type kept = 0;
+  bool removing = false;
+  for (node_type* node : nodes) {
+    removing = (removing || node == first.getNode()) && node != last.getNode();
+    if (removing) {
+      pool_.destroy(node);
+      continue;
+    }
+    node->left = nullptr;
+    node->right = nullptr;
+    node->setParent(nullptr);
+    nodes[kept++] = node;
+  }
+  root = Balance::build(*this, nodes.data(), kept);
+  rightmost_ = kept ? nodes[kept - 1] : nullptr;
+  countSubtrees();
+  threadNodes();
+  return count;
+}
 
-  delete node;
+// Frees all nodes. Nodes without destructors are dropped together with their
+// slabs, otherwise, or when some were adopted from other trees, they are
+// destroyed in one post-order walk without recursion
+template <typename KT, typename VT, typename Balance, typename Compare>
+void BTree<KT, VT, Balance, Compare>::clear() noexcept {
+  if (!std::is_trivially_destructible_v<node_type> || pool_.holdsLent()) {
+    node_type* node = root;
+    while (node) {
+      if (node->left) {
+        node = node->left;
+      } else if (node->right) {
+        node = node->right;
+      } else {
+        node_type* parent = node->parent();
+        if (parent) {
+          (parent->left == node ? parent->left : parent->right) = nullptr;
+        }
+        pool_.destroy(node);
+        node = parent;
+      }
+    }
+  }
+  pool_.release();
+  root = nullptr;
+  rightmost_ = nullptr;
+}
+
+template <typename KT, typename VT, typename Balance, typename Compare>
+void BTree<KT, VT, Balance, Compare>::swap(BTree& other) noexcept {
+  using std::swap;
+  swap(root, other.root);
+  swap(rightmost_, other.rightmost_);
+  swap(rotations_, other.rotations_);
+  pool_.swap(other.pool_);
+  this->swapCompare(other);
 }
 
-template <typename KT, typename VT>
-typename BTree<KT, VT>::iterator BTree<KT, VT>::begin() const {
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::iterator
+BTree<KT, VT, Balance, Compare>::begin() const {
   if (root == nullptr) {
-    return iterator(root);
+    return iterator(root, this);
   }
   node_type* current = root;
   while (current->left) {
     current = current->left;
   }
-  return iterator(current);
+  return iterator(current, this);
 }
 
-template <typename KT, typename VT>
-typename BTree<KT, VT>::iterator BTree<KT, VT>::end() const {
-  return iterator(nullptr);
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::iterator
+BTree<KT, VT, Balance, Compare>::end() const {
+  return iterator(nullptr, this);
 }
 
-template <typename KT, typename VT>
-void BTree<KT, VT>::updateParent(node_type* node, node_type* successor) {
-  (node->key == node->parent->left->key) ? node->parent->left = successor
-                                         : node->parent->right = successor;
+// Returns the number of levels on the longest root to leaf path
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::size_type
+BTree<KT, VT, Balance, Compare>::height() const {
+  size_type result = 0;
+  std::stack<std::pair<node_type*, size_type>> pending;
+  if (root) {
+    pending.push({root, 1});
+  }
+  while (!pending.empty()) {
+    auto [node, depth] = pending.top();
+    pending.pop();
+    result = std::max(result, depth);
+    if (node->left) {
+      pending.push({node->left, depth + 1});
+    }
+    if (node->right) {
+      pending.push({node->right, depth + 1});
+    }
+  }
+  return result;
 }
 
-template <typename KT, typename VT>
-typename BTree<KT, VT>::iterator BTree<KT, VT>::insert(node_type* node, KT key,
-                                                       VT value) {
-  if (root == nullptr) {
-    root = new node_type(key, value, *node);
-    return iterator(root);
+// Returns the number of rotations done by the balancing policy so far
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::size_type
+BTree<KT, VT, Balance, Compare>::rotations() const noexcept {
+  return rotations_;
+}
+
+template <typename KT, typename VT, typename Balance, typename Compare>
+void BTree<KT, VT, Balance, Compare>::rotateLeft(node_type* node) {
+  ++rotations_;
+  node_type* pivot = node->right;
+  node->right = pivot->left;
+  if (pivot->left) {
+    pivot->left->setParent(node);
+  }
+  transplant(node, pivot);
+  pivot->left = node;
+  node->setParent(pivot);
+  recount(node);
+  recount(pivot);
+}
+
+template <typename KT, typename VT, typename Balance, typename Compare>
+void BTree<KT, VT, Balance, Compare>::rotateRight(node_type* node) {
+  ++rotations_;
+  node_type* pivot = node->left;
+  node->left = pivot->right;
+  if (pivot->right) {
+    pivot->right->setParent(node);
+  }
+  transplant(node, pivot);
+  pivot->right = node;
+  node->setParent(pivot);
+  recount(node);
+  recount(pivot);
+}
+
+// Creates a node under parent, which has a free slot on the given side, and
+// rebalances. The key and the value are constructed in place from key and args
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K, typename... Args>
+typename BTree<KT, VT, Balance, Compare>::iterator
+BTree<KT, VT, Balance, Compare>::link(node_type* parent, bool toLeft, K&& key,
+                                      Args&&... args) {
+  return attach(parent, toLeft,
+                pool_.create(std::piecewise_construct, parent,
+                             std::forward<K>(key),
+                             std::forward<Args>(args)...));
+}
+
+// Puts a detached leaf owned by the pool under parent, which has a free slot
+// on the given side, and rebalances
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::iterator
+BTree<KT, VT, Balance, Compare>::attach(node_type* parent, bool toLeft,
+                                        node_type* node) {
+  node->setParent(parent);
+  if constexpr (kThreaded) {
+    if (parent) {
+      node->prev = toLeft ? parent->prev : parent;
+      node->next = toLeft ? parent : parent->next;
+      if (node->prev) {
+        node->prev->next = node;
+      }
+      if (node->next) {
+        node->next->prev = node;
+      }
+    }
+  }
+  if (parent == nullptr) {
+    root = node;
+  } else if (toLeft) {
+    parent->left = node;
+  } else {
+    parent->right = node;
+  }
+  if (parent == rightmost_ && !toLeft) {
+    rightmost_ = node;
+  }
+  if constexpr (kCounted) {
+    for (node_type* up = parent; up; up = up->parent()) {
+      ++up->size;
+    }
+  }
+  Balance::afterInsert(*this, node);
+  return iterator(node, this);
+}
+
+// Looks the key up with one comparison per level. A native three-way
+// comparison stops at the first equal node. Otherwise the descent runs to the
+// bottom tracking the first node not less than the key, which among equal keys
+// is the first one in order, and checks it for equality once. key may be of
+// any type Compare orders against KT, such as a string_view for string keys
+// under std::less<>
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K>
+typename BTree<KT, VT, Balance, Compare>::node_type*
+BTree<KT, VT, Balance, Compare>::findNode(const K& key) const {
+  node_type* current = root;
+  if constexpr (three_way::kNative) {
+    while (current) {
+      int order = three_way::compare(this->keyCompare(), key, current->key);
+      if (order == 0) {
+        return current;
+      }
+      current = order < 0 ? current->left : current->right;
+    }
+    return nullptr;
+  } else {
+    node_type* candidate = lowerNode(key);
+    return candidate && !less(key, candidate->key) ? candidate : nullptr;
   }
-  if (std::less<KT>{}(key, node->key)) {  // <
-    if (node->left == nullptr) {
-      node->left = new node_type(key, value, *node);
-      return iterator(node->left);
+}
+
+// First node with a key not less than key, nullptr if there is none
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K>
+typename BTree<KT, VT, Balance, Compare>::node_type*
+BTree<KT, VT, Balance, Compare>::lowerNode(const K& key) const {
+  node_type* result = nullptr;
+  for (node_type* current = root; current;) {
+    if (less(current->key, key)) {
+      current = current->right;
     } else {
-      return insert(node->left, key, value);
+      result = current;
+      current = current->left;
     }
-  } else {  // >=
-    if (node->right == nullptr) {
-      node->right = new node_type(key, value, *node);
-      return iterator(node->right);
+  }
+  return result;
+}
+
+// First node with a key greater than key, nullptr if there is none
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K>
+typename BTree<KT, VT, Balance, Compare>::node_type*
+BTree<KT, VT, Balance, Compare>::upperNode(const K& key) const {
+  node_type* result = nullptr;
+  for (node_type* current = root; current;) {
+    if (less(key, current->key)) {
+      result = current;
+      current = current->left;
     } else {
-      return insert(node->right, key, value);
+      current = current->right;
     }
   }
+  return result;
 }
 
-// ITERATORS
-template <typename KT, typename VT>
-class BTree<KT, VT>::iterator {
- public:
-  explicit iterator(Node<KT, VT>* node) : current(nullptr) {
-    if (node) {
-      current = node;
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename L, typename R>
+bool BTree<KT, VT, Balance, Compare>::less(const L& left,
+                                           const R& right) const {
+  return this->keyCompare()(left, right);
+}
+
+// In-order neighbours, nullptr past either end. A threaded tree links them
+// directly
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::node_type*
+BTree<KT, VT, Balance, Compare>::predecessor(node_type* node) {
+  if constexpr (kThreaded) {
+    return node->prev;
+  } else {
+    return treePredecessor(node);
+  }
+}
+
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::node_type*
+BTree<KT, VT, Balance, Compare>::successor(node_type* node) {
+  if constexpr (kThreaded) {
+    return node->next;
+  } else {
+    return treeSuccessor(node);
+  }
+}
+
+// In-order neighbours found through the tree structure alone, amortized O(1)
+// over a full walk but O(log n) for a single step
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::node_type*
+BTree<KT, VT, Balance, Compare>::treePredecessor(node_type* node) {
+  if (node->left) {
+    node = node->left;
+    while (node->right) {
+      node = node->right;
     }
+    return node;
   }
+  node_type* parent = node->parent();
+  while (parent && parent->left == node) {
+    node = parent;
+    parent = node->parent();
+  }
+  return parent;
+}
 
-  iterator& operator++() {
-    if (!current) {
-      return *this;
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::node_type*
+BTree<KT, VT, Balance, Compare>::treeSuccessor(node_type* node) {
+  if (node->right) {
+    node = node->right;
+    while (node->left) {
+      node = node->left;
     }
-    if (current->right) {
-      current = current->right;
-      while (current->left) {
-        current = current->left;
+    return node;
+  }
+  node_type* parent = node->parent();
+  while (parent && parent->right == node) {
+    node = parent;
+    parent = node->parent();
+  }
+  return parent;
+}
+
+// Puts child in place of node in the node's parent
+template <typename KT, typename VT, typename Balance, typename Compare>
+void BTree<KT, VT, Balance, Compare>::transplant(node_type* node,
+                                                 node_type* child) {
+  node_type* parent = node->parent();
+  if (parent == nullptr) {
+    root = child;
+  } else if (parent->left == node) {
+    parent->left = child;
+  } else {
+    parent->right = child;
+  }
+  if (child) {
+    child->setParent(parent);
+  }
+}
+
+// Creates a node for every entry of the sorted range and lets the balancing
+// policy link them, which takes O(n) instead of n inserts
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename It, typename Split>
+void BTree<KT, VT, Balance, Compare>::build(It first, It last, Split split) {
+  clear();
+  std::vector<node_type*> nodes;
+  try {
+    for (; first != last; ++first) {
+      nodes.push_back(nullptr);
+      auto [key, value] = split(first);
+      nodes.back() = pool_.create(key, value, nullptr);
+    }
+  } catch (...) {
+    for (node_type* node : nodes) {
+      if (node) {
+        pool_.destroy(node);
+      }
+    }
+    pool_.release();
+    throw;
+  }
+  root = Balance::build(*this, nodes.data(), nodes.size());
+  rightmost_ = nodes.empty() ? nullptr : nodes.back();
+  countSubtrees();
+  threadNodes();
+}
+
+// Copies the tree under source node by node in one pre-order walk without
+// recursion or key comparisons. The copy is linked in as it grows, so clear()
+// can free it if a copy throws
+template <typename KT, typename VT, typename Balance, typename Compare>
+void BTree<KT, VT, Balance, Compare>::clone(const node_type* source) {
+  if (source == nullptr) {
+    return;
+  }
+  root = pool_.create(source->key, source->value, nullptr);
+  root->setBalance(source->balance());
+  if constexpr (kCounted) {
+    root->size = source->size;
+  }
+  rightmost_ = root;
+  node_type* target = root;
+  while (source) {
+    const node_type* next = nullptr;
+    if (source->left && target->left == nullptr) {
+      next = source->left;
+      target->left = pool_.create(next->key, next->value, target);
+      target = target->left;
+    } else if (source->right && target->right == nullptr) {
+      next = source->right;
+      target->right = pool_.create(next->key, next->value, target);
+      target = target->right;
+    } else {
+      source = source->parent();
+      target = target->parent();
+      continue;
+    }
+    target->setBalance(next->balance());
+    if constexpr (kCounted) {
+      target->size = next->size;
+    }
+    if (next == source->right && rightmost_ == target->parent()) {
+      rightmost_ = target;
+    }
+    source = next;
+  }
+}
+
+// Links nodes given in key order into a tree of minimal height, every subtree
+// root is the median of its range. mark(node, depth, leftCount, rightCount)
+// lets the policy set the balancing state of each node
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename Mark>
+typename BTree<KT, VT, Balance, Compare>::node_type*
+BTree<KT, VT, Balance, Compare>::linkMedians(node_type** nodes,
+                                             size_type count,
+                                             node_type* parent,
+                                             size_type depth,
+                                             const Mark& mark) {
+  if (count == 0) {
+    return nullptr;
+  }
+  size_type middle = count / 2;
+  node_type* node = nodes[middle];
+  node->setParent(parent);
+  node->left = linkMedians(nodes, middle, node, depth + 1, mark);
+  node->right = linkMedians(nodes + middle + 1, count - middle - 1, node,
+                            depth + 1, mark);
+  mark(node, depth, middle, count - middle - 1);
+  return node;
+}
+
+// Height of a subtree of count nodes built by linkMedians
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::size_type
+BTree<KT, VT, Balance, Compare>::medianHeight(size_type count) {
+  size_type result = 0;
+  for (; count; count >>= 1) {
+    ++result;
+  }
+  return result;
+}
+
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::size_type
+BTree<KT, VT, Balance, Compare>::subtreeSize(const node_type* node) {
+  return node ? node->size : 0;
+}
+
+// Recomputes the subtree size of a node whose children changed
+template <typename KT, typename VT, typename Balance, typename Compare>
+void BTree<KT, VT, Balance, Compare>::recount(node_type* node) {
+  if constexpr (kCounted) {
+    node->size = 1 + subtreeSize(node->left) + subtreeSize(node->right);
+  }
+}
+
+// Recomputes subtree sizes from node up to the root after a removal
+template <typename KT, typename VT, typename Balance, typename Compare>
+void BTree<KT, VT, Balance, Compare>::recountPath(node_type* node) {
+  if constexpr (kCounted) {
+    for (; node; node = node->parent()) {
+      recount(node);
+    }
+  }
+}
+
+// Computes all subtree sizes bottom up after a bulk load, in O(n)
+template <typename KT, typename VT, typename Balance, typename Compare>
+void BTree<KT, VT, Balance, Compare>::countSubtrees() {
+  if constexpr (kCounted) {
+    node_type* node = root;
+    node_type* from = nullptr;
+    while (node) {
+      if (from == node->parent() && node->left) {
+        from = node;
+        node = node->left;
+      } else if (from != node->right && node->right) {
+        from = node;
+        node = node->right;
+      } else {
+        recount(node);
+        from = node;
+        node = node->parent();
+      }
+    }
+  }
+}
+
+// Links every node to its in-order neighbours in one walk, for trees that were
+// built or copied without the links
+template <typename KT, typename VT, typename Balance, typename Compare>
+void BTree<KT, VT, Balance, Compare>::threadNodes() {
+  if constexpr (kThreaded) {
+    node_type* previous = nullptr;
+    for (node_type* node = begin().getNode(); node;
+         node = treeSuccessor(node)) {
+      node->prev = previous;
+      if (previous) {
+        previous->next = node;
       }
-      return *this;
+      previous = node;
+    }
+    if (previous) {
+      previous->next = nullptr;
     }
-    Node<KT, VT>* prev = current;
-    current = current->parent;
-    while (current && current->right == prev) {
-      prev = current;
-      current = current->parent;
+  }
+}
+
+// Element with index elements before it in key order, end() when there are
+// fewer elements. O(log n) with an OrderStatistic policy, an in-order walk
+// otherwise
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename BTree<KT, VT, Balance, Compare>::iterator
+BTree<KT, VT, Balance, Compare>::nth(size_type index) const {
+  if constexpr (!kCounted) {
+    iterator it = begin();
+    for (; index && it != end(); --index) {
+      ++it;
+    }
+    return it;
+  } else {
+    node_type* node = root;
+    while (node) {
+      size_type left = subtreeSize(node->left);
+      if (index < left) {
+        node = node->left;
+      } else if (index == left) {
+        break;
+      } else {
+        index -= left + 1;
+        node = node->right;
+      }
+    }
+    return iterator(node, this);
+  }
+}
+
+// Number of elements with a key less than key. O(log n) with an
+// OrderStatistic policy, an in-order walk otherwise
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K>
+typename BTree<KT, VT, Balance, Compare>::size_type
+BTree<KT, VT, Balance, Compare>::rank(const K& key) const {
+  size_type result = 0;
+  if constexpr (!kCounted) {
+    for (iterator it = begin(); it != end() && less(it.first(), key); ++it) {
+      ++result;
+    }
+  } else {
+    for (node_type* node = root; node;) {
+      if (less(node->key, key)) {
+        result += subtreeSize(node->left) + 1;
+        node = node->right;
+      } else {
+        node = node->left;
+      }
+    }
+  }
+  return result;
+}
+
+// Number of elements equivalent to key. O(log n) with an OrderStatistic
+// policy as the difference of two ranks, O(log n + k) otherwise
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K>
+typename BTree<KT, VT, Balance, Compare>::size_type
+BTree<KT, VT, Balance, Compare>::count(const K& key) const {
+  size_type result = 0;
+  if constexpr (kCounted) {
+    for (node_type* node = root; node;) {
+      if (less(key, node->key)) {
+        node = node->left;
+      } else {
+        result += subtreeSize(node->left) + 1;
+        node = node->right;
+      }
+    }
+    result -= rank(key);
+  } else {
+    iterator last = upperBound(key);
+    for (iterator it = lowerBound(key); it != last; ++it) {
+      ++result;
+    }
+  }
+  return result;
+}
+
+// Picks the tree implementation behind Map and Set for their policy parameter,
+// balancing policies select BTree
+template <typename KT, typename VT, typename Policy, typename Compare>
+struct TreeEngine {
+  using type = BTree<KT, VT, Policy, Compare>;
+};
+
+// ITERATORS
+// Bidirectional. Decrementing end() gives the last element, which is why
+// iterators also point to their tree
+template <typename KT, typename VT, typename Balance, typename Compare>
+class BTree<KT, VT, Balance, Compare>::iterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = std::remove_const_t<mapped_type>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = mapped_type*;
+  using reference = mapped_type&;
+
+  iterator() : current(nullptr), tree_(nullptr) {}
+  iterator(node_type* node, const BTree* tree) : current(node), tree_(tree) {}
+
+  iterator& operator++() {
+    if (current) {
+      current = successor(current);
     }
     return *this;
   }
 
-  VT& operator*() const { return current->value; }
+  iterator operator++(int) {
+    iterator old = *this;
+    ++*this;
+    return old;
+  }
+
+  iterator& operator--() {
+    current = current ? predecessor(current) : tree_->rightmost_;
+    return *this;
+  }
+
+  iterator operator--(int) {
+    iterator old = *this;
+    --*this;
+    return old;
+  }
+
+  mapped_type& operator*() const { return current->mapped(); }
 
   bool operator==(const iterator& other) const {
     return current == other.current;
@@ -205,57 +1247,72 @@ class BTree<KT, VT>::iterator {
 
   bool operator!=(const iterator& other) const { return !(*this == other); }
 
-  node_type* getNode() { return current; }
-  KT& first() { return current->key; }
-  VT& second() { return current->value; }
+  node_type* getNode() const { return current; }
+  KT& first() const { return current->key; }
+  mapped_type& second() const { return current->mapped(); }
 
  private:
+  friend class const_iterator;
+
   node_type* current;
+  const BTree* tree_;
 };
 
-template <typename KT, typename VT>
-class BTree<KT, VT>::const_iterator {
+template <typename KT, typename VT, typename Balance, typename Compare>
+class BTree<KT, VT, Balance, Compare>::const_iterator {
  public:
-  explicit const_iterator(Node<KT, VT>* node) : current(nullptr) {
-    if (node) {
-      current = node;
-    }
-  }
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = std::remove_const_t<mapped_type>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const mapped_type*;
+  using reference = const mapped_type&;
+
+  const_iterator() : current(nullptr), tree_(nullptr) {}
+  const_iterator(node_type* node, const BTree* tree)
+      : current(node), tree_(tree) {}
+  const_iterator(const iterator& it) : current(it.current), tree_(it.tree_) {}
 
   const_iterator& operator++() {
-    if (!current) {
-      return *this;
-    }
-    if (current->right) {
-      current = current->right;
-      while (current->left) {
-        current = current->left;
-      }
-      return *this;
-    }
-    Node<KT, VT>* prev = current;
-    current = current->parent;
-    while (current && current->right == prev) {
-      prev = current;
-      current = current->parent;
+    if (current) {
+      current = successor(current);
     }
     return *this;
   }
 
-  VT& operator*() const { return current->value; }
+  const_iterator operator++(int) {
+    const_iterator old = *this;
+    ++*this;
+    return old;
+  }
 
-  bool operator==(const iterator& other) const {
+  const_iterator& operator--() {
+    current = current ? predecessor(current) : tree_->rightmost_;
+    return *this;
+  }
+
+  const_iterator operator--(int) {
+    const_iterator old = *this;
+    --*this;
+    return old;
+  }
+
+  const mapped_type& operator*() const { return current->mapped(); }
+
+  bool operator==(const const_iterator& other) const {
     return current == other.current;
   }
 
-  bool operator!=(const iterator& other) const { return !(*this == other); }
+  bool operator!=(const const_iterator& other) const {
+    return !(*this == other);
+  }
 
-  node_type* getNode() { return current; }
-  KT& first() { return current->key; }
-  VT& second() { return current->value; }
+  const node_type* getNode() const { return current; }
+  const KT& first() const { return current->key; }
+  const mapped_type& second() const { return current->mapped(); }
 
  private:
   node_type* current;
+  const BTree* tree_;
 };
 
 }  // namespace s21
@@ -0,0 +1,28 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_MAP_NO_BALANCE_H_
+#define CPP2_S21_CONTAINERS_SRC_MAP_NO_BALANCE_H_
+
+namespace s21 {
+
+// Plain binary search tree without rebalancing. Cheapest per operation on
+// random keys, degrades to a list on sorted input
+struct NoBalance {
+  static constexpr bool kCloneable = true;
+
+  template <typename Tree>
+  static void afterInsert(Tree&, typename Tree::node_type*) {}
+
+  template <typename Tree>
+  static void afterRemove(Tree&, const typename Tree::Removal&) {}
+
+  template <typename Tree>
+  static typename Tree::node_type* build(Tree& tree,
+                                         typename Tree::node_type** nodes,
+                                         typename Tree::size_type count) {
+    return tree.linkMedians(nodes, count, nullptr, 0,
+                            [](auto*, auto, auto, auto) {});
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_MAP_NO_BALANCE_H_
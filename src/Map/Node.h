@@ -1,35 +1,124 @@
 #ifndef CPP2_S21_CONTAINERS_SRC_MAP_NODE_H_
 #define CPP2_S21_CONTAINERS_SRC_MAP_NODE_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include <utility>
 
 namespace s21 {
 
-template <typename KT, typename VT = KT>
-class Node {
- public:
+// Size of the node's subtree, stored only in trees with an order statistic
+// policy. Other trees get the empty base and no extra word per node
+template <bool Counted>
+struct SubtreeSize {};
+
+template <>
+struct SubtreeSize<true> {
+  std::size_t size = 1;
+};
+
+// In-order neighbours of the node, stored only in trees with a threaded
+// policy, where stepping an iterator follows one of them
+template <typename NodeT, bool Threaded>
+struct InOrderLinks {};
+
+template <typename NodeT>
+struct InOrderLinks<NodeT, true> {
+  NodeT* next = nullptr;
+  NodeT* prev = nullptr;
+};
+
+// Value type of trees that keep keys only, as behind Set and Multiset
+struct KeyOnly {};
+inline constexpr KeyOnly key_only{};
+
+// Key and value of a node
+template <typename KT, typename VT>
+struct NodeEntry {
   KT key;
   VT value;
-  Node<KT, VT>* left;
-  Node<KT, VT>* right;
-  Node<KT, VT>* parent;
 
-  explicit Node(KT& key)
-      : key{key}, value{}, left{nullptr}, right{nullptr}, parent{nullptr} {}
+  NodeEntry(const KT& key, const VT& value) : key{key}, value{value} {}
+
+  // Forwards the key and the value's constructor arguments, so the payload is
+  // built right in the node and an rvalue key is moved rather than copied
+  template <typename K, typename... Args>
+  NodeEntry(std::piecewise_construct_t, K&& key, Args&&... args)
+      : key(std::forward<K>(key)), value(std::forward<Args>(args)...) {}
+
+  VT& mapped() { return value; }
+};
+
+// Key-only nodes store the key once and hand it out as their value, which
+// saves sizeof(KT) per node against a value that repeats the key
+template <typename KT>
+struct NodeEntry<KT, KeyOnly> {
+  KT key;
+  static constexpr KeyOnly value{};
+
+  NodeEntry(const KT& key, KeyOnly) : key{key} {}
+
+  template <typename K>
+  NodeEntry(std::piecewise_construct_t, K&& key, KeyOnly = {})
+      : key(std::forward<K>(key)) {}
+
+  const KT& mapped() const { return key; }
+};
+
+template <typename KT, typename VT = KT, bool Counted = false,
+          bool Threaded = false>
+class Node : public SubtreeSize<Counted>,
+             public InOrderLinks<Node<KT, VT, Counted, Threaded>, Threaded>,
+             public NodeEntry<KT, VT> {
+ public:
+  using NodeEntry<KT, VT>::key;
+  using NodeEntry<KT, VT>::value;
+
+  Node* left;
+  Node* right;
+
+  explicit Node(const KT& key)
+      : NodeEntry<KT, VT>(key, VT{}),
+        left{nullptr},
+        right{nullptr},
+        parent_{0} {}
 
-  Node(KT& key, VT& value, Node<KT, VT>& parent)
-      : key{key},
-        value{value},
+  Node(const KT& key, const VT& value, Node* parent)
+      : NodeEntry<KT, VT>(key, value),
         left{nullptr},
         right{nullptr},
-        parent(&parent) {}
+        parent_{reinterpret_cast<std::uintptr_t>(parent)} {}
+
+  template <typename K, typename... Args>
+  Node(std::piecewise_construct_t, Node* parent, K&& key, Args&&... args)
+      : NodeEntry<KT, VT>(std::piecewise_construct, std::forward<K>(key),
+                          std::forward<Args>(args)...),
+        left{nullptr},
+        right{nullptr},
+        parent_{reinterpret_cast<std::uintptr_t>(parent)} {}
 
   Node()
-      : key(KT{}),
-        value(VT{}),
+      : NodeEntry<KT, VT>(KT{}, VT{}),
         left{nullptr},
         right{nullptr},
-        parent{nullptr} {}
+        parent_{0} {}
+
+  Node* parent() const {
+    return reinterpret_cast<Node*>(parent_ & ~kBalanceMask);
+  }
+
+  void setParent(Node* parent) {
+    parent_ =
+        reinterpret_cast<std::uintptr_t>(parent) | (parent_ & kBalanceMask);
+  }
+
+  // Two bits of balancing state owned by the tree's balancing policy
+  unsigned balance() const { return parent_ & kBalanceMask; }
+
+  void setBalance(unsigned balance) {
+    parent_ = (parent_ & ~kBalanceMask) | (balance & kBalanceMask);
+  }
 
   bool hasNoChild() {
     if (left != nullptr || right != nullptr) {
@@ -56,11 +145,22 @@ class Node {
   }
 
   // Swaps the contents
-  void swap(Node<KT, VT>& other) {
+  void swap(Node& other) {
     using std::swap;
     swap(key, other.key);
-    swap(value, other.value);
+    if constexpr (!std::is_same_v<VT, KeyOnly>) {
+      swap(value, other.value);
+    }
   }
+
+ private:
+  // Nodes are at least pointer aligned, so the two lowest bits of the parent
+  // address are always zero and store the balancing state instead (red-black
+  // color, AVL balance factor). This keeps the node as small as a plain binary
+  // tree node.
+  static constexpr std::uintptr_t kBalanceMask = 3;
+
+  std::uintptr_t parent_;
 };
 }  // namespace s21
 
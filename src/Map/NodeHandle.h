@@ -0,0 +1,81 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_MAP_NODE_HANDLE_H_
+#define CPP2_S21_CONTAINERS_SRC_MAP_NODE_HANDLE_H_
+
+#include <utility>
+
+#include "Node.h"
+#include "NodePool.h"
+
+namespace s21 {
+
+// Owner of a node extracted from a tree container by extract(). The node keeps
+// its memory, so inserting the handle into another container of the same kind
+// relinks it without copying the element or allocating. The key may be
+// changed before that. A handle that is dropped destroys its node
+template <typename KT, typename VT, bool Counted, bool Threaded>
+class NodeHandle {
+ public:
+  using node_type = Node<KT, VT, Counted, Threaded>;
+
+  NodeHandle() noexcept : node_(nullptr), slab_(nullptr) {}
+  NodeHandle(const NodeHandle&) = delete;
+  NodeHandle(NodeHandle&& other) noexcept : NodeHandle() { swap(other); }
+  ~NodeHandle() { reset(); }
+  NodeHandle& operator=(const NodeHandle&) = delete;
+
+  NodeHandle& operator=(NodeHandle&& other) noexcept {
+    if (this != &other) {
+      reset();
+      swap(other);
+    }
+    return *this;
+  }
+
+  bool empty() const noexcept { return node_ == nullptr; }
+  explicit operator bool() const noexcept { return node_ != nullptr; }
+
+  KT& key() const { return node_->key; }
+  decltype(auto) mapped() const { return node_->mapped(); }
+  // The element of a Set or Multiset handle
+  KT& value() const { return node_->key; }
+
+  void swap(NodeHandle& other) noexcept {
+    std::swap(node_, other.node_);
+    std::swap(slab_, other.slab_);
+  }
+
+ private:
+  template <typename, typename, typename, typename>
+  friend class BTree;
+
+  // The slab the node lives in, kept alive by the node's reference to it
+  node_type* node_;
+  typename NodePool<node_type>::Slab* slab_;
+
+  void reset() noexcept {
+    if (node_) {
+      NodePool<node_type>::destroyLent(node_, slab_);
+      node_ = nullptr;
+      slab_ = nullptr;
+    }
+  }
+};
+
+// What inserting a node handle into a Map or Set returns. When the key was
+// already present, node still holds the handle's node
+template <typename Iterator, typename Handle>
+struct InsertReturn {
+  Iterator position;
+  bool inserted;
+  Handle node;
+};
+
+// Node handle type of containers that have no nodes to hand out, such as the
+// B+-tree engine, which keeps entries in leaf arrays
+struct NoNodeHandle {
+  explicit NoNodeHandle() = default;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_MAP_NODE_HANDLE_H_
@@ -0,0 +1,400 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_MAP_NODE_POOL_H_
+#define CPP2_S21_CONTAINERS_SRC_MAP_NODE_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Slab allocator for tree nodes. Nodes are carved out of slabs that grow
+// geometrically, freed nodes go to an intrusive free list and are reused by
+// the next allocation, so the global allocator is only touched once per slab.
+// All slabs are returned at once by release(). Live objects can be lent out
+// and adopted by another pool, so nodes move between trees without being
+// copied. Every slab counts the objects lent out of it and outlives its pool
+// only until the last of them is destroyed. An object destroyed away from
+// home goes back to the free slots of the pool that made it, so lending never
+// grows either pool. Lending and adopting allocate nothing and take no lock
+template <typename T>
+class NodePool {
+ public:
+  using size_type = std::size_t;
+
+  // Memory an object lives in, handed out with a lent object
+  struct Slab;
+
+  NodePool() noexcept;
+  NodePool(const NodePool&) = delete;
+  NodePool(NodePool&&) noexcept;
+  ~NodePool();
+  NodePool& operator=(const NodePool&) = delete;
+  NodePool& operator=(NodePool&&) noexcept;
+
+  template <typename... Args>
+  T* create(Args&&... args);
+  void destroy(T* item) noexcept;
+  void reserve(size_type count);
+  void release() noexcept;
+  void swap(NodePool& other) noexcept;
+  size_type size() const noexcept;
+  bool holdsLent() const noexcept;
+  Slab* lend(T* item) noexcept;
+  void adopt(T* item, Slab* slab) noexcept;
+  void transfer(T* item, NodePool& to) noexcept;
+  static void destroyLent(T* item, Slab* slab) noexcept;
+
+ private:
+  struct Home;
+
+  // Free slots store the next free slot in place of the object
+  union Slot {
+    Slot* next;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+ public:
+  // Header in front of the slots. refs counts the pool that allocated the
+  // slab, while it holds it, and every object of the slab lent out of it
+  struct alignas(Slot) Slab {
+    std::atomic<size_type> refs;
+    Home* home;
+    Slab* next;
+    size_type count;
+
+    Slot* slots() { return reinterpret_cast<Slot*>(this + 1); }
+    bool holds(const void* item) {
+      std::less<const void*> less;
+      return !less(item, slots()) && less(item, slots() + count);
+    }
+  };
+
+ private:
+  static constexpr size_type kFirstSlab = 16;
+  static constexpr size_type kMaxSlab = 4096;
+
+  // Shared by a pool and its slabs. Other pools push the slots of objects
+  // they destroyed onto returned, the pool takes them all back at once when
+  // its free list runs dry. refs counts the pool and its slabs. The rest is
+  // only touched by the pool: its slabs as a list and sorted by address, and
+  // the size of its next slab
+  struct Home {
+    std::atomic<size_type> refs{1};
+    std::atomic<Slot*> returned{nullptr};
+    Slab* slabs = nullptr;
+    std::vector<Slab*> index;
+    size_type next = kFirstSlab;
+  };
+
+  // Every live slab of every pool, sorted by address, so a pool finds the
+  // slab of an object it adopted from the object alone. Only touched when a
+  // slab comes or goes and when an adopted object is lent on or destroyed
+  struct Directory {
+    std::shared_mutex mutex;
+    std::vector<Slab*> slabs;
+  };
+
+  Slot* free_;
+  Home* home_;
+  Slot* bump_;
+  Slot* end_;
+  size_type size_;
+  size_type adopted_;
+
+  static Directory& directory();
+  static Slab* find(const std::vector<Slab*>& slabs, const void* item);
+  static Slab* findListed(const void* item);
+  static void unref(Slab* slab, size_type count) noexcept;
+  Slot* allocateSlot();
+  void grow(size_type slots);
+  Slab* ownSlab(T* item) const noexcept;
+  Slab* slabOf(T* item) const noexcept;
+};
+
+template <typename T>
+NodePool<T>::NodePool() noexcept
+    : free_(nullptr),
+      home_(nullptr),
+      bump_(nullptr),
+      end_(nullptr),
+      size_(0),
+      adopted_(0) {}
+
+template <typename T>
+NodePool<T>::NodePool(NodePool&& other) noexcept : NodePool() {
+  swap(other);
+}
+
+template <typename T>
+NodePool<T>::~NodePool() {
+  release();
+}
+
+template <typename T>
+NodePool<T>& NodePool<T>::operator=(NodePool&& other) noexcept {
+  if (this == &other) return *this;
+  release();
+  swap(other);
+  return *this;
+}
+
+// Constructs an object in a recycled or fresh slot
+template <typename T>
+template <typename... Args>
+T* NodePool<T>::create(Args&&... args) {
+  Slot* slot = allocateSlot();
+  try {
+    T* item = ::new (static_cast<void*>(slot->storage))
+        T(std::forward<Args>(args)...);
+    ++size_;
+    return item;
+  } catch (...) {
+    slot->next = free_;
+    free_ = slot;
+    throw;
+  }
+}
+
+// Destroys the object and puts its slot on the free list. The slot of an
+// adopted object goes back to the pool that made it instead
+template <typename T>
+void NodePool<T>::destroy(T* item) noexcept {
+  --size_;
+  if (adopted_ != 0 && ownSlab(item) == nullptr) {
+    --adopted_;
+    destroyLent(item, findListed(item));
+    return;
+  }
+  item->~T();
+  Slot* slot = reinterpret_cast<Slot*>(item);
+  slot->next = free_;
+  free_ = slot;
+}
+
+// Makes room for count more objects in one contiguous slab, so that objects
+// created one after another are also adjacent in memory
+template <typename T>
+void NodePool<T>::reserve(size_type count) {
+  if (count > static_cast<size_type>(end_ - bump_)) {
+    grow(count);
+  }
+}
+
+// Returns the slabs to the system without running destructors. Objects that
+// need destruction, and every adopted object, must be destroyed by the owner
+// beforehand. A slab with objects lent out stays until the last of them is
+// destroyed
+template <typename T>
+void NodePool<T>::release() noexcept {
+  if (home_) {
+    home_->index = std::vector<Slab*>();
+    while (home_->slabs) {
+      unref(std::exchange(home_->slabs, home_->slabs->next), 1);
+    }
+    if (home_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete home_;
+    }
+    home_ = nullptr;
+  }
+  free_ = nullptr;
+  bump_ = nullptr;
+  end_ = nullptr;
+  size_ = 0;
+  adopted_ = 0;
+}
+
+template <typename T>
+void NodePool<T>::swap(NodePool& other) noexcept {
+  using std::swap;
+  swap(free_, other.free_);
+  swap(home_, other.home_);
+  swap(bump_, other.bump_);
+  swap(end_, other.end_);
+  swap(size_, other.size_);
+  swap(adopted_, other.adopted_);
+}
+
+// Returns the number of live objects
+template <typename T>
+typename NodePool<T>::size_type NodePool<T>::size() const noexcept {
+  return size_;
+}
+
+// Checks whether some live objects were adopted from other pools
+template <typename T>
+bool NodePool<T>::holdsLent() const noexcept {
+  return adopted_ != 0;
+}
+
+// Gives up a live object without destroying it. The returned slab stays
+// alive for it until it is adopted back home or destroyed by destroyLent
+template <typename T>
+typename NodePool<T>::Slab* NodePool<T>::lend(T* item) noexcept {
+  Slab* slab = slabOf(item);
+  if (slab->home == home_) {
+    slab->refs.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    --adopted_;
+  }
+  --size_;
+  return slab;
+}
+
+// Takes over a lent object of slab, which this pool destroys from then on
+template <typename T>
+void NodePool<T>::adopt(T* item, Slab* slab) noexcept {
+  (void)item;
+  if (slab->home == home_) {
+    unref(slab, 1);
+  } else {
+    ++adopted_;
+  }
+  ++size_;
+}
+
+// Hands one live object over to the pool to. Only the object's own slab is
+// kept alive for it
+template <typename T>
+void NodePool<T>::transfer(T* item, NodePool& to) noexcept {
+  if (&to != this) {
+    to.adopt(item, lend(item));
+  }
+}
+
+// Destroys a lent object and pushes its slot back to the pool that made it
+template <typename T>
+void NodePool<T>::destroyLent(T* item, Slab* slab) noexcept {
+  item->~T();
+  Slot* slot = reinterpret_cast<Slot*>(item);
+  std::atomic<Slot*>& returned = slab->home->returned;
+  Slot* head = returned.load(std::memory_order_relaxed);
+  do {
+    slot->next = head;
+  } while (!returned.compare_exchange_weak(
+      head, slot, std::memory_order_release, std::memory_order_relaxed));
+  unref(slab, 1);
+}
+
+// Never destroyed, so pools in static objects can still use it at exit
+template <typename T>
+typename NodePool<T>::Directory& NodePool<T>::directory() {
+  static Directory* directory = new Directory;
+  return *directory;
+}
+
+// The slab of slabs, sorted by address, that holds item, or nullptr
+template <typename T>
+typename NodePool<T>::Slab* NodePool<T>::find(const std::vector<Slab*>& slabs,
+                                              const void* item) {
+  auto it = std::upper_bound(slabs.begin(), slabs.end(), item,
+                             [](const void* item, Slab* slab) {
+                               return std::less<const void*>()(item, slab);
+                             });
+  if (it == slabs.begin() || !(*std::prev(it))->holds(item)) {
+    return nullptr;
+  }
+  return *std::prev(it);
+}
+
+// The slab of any pool holding item
+template <typename T>
+typename NodePool<T>::Slab* NodePool<T>::findListed(const void* item) {
+  Directory& all = directory();
+  std::shared_lock<std::shared_mutex> lock(all.mutex);
+  return find(all.slabs, item);
+}
+
+// Drops count references to the slab, the last one frees it
+template <typename T>
+void NodePool<T>::unref(Slab* slab, size_type count) noexcept {
+  if (slab->refs.fetch_sub(count, std::memory_order_acq_rel) != count) {
+    return;
+  }
+  {
+    Directory& all = directory();
+    std::unique_lock<std::shared_mutex> lock(all.mutex);
+    all.slabs.erase(std::lower_bound(all.slabs.begin(), all.slabs.end(), slab,
+                                     std::less<const void*>()));
+  }
+  Home* home = slab->home;
+  slab->~Slab();
+  ::operator delete(static_cast<void*>(slab), std::align_val_t{alignof(Slab)});
+  if (home->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete home;
+  }
+}
+
+template <typename T>
+typename NodePool<T>::Slot* NodePool<T>::allocateSlot() {
+  if (free_ == nullptr && home_ &&
+      home_->returned.load(std::memory_order_relaxed)) {
+    free_ = home_->returned.exchange(nullptr, std::memory_order_acquire);
+  }
+  if (free_) {
+    Slot* slot = free_;
+    free_ = slot->next;
+    return slot;
+  }
+  if (bump_ == end_) {
+    grow(home_ ? home_->next : kFirstSlab);
+    home_->next = std::min(home_->next * 2, kMaxSlab);
+  }
+  return bump_++;
+}
+
+template <typename T>
+void NodePool<T>::grow(size_type slots) {
+  if (home_ == nullptr) {
+    home_ = new Home;
+  }
+  void* memory = ::operator new(sizeof(Slab) + slots * sizeof(Slot),
+                                std::align_val_t{alignof(Slab)});
+  Slab* slab = static_cast<Slab*>(memory);
+  std::less<const void*> less;
+  std::vector<Slab*>& index = home_->index;
+  auto mine = std::upper_bound(index.begin(), index.end(), slab, less);
+  bool indexed = false;
+  try {
+    mine = index.insert(mine, slab);
+    indexed = true;
+    Directory& all = directory();
+    std::unique_lock<std::shared_mutex> lock(all.mutex);
+    all.slabs.insert(
+        std::upper_bound(all.slabs.begin(), all.slabs.end(), slab, less),
+        slab);
+  } catch (...) {
+    if (indexed) {
+      index.erase(mine);
+    }
+    ::operator delete(memory, std::align_val_t{alignof(Slab)});
+    throw;
+  }
+  home_->refs.fetch_add(1, std::memory_order_relaxed);
+  home_->slabs = ::new (memory) Slab{{1}, home_, home_->slabs, slots};
+  bump_ = home_->slabs->slots();
+  end_ = bump_ + slots;
+}
+
+// The slab of this pool holding item, or nullptr for an adopted object
+template <typename T>
+typename NodePool<T>::Slab* NodePool<T>::ownSlab(T* item) const noexcept {
+  return home_ ? find(home_->index, item) : nullptr;
+}
+
+// The slab holding a live object of this pool, its own or an adopted one
+template <typename T>
+typename NodePool<T>::Slab* NodePool<T>::slabOf(T* item) const noexcept {
+  Slab* slab = ownSlab(item);
+  return slab ? slab : findListed(item);
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_MAP_NODE_POOL_H_
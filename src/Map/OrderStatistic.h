@@ -0,0 +1,48 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_MAP_ORDER_STATISTIC_H_
+#define CPP2_S21_CONTAINERS_SRC_MAP_ORDER_STATISTIC_H_
+
+namespace s21 {
+
+// Order statistic augmentation on top of another balancing policy, as in
+// Map<int, int, OrderStatistic<AvlBalance>>. Every node also stores the size
+// of its subtree, which BTree keeps up to date on insert, erase and rotations.
+// That costs one word per node and O(log n) extra writes per update, and
+// makes nth and rank O(log n) instead of an O(n) walk
+template <typename Balance>
+struct OrderStatistic {
+  static constexpr bool kCloneable = Balance::kCloneable;
+
+  template <typename Tree>
+  static void afterInsert(Tree& tree, typename Tree::node_type* node) {
+    Balance::afterInsert(tree, node);
+  }
+
+  template <typename Tree>
+  static void afterRemove(Tree& tree, const typename Tree::Removal& removal) {
+    Balance::afterRemove(tree, removal);
+  }
+
+  template <typename Tree>
+  static typename Tree::node_type* build(Tree& tree,
+                                         typename Tree::node_type** nodes,
+                                         typename Tree::size_type count) {
+    return Balance::build(tree, nodes, count);
+  }
+};
+
+// Whether the policy keeps subtree sizes, and the policy doing the balancing
+template <typename Balance>
+struct CountedPolicy {
+  static constexpr bool value = false;
+  using base = Balance;
+};
+
+template <typename Balance>
+struct CountedPolicy<OrderStatistic<Balance>> {
+  static constexpr bool value = true;
+  using base = typename CountedPolicy<Balance>::base;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_MAP_ORDER_STATISTIC_H_
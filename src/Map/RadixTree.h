@@ -0,0 +1,1154 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_MAP_RADIXTREE_H_
+#define CPP2_S21_CONTAINERS_SRC_MAP_RADIXTREE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "Node.h"
+
+namespace s21 {
+
+// Bytes of a key as the radix tree walks them
+struct RadixBytes {
+  const unsigned char* data;
+  std::size_t size;
+
+  unsigned char operator[](std::size_t i) const { return data[i]; }
+};
+
+// Turns a key into bytes whose lexicographic order is the key order. Other
+// key types need a specialization with a Buffer and a bytes() like these
+template <typename KT, typename = void>
+struct RadixKey;
+
+// Strings are their own bytes, compared unsigned like std::string does
+template <>
+struct RadixKey<std::string> {
+  struct Buffer {};
+
+  static RadixBytes bytes(std::string_view key, Buffer&) {
+    return {reinterpret_cast<const unsigned char*>(key.data()), key.size()};
+  }
+};
+
+// Integers are written big-endian, with the sign bit flipped for signed types
+// so that negative numbers come first
+template <typename KT>
+struct RadixKey<KT, std::enable_if_t<std::is_integral_v<KT>>> {
+  struct Buffer {
+    unsigned char data[sizeof(KT)];
+  };
+
+  static RadixBytes bytes(KT key, Buffer& buffer) {
+    using Unsigned = std::make_unsigned_t<KT>;
+    auto value = static_cast<Unsigned>(key);
+    if constexpr (std::is_signed_v<KT>) {
+      value ^= static_cast<Unsigned>(Unsigned{1} << (8 * sizeof(KT) - 1));
+    }
+    for (std::size_t i = 0; i < sizeof(KT); ++i) {
+      buffer.data[i] =
+          static_cast<unsigned char>(value >> (8 * (sizeof(KT) - 1 - i)));
+    }
+    return {buffer.data, sizeof(KT)};
+  }
+};
+
+// Adaptive radix tree behind RadixMap. Each inner node branches on one byte
+// of the key and comes in four sizes, growing and shrinking with its number
+// of children: up to 4 and up to 16 children keep sorted byte arrays (16 is
+// searched with one SSE2 compare), 48 map a byte to a slot through a 256
+// entry index, and 256 index children directly. A chain of nodes with a
+// single child is compressed into the prefix of the next node, of which the
+// first kMaxPrefix bytes are stored; lookups skip the rest and check the
+// whole key at the leaf, updates read it from any leaf below. A key that
+// ends inside the tree, a prefix of longer keys, is the node's value leaf.
+// Leaves are linked in key order, so iterators and prefix scans walk the
+// list and never climb the tree
+template <typename KT, typename VT>
+class RadixTree {
+ public:
+  class iterator;
+
+  using size_type = std::size_t;
+
+  RadixTree();
+  RadixTree(const RadixTree&) = delete;
+  RadixTree(RadixTree&&) noexcept;
+  ~RadixTree();
+  RadixTree& operator=(const RadixTree&) = delete;
+  RadixTree& operator=(RadixTree&&) noexcept;
+
+  void assign(const RadixTree&);
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplaceUnique(K&&, Args&&...);
+  iterator search(const KT&) const;
+  size_type erase(const KT&);
+  iterator lowerBound(const KT&) const;
+  iterator upperBound(const KT&) const;
+  std::pair<iterator, iterator> prefixRange(std::string_view) const;
+  void clear() noexcept;
+  void swap(RadixTree&) noexcept;
+  iterator begin() const;
+  iterator end() const;
+  size_type size() const noexcept;
+
+ private:
+  static constexpr std::size_t kMaxPrefix = 10;
+
+  enum Type : std::uint8_t { kLeaf, kNode4, kNode16, kNode48, kNode256 };
+
+  struct Header {
+    Type type;
+
+    explicit Header(Type type) : type(type) {}
+  };
+
+  struct Leaf : Header, NodeEntry<KT, VT> {
+    Leaf* prev = nullptr;
+    Leaf* next = nullptr;
+
+    template <typename K, typename... Args>
+    explicit Leaf(K&& key, Args&&... args)
+        : Header(kLeaf),
+          NodeEntry<KT, VT>(std::piecewise_construct, std::forward<K>(key),
+                            std::forward<Args>(args)...) {}
+  };
+
+  struct Inner : Header {
+    std::uint16_t count = 0;
+    std::uint32_t prefixLength = 0;
+    unsigned char prefix[kMaxPrefix] = {};
+    Leaf* value = nullptr;  // the key ending at this node, if any
+
+    explicit Inner(Type type) : Header(type) {}
+  };
+
+  // Node4 and Node16, keys sorted ascending
+  template <int N, Type T>
+  struct SmallNode : Inner {
+    unsigned char keys[N] = {};
+    Header* children[N] = {};
+
+    SmallNode() : Inner(T) {}
+  };
+
+  using Node4 = SmallNode<4, kNode4>;
+  using Node16 = SmallNode<16, kNode16>;
+
+  // index holds a child's slot plus one, zero for none
+  struct Node48 : Inner {
+    unsigned char index[256] = {};
+    Header* children[48] = {};
+
+    Node48() : Inner(kNode48) {}
+  };
+
+  struct Node256 : Inner {
+    Header* children[256] = {};
+
+    Node256() : Inner(kNode256) {}
+  };
+
+  // A key's bytes, with room for them when they are not the key itself.
+  // Refers to key, so it must not outlive it
+  class KeyBytes {
+   public:
+    explicit KeyBytes(const KT& key)
+        : bytes(RadixKey<KT>::bytes(key, buffer_)) {}
+    KeyBytes(const KeyBytes&) = delete;
+    KeyBytes& operator=(const KeyBytes&) = delete;
+
+   private:
+    typename RadixKey<KT>::Buffer buffer_;
+
+   public:
+    const RadixBytes bytes;
+  };
+
+  static Header** findChild(Inner*, unsigned char);
+  static Header* firstChild(const Inner*);
+  static Header* lastChild(const Inner*);
+  static Header* childAfter(const Inner*, unsigned char);
+  static Header* childFrom(const Inner*, int);
+  static void addChild(Header**, unsigned char, Header*);
+  static void removeChild(Inner*, unsigned char);
+  static void grow(Header**);
+  static void shrink(Header**);
+  static void copyHeader(Inner*, const Inner*);
+  static void destroy(Header*) noexcept;
+  static void deleteNode(Inner*) noexcept;
+  static Leaf* minLeaf(const Header*);
+  static Leaf* maxLeaf(const Header*);
+  static bool sameKey(const Leaf*, RadixBytes);
+  static unsigned char prefixByte(const Inner*, std::size_t, std::size_t);
+  static std::size_t prefixMismatch(const Inner*, RadixBytes, std::size_t);
+  static void loadPrefix(Inner*, std::size_t);
+  static void compact(Header**, std::size_t);
+
+  Leaf* lowerLeaf(const Header*, RadixBytes, std::size_t) const;
+  void link(Leaf*, Leaf*);
+  void unlink(Leaf*);
+
+  Header* root_;
+  Leaf* head_;
+  Leaf* tail_;
+  size_type size_;
+};
+
+template <typename KT, typename VT>
+class RadixTree<KT, VT>::iterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = VT;
+  using difference_type = std::ptrdiff_t;
+  using pointer = VT*;
+  using reference = VT&;
+
+  iterator() : current(nullptr), tree_(nullptr) {}
+  iterator(Leaf* leaf, const RadixTree* tree) : current(leaf), tree_(tree) {}
+
+  iterator& operator++() {
+    if (current) {
+      current = current->next;
+    }
+    return *this;
+  }
+
+  iterator operator++(int) {
+    iterator old = *this;
+    ++*this;
+    return old;
+  }
+
+  iterator& operator--() {
+    current = current ? current->prev : tree_->tail_;
+    return *this;
+  }
+
+  iterator operator--(int) {
+    iterator old = *this;
+    --*this;
+    return old;
+  }
+
+  VT& operator*() const { return current->value; }
+
+  bool operator==(const iterator& other) const {
+    return current == other.current;
+  }
+
+  bool operator!=(const iterator& other) const { return !(*this == other); }
+
+  const KT& first() const { return current->key; }
+  VT& second() const { return current->value; }
+
+ private:
+  Leaf* current;
+  const RadixTree* tree_;
+};
+
+template <typename KT, typename VT>
+RadixTree<KT, VT>::RadixTree()
+    : root_(nullptr), head_(nullptr), tail_(nullptr), size_(0) {}
+
+template <typename KT, typename VT>
+RadixTree<KT, VT>::RadixTree(RadixTree&& other) noexcept : RadixTree() {
+  swap(other);
+}
+
+template <typename KT, typename VT>
+RadixTree<KT, VT>::~RadixTree() {
+  clear();
+}
+
+template <typename KT, typename VT>
+RadixTree<KT, VT>& RadixTree<KT, VT>::operator=(RadixTree&& other) noexcept {
+  swap(other);
+  return *this;
+}
+
+// Replaces the contents with a copy of other, inserted in key order
+template <typename KT, typename VT>
+void RadixTree<KT, VT>::assign(const RadixTree& other) {
+  if (this == &other) {
+    return;
+  }
+  clear();
+  for (Leaf* leaf = other.head_; leaf; leaf = leaf->next) {
+    emplaceUnique(leaf->key, leaf->value);
+  }
+}
+
+// Inserts a leaf built from key and args unless the key is present. The new
+// leaf is linked in front of its successor, the smallest leaf of whatever
+// subtree it lands before, found while the tree is still unchanged. The
+// leaf and any new node are allocated before the tree changes, so a throwing
+// constructor or allocation leaves it as it was. key may be moved from once
+// the leaf is built, so every byte needed afterwards is read first
+template <typename KT, typename VT>
+template <typename K, typename... Args>
+std::pair<typename RadixTree<KT, VT>::iterator, bool>
+RadixTree<KT, VT>::emplaceUnique(K&& key, Args&&... args) {
+  KeyBytes encoded(key);
+  RadixBytes bytes = encoded.bytes;
+  auto make = [&] {
+    return std::unique_ptr<Leaf>(
+        new Leaf(std::forward<K>(key), std::forward<Args>(args)...));
+  };
+  Header** ref = &root_;
+  std::size_t depth = 0;
+  while (true) {
+    Header* node = *ref;
+    if (!node) {
+      Leaf* leaf = make().release();
+      link(leaf, nullptr);
+      *ref = leaf;
+      ++size_;
+      return {iterator(leaf, this), true};
+    }
+    if (node->type == kLeaf) {
+      Leaf* old = static_cast<Leaf*>(node);
+      KeyBytes oldEncoded(old->key);
+      RadixBytes oldBytes = oldEncoded.bytes;
+      std::size_t split = depth;
+      while (split < bytes.size && split < oldBytes.size &&
+             bytes[split] == oldBytes[split]) {
+        ++split;
+      }
+      if (split == bytes.size && split == oldBytes.size) {
+        return {iterator(old, this), false};
+      }
+      bool ends = split == bytes.size;
+      unsigned char newByte = ends ? 0 : bytes[split];
+      bool before =
+          ends || (split < oldBytes.size && newByte < oldBytes[split]);
+      std::unique_ptr<Leaf> owned = make();
+      // The old key shares the bytes up to split and outlives the move
+      auto* inner = new Node4;
+      inner->prefixLength = static_cast<std::uint32_t>(split - depth);
+      std::memcpy(inner->prefix, oldBytes.data + depth,
+                  std::min(split - depth, kMaxPrefix));
+      if (split == oldBytes.size) {
+        inner->value = old;
+      } else {
+        inner->keys[0] = oldBytes[split];
+        inner->children[0] = old;
+        inner->count = 1;
+      }
+      *ref = inner;
+      Leaf* leaf = owned.release();
+      if (ends) {
+        inner->value = leaf;
+      } else {
+        addChild(ref, newByte, leaf);
+      }
+      link(leaf, before ? old : old->next);
+      ++size_;
+      return {iterator(leaf, this), true};
+    }
+    auto* inner = static_cast<Inner*>(node);
+    if (inner->prefixLength != 0) {
+      std::size_t match = prefixMismatch(inner, bytes, depth);
+      if (match < inner->prefixLength) {
+        // Split the prefix: a new node takes the matching part and branches
+        // between inner and the new leaf
+        unsigned char oldByte = prefixByte(inner, match, depth);
+        bool ends = depth + match == bytes.size;
+        unsigned char newByte = ends ? 0 : bytes[depth + match];
+        Leaf* after = ends || newByte < oldByte ? minLeaf(inner)
+                                                : maxLeaf(inner)->next;
+        std::unique_ptr<Leaf> owned = make();
+        auto* parent = new Node4;
+        parent->prefixLength = static_cast<std::uint32_t>(match);
+        std::memcpy(parent->prefix, inner->prefix,
+                    std::min(match, kMaxPrefix));
+        std::uint32_t rest = inner->prefixLength - (match + 1);
+        if (inner->prefixLength <= kMaxPrefix) {
+          std::memmove(inner->prefix, inner->prefix + match + 1, rest);
+          inner->prefixLength = rest;
+        } else {
+          inner->prefixLength = rest;
+          loadPrefix(inner, depth + match + 1);
+        }
+        parent->keys[0] = oldByte;
+        parent->children[0] = inner;
+        parent->count = 1;
+        *ref = parent;
+        Leaf* leaf = owned.release();
+        if (ends) {
+          parent->value = leaf;
+        } else {
+          addChild(ref, newByte, leaf);
+        }
+        link(leaf, after);
+        ++size_;
+        return {iterator(leaf, this), true};
+      }
+      depth += inner->prefixLength;
+    }
+    if (depth == bytes.size) {
+      if (inner->value) {
+        return {iterator(inner->value, this), false};
+      }
+      Leaf* after = minLeaf(firstChild(inner));
+      Leaf* leaf = make().release();
+      inner->value = leaf;
+      link(leaf, after);
+      ++size_;
+      return {iterator(leaf, this), true};
+    }
+    unsigned char byte = bytes[depth];
+    Header** child = findChild(inner, byte);
+    if (child) {
+      ref = child;
+      ++depth;
+      continue;
+    }
+    Header* next = childAfter(inner, byte);
+    Leaf* after = next ? minLeaf(next) : maxLeaf(inner)->next;
+    std::unique_ptr<Leaf> owned = make();
+    // Growing the node allocates before it changes anything
+    addChild(ref, byte, owned.get());
+    Leaf* leaf = owned.release();
+    link(leaf, after);
+    ++size_;
+    return {iterator(leaf, this), true};
+  }
+}
+
+// Leaf with key, or end(). Prefix bytes past the stored ones are skipped,
+// the leaf comparison at the end catches any difference there
+template <typename KT, typename VT>
+typename RadixTree<KT, VT>::iterator RadixTree<KT, VT>::search(
+    const KT& key) const {
+  KeyBytes encoded(key);
+  RadixBytes bytes = encoded.bytes;
+  Header* node = root_;
+  std::size_t depth = 0;
+  while (node) {
+    if (node->type == kLeaf) {
+      auto* leaf = static_cast<Leaf*>(node);
+      return iterator(sameKey(leaf, bytes) ? leaf : nullptr, this);
+    }
+    auto* inner = static_cast<Inner*>(node);
+    if (inner->prefixLength != 0) {
+      if (depth + inner->prefixLength > bytes.size) {
+        return end();
+      }
+      std::size_t stored = std::min<std::size_t>(inner->prefixLength,
+                                                 kMaxPrefix);
+      if (std::memcmp(inner->prefix, bytes.data + depth, stored) != 0) {
+        return end();
+      }
+      depth += inner->prefixLength;
+    }
+    if (depth == bytes.size) {
+      Leaf* leaf = inner->value;
+      return iterator(leaf && sameKey(leaf, bytes) ? leaf : nullptr, this);
+    }
+    Header** child = findChild(inner, bytes[depth]);
+    node = child ? *child : nullptr;
+    ++depth;
+  }
+  return end();
+}
+
+// Removes the leaf with key. The node it hung from shrinks to a smaller
+// size, or is replaced by its last remaining entry
+template <typename KT, typename VT>
+typename RadixTree<KT, VT>::size_type RadixTree<KT, VT>::erase(
+    const KT& key) {
+  KeyBytes encoded(key);
+  RadixBytes bytes = encoded.bytes;
+  Header** ref = &root_;
+  Header** parentRef = nullptr;
+  std::size_t parentDepth = 0;
+  std::size_t depth = 0;
+  unsigned char parentByte = 0;
+  while (*ref) {
+    Header* node = *ref;
+    Leaf* leaf = nullptr;
+    if (node->type == kLeaf) {
+      leaf = static_cast<Leaf*>(node);
+      if (!sameKey(leaf, bytes)) {
+        return 0;
+      }
+      if (parentRef) {
+        removeChild(static_cast<Inner*>(*parentRef), parentByte);
+        compact(parentRef, parentDepth);
+      } else {
+        root_ = nullptr;
+      }
+    } else {
+      auto* inner = static_cast<Inner*>(node);
+      std::size_t start = depth;
+      if (prefixMismatch(inner, bytes, depth) < inner->prefixLength) {
+        return 0;
+      }
+      depth += inner->prefixLength;
+      if (depth < bytes.size) {
+        Header** child = findChild(inner, bytes[depth]);
+        if (!child) {
+          return 0;
+        }
+        parentRef = ref;
+        parentDepth = start;
+        parentByte = bytes[depth];
+        ref = child;
+        ++depth;
+        continue;
+      }
+      leaf = inner->value;
+      if (!leaf) {
+        return 0;
+      }
+      inner->value = nullptr;
+      compact(ref, start);
+    }
+    unlink(leaf);
+    delete leaf;
+    --size_;
+    return 1;
+  }
+  return 0;
+}
+
+// First leaf not less than key
+template <typename KT, typename VT>
+typename RadixTree<KT, VT>::iterator RadixTree<KT, VT>::lowerBound(
+    const KT& key) const {
+  KeyBytes encoded(key);
+  return iterator(root_ ? lowerLeaf(root_, encoded.bytes, 0) : nullptr, this);
+}
+
+// First leaf greater than key
+template <typename KT, typename VT>
+typename RadixTree<KT, VT>::iterator RadixTree<KT, VT>::upperBound(
+    const KT& key) const {
+  KeyBytes encoded(key);
+  Leaf* leaf = root_ ? lowerLeaf(root_, encoded.bytes, 0) : nullptr;
+  if (leaf && sameKey(leaf, encoded.bytes)) {
+    leaf = leaf->next;
+  }
+  return iterator(leaf, this);
+}
+
+// Leaves whose key bytes start with prefix: the subtree below the node where
+// prefix runs out, which is a contiguous stretch of the leaf list
+template <typename KT, typename VT>
+std::pair<typename RadixTree<KT, VT>::iterator,
+          typename RadixTree<KT, VT>::iterator>
+RadixTree<KT, VT>::prefixRange(std::string_view prefix) const {
+  typename RadixKey<std::string>::Buffer buffer;
+  RadixBytes bytes = RadixKey<std::string>::bytes(prefix, buffer);
+  const Header* node = root_;
+  std::size_t depth = 0;
+  while (node) {
+    if (node->type == kLeaf) {
+      KeyBytes encoded(static_cast<const Leaf*>(node)->key);
+      if (encoded.bytes.size >= bytes.size &&
+          std::memcmp(encoded.bytes.data, bytes.data, bytes.size) == 0) {
+        break;
+      }
+      return {end(), end()};
+    }
+    auto* inner = static_cast<const Inner*>(node);
+    std::size_t match = prefixMismatch(inner, bytes, depth);
+    if (depth + match == bytes.size) {
+      break;
+    }
+    if (match < inner->prefixLength) {
+      return {end(), end()};
+    }
+    depth += inner->prefixLength;
+    Header** child = findChild(const_cast<Inner*>(inner), bytes[depth]);
+    node = child ? *child : nullptr;
+    ++depth;
+  }
+  if (!node) {
+    return {end(), end()};
+  }
+  return {iterator(minLeaf(node), this), iterator(maxLeaf(node)->next, this)};
+}
+
+template <typename KT, typename VT>
+void RadixTree<KT, VT>::clear() noexcept {
+  if (root_ && root_->type != kLeaf) {
+    destroy(root_);
+  }
+  while (head_) {
+    Leaf* next = head_->next;
+    delete head_;
+    head_ = next;
+  }
+  root_ = nullptr;
+  tail_ = nullptr;
+  size_ = 0;
+}
+
+template <typename KT, typename VT>
+void RadixTree<KT, VT>::swap(RadixTree& other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(head_, other.head_);
+  std::swap(tail_, other.tail_);
+  std::swap(size_, other.size_);
+}
+
+template <typename KT, typename VT>
+typename RadixTree<KT, VT>::iterator RadixTree<KT, VT>::begin() const {
+  return iterator(head_, this);
+}
+
+template <typename KT, typename VT>
+typename RadixTree<KT, VT>::iterator RadixTree<KT, VT>::end() const {
+  return iterator(nullptr, this);
+}
+
+template <typename KT, typename VT>
+typename RadixTree<KT, VT>::size_type RadixTree<KT, VT>::size()
+    const noexcept {
+  return size_;
+}
+
+// Slot of the child for byte, or nullptr
+template <typename KT, typename VT>
+typename RadixTree<KT, VT>::Header** RadixTree<KT, VT>::findChild(
+    Inner* node, unsigned char byte) {
+  switch (node->type) {
+    case kNode4: {
+      auto* small = static_cast<Node4*>(node);
+      for (int i = 0; i < small->count; ++i) {
+        if (small->keys[i] == byte) {
+          return &small->children[i];
+        }
+      }
+      return nullptr;
+    }
+    case kNode16: {
+      auto* small = static_cast<Node16*>(node);
+#if defined(__SSE2__)
+      __m128i keys =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(small->keys));
+      __m128i equal =
+          _mm_cmpeq_epi8(keys, _mm_set1_epi8(static_cast<char>(byte)));
+      unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(equal)) &
+                      ((1U << small->count) - 1);
+      return mask ? &small->children[__builtin_ctz(mask)] : nullptr;
+#else
+      for (int i = 0; i < small->count; ++i) {
+        if (small->keys[i] == byte) {
+          return &small->children[i];
+        }
+      }
+      return nullptr;
+#endif
+    }
+    case kNode48: {
+      auto* medium = static_cast<Node48*>(node);
+      int slot = medium->index[byte];
+      return slot ? &medium->children[slot - 1] : nullptr;
+    }
+    default: {
+      auto* large = static_cast<Node256*>(node);
+      return large->children[byte] ? &large->children[byte] : nullptr;
+    }
+  }
+}
+
+template <typename KT, typename VT>
+typename RadixTree<KT, VT>::Header* RadixTree<KT, VT>::firstChild(
+    const Inner* node) {
+  return childFrom(node, 0);
+}
+
+template <typename KT, typename VT>
+typename RadixTree<KT, VT>::Header* RadixTree<KT, VT>::lastChild(
+    const Inner* node) {
+  switch (node->type) {
+    case kNode4:
+      return node->count
+                 ? static_cast<const Node4*>(node)->children[node->count - 1]
+                 : nullptr;
+    case kNode16:
+      return node->count
+                 ? static_cast<const Node16*>(node)->children[node->count - 1]
+                 : nullptr;
+    case kNode48: {
+      auto* medium = static_cast<const Node48*>(node);
+      for (int byte = 255; byte >= 0; --byte) {
+        if (medium->index[byte]) {
+          return medium->children[medium->index[byte] - 1];
+        }
+      }
+      return nullptr;
+    }
+    default: {
+      auto* large = static_cast<const Node256*>(node);
+      for (int byte = 255; byte >= 0; --byte) {
+        if (large->children[byte]) {
+          return large->children[byte];
+        }
+      }
+      return nullptr;
+    }
+  }
+}
+
+template <typename KT, typename VT>
+typename RadixTree<KT, VT>::Header* RadixTree<KT, VT>::childAfter(
+    const Inner* node, unsigned char byte) {
+  return childFrom(node, byte + 1);
+}
+
+// Child with the smallest byte not below from, or nullptr
+template <typename KT, typename VT>
+typename RadixTree<KT, VT>::Header* RadixTree<KT, VT>::childFrom(
+    const Inner* node, int from) {
+  switch (node->type) {
+    case kNode4: {
+      auto* small = static_cast<const Node4*>(node);
+      for (int i = 0; i < small->count; ++i) {
+        if (small->keys[i] >= from) {
+          return small->children[i];
+        }
+      }
+      return nullptr;
+    }
+    case kNode16: {
+      auto* small = static_cast<const Node16*>(node);
+      for (int i = 0; i < small->count; ++i) {
+        if (small->keys[i] >= from) {
+          return small->children[i];
+        }
+      }
+      return nullptr;
+    }
+    case kNode48: {
+      auto* medium = static_cast<const Node48*>(node);
+      for (int byte = from; byte < 256; ++byte) {
+        if (medium->index[byte]) {
+          return medium->children[medium->index[byte] - 1];
+        }
+      }
+      return nullptr;
+    }
+    default: {
+      auto* large = static_cast<const Node256*>(node);
+      for (int byte = from; byte < 256; ++byte) {
+        if (large->children[byte]) {
+          return large->children[byte];
+        }
+      }
+      return nullptr;
+    }
+  }
+}
+
+// Adds child under byte, which must be free, moving the node at ref to the
+// next size first if it is full
+template <typename KT, typename VT>
+void RadixTree<KT, VT>::addChild(Header** ref, unsigned char byte,
+                                 Header* child) {
+  auto* node = static_cast<Inner*>(*ref);
+  if ((node->type == kNode4 && node->count == 4) ||
+      (node->type == kNode16 && node->count == 16) ||
+      (node->type == kNode48 && node->count == 48)) {
+    grow(ref);
+    node = static_cast<Inner*>(*ref);
+  }
+  switch (node->type) {
+    case kNode4:
+    case kNode16: {
+      unsigned char* keys = node->type == kNode4
+                                ? static_cast<Node4*>(node)->keys
+                                : static_cast<Node16*>(node)->keys;
+      Header** children = node->type == kNode4
+                              ? static_cast<Node4*>(node)->children
+                              : static_cast<Node16*>(node)->children;
+      int pos = node->count;
+      while (pos > 0 && keys[pos - 1] > byte) {
+        keys[pos] = keys[pos - 1];
+        children[pos] = children[pos - 1];
+        --pos;
+      }
+      keys[pos] = byte;
+      children[pos] = child;
+      break;
+    }
+    case kNode48: {
+      auto* medium = static_cast<Node48*>(node);
+      int slot = 0;
+      while (medium->children[slot]) {
+        ++slot;
+      }
+      medium->children[slot] = child;
+      medium->index[byte] = static_cast<unsigned char>(slot + 1);
+      break;
+    }
+    default:
+      static_cast<Node256*>(node)->children[byte] = child;
+  }
+  ++node->count;
+}
+
+// Drops the child under byte, the node keeps its size until compact
+template <typename KT, typename VT>
+void RadixTree<KT, VT>::removeChild(Inner* node, unsigned char byte) {
+  switch (node->type) {
+    case kNode4:
+    case kNode16: {
+      unsigned char* keys = node->type == kNode4
+                                ? static_cast<Node4*>(node)->keys
+                                : static_cast<Node16*>(node)->keys;
+      Header** children = node->type == kNode4
+                              ? static_cast<Node4*>(node)->children
+                              : static_cast<Node16*>(node)->children;
+      int pos = 0;
+      while (keys[pos] != byte) {
+        ++pos;
+      }
+      for (; pos + 1 < node->count; ++pos) {
+        keys[pos] = keys[pos + 1];
+        children[pos] = children[pos + 1];
+      }
+      break;
+    }
+    case kNode48: {
+      auto* medium = static_cast<Node48*>(node);
+      medium->children[medium->index[byte] - 1] = nullptr;
+      medium->index[byte] = 0;
+      break;
+    }
+    default:
+      static_cast<Node256*>(node)->children[byte] = nullptr;
+  }
+  --node->count;
+}
+
+// Replaces the full node at ref with one of the next size
+template <typename KT, typename VT>
+void RadixTree<KT, VT>::grow(Header** ref) {
+  auto* node = static_cast<Inner*>(*ref);
+  Inner* bigger = nullptr;
+  if (node->type == kNode4) {
+    auto* from = static_cast<Node4*>(node);
+    auto* to = new Node16;
+    std::copy(from->keys, from->keys + 4, to->keys);
+    std::copy(from->children, from->children + 4, to->children);
+    bigger = to;
+  } else if (node->type == kNode16) {
+    auto* from = static_cast<Node16*>(node);
+    auto* to = new Node48;
+    for (int i = 0; i < 16; ++i) {
+      to->children[i] = from->children[i];
+      to->index[from->keys[i]] = static_cast<unsigned char>(i + 1);
+    }
+    bigger = to;
+  } else {
+    auto* from = static_cast<Node48*>(node);
+    auto* to = new Node256;
+    for (int byte = 0; byte < 256; ++byte) {
+      if (from->index[byte]) {
+        to->children[byte] = from->children[from->index[byte] - 1];
+      }
+    }
+    bigger = to;
+  }
+  copyHeader(bigger, node);
+  deleteNode(node);
+  *ref = bigger;
+}
+
+// Replaces the sparse node at ref with one of the previous size. Sizes
+// shrink well below the point where they grew, so alternating inserts and
+// erases at the boundary do not convert back and forth
+template <typename KT, typename VT>
+void RadixTree<KT, VT>::shrink(Header** ref) {
+  auto* node = static_cast<Inner*>(*ref);
+  Inner* smaller = nullptr;
+  if (node->type == kNode16) {
+    auto* from = static_cast<Node16*>(node);
+    auto* to = new Node4;
+    std::copy(from->keys, from->keys + from->count, to->keys);
+    std::copy(from->children, from->children + from->count, to->children);
+    smaller = to;
+  } else if (node->type == kNode48) {
+    auto* from = static_cast<Node48*>(node);
+    auto* to = new Node16;
+    int pos = 0;
+    for (int byte = 0; byte < 256; ++byte) {
+      if (from->index[byte]) {
+        to->keys[pos] = static_cast<unsigned char>(byte);
+        to->children[pos++] = from->children[from->index[byte] - 1];
+      }
+    }
+    smaller = to;
+  } else {
+    auto* from = static_cast<Node256*>(node);
+    auto* to = new Node48;
+    int slot = 0;
+    for (int byte = 0; byte < 256; ++byte) {
+      if (from->children[byte]) {
+        to->children[slot] = from->children[byte];
+        to->index[byte] = static_cast<unsigned char>(++slot);
+      }
+    }
+    smaller = to;
+  }
+  copyHeader(smaller, node);
+  deleteNode(node);
+  *ref = smaller;
+}
+
+template <typename KT, typename VT>
+void RadixTree<KT, VT>::copyHeader(Inner* to, const Inner* from) {
+  to->count = from->count;
+  to->prefixLength = from->prefixLength;
+  std::copy(from->prefix, from->prefix + kMaxPrefix, to->prefix);
+  to->value = from->value;
+}
+
+// Frees an inner node and the inner nodes below it, leaves stay in the list
+template <typename KT, typename VT>
+void RadixTree<KT, VT>::destroy(Header* node) noexcept {
+  auto* inner = static_cast<Inner*>(node);
+  Header** children = nullptr;
+  int slots = 0;
+  switch (inner->type) {
+    case kNode4:
+      children = static_cast<Node4*>(inner)->children;
+      slots = inner->count;
+      break;
+    case kNode16:
+      children = static_cast<Node16*>(inner)->children;
+      slots = inner->count;
+      break;
+    case kNode48:
+      children = static_cast<Node48*>(inner)->children;
+      slots = 48;
+      break;
+    default:
+      children = static_cast<Node256*>(inner)->children;
+      slots = 256;
+  }
+  for (int i = 0; i < slots; ++i) {
+    if (children[i] && children[i]->type != kLeaf) {
+      destroy(children[i]);
+    }
+  }
+  deleteNode(inner);
+}
+
+// Frees node alone, its children stay where they are
+template <typename KT, typename VT>
+void RadixTree<KT, VT>::deleteNode(Inner* node) noexcept {
+  switch (node->type) {
+    case kNode4:
+      delete static_cast<Node4*>(node);
+      break;
+    case kNode16:
+      delete static_cast<Node16*>(node);
+      break;
+    case kNode48:
+      delete static_cast<Node48*>(node);
+      break;
+    default:
+      delete static_cast<Node256*>(node);
+  }
+}
+
+// Smallest leaf below node: a value leaf comes before every child
+template <typename KT, typename VT>
+typename RadixTree<KT, VT>::Leaf* RadixTree<KT, VT>::minLeaf(
+    const Header* node) {
+  while (node->type != kLeaf) {
+    auto* inner = static_cast<const Inner*>(node);
+    if (inner->value) {
+      return inner->value;
+    }
+    node = firstChild(inner);
+  }
+  return const_cast<Leaf*>(static_cast<const Leaf*>(node));
+}
+
+template <typename KT, typename VT>
+typename RadixTree<KT, VT>::Leaf* RadixTree<KT, VT>::maxLeaf(
+    const Header* node) {
+  while (node->type != kLeaf) {
+    auto* inner = static_cast<const Inner*>(node);
+    Header* last = lastChild(inner);
+    if (!last) {
+      return inner->value;
+    }
+    node = last;
+  }
+  return const_cast<Leaf*>(static_cast<const Leaf*>(node));
+}
+
+template <typename KT, typename VT>
+bool RadixTree<KT, VT>::sameKey(const Leaf* leaf, RadixBytes bytes) {
+  KeyBytes encoded(leaf->key);
+  return encoded.bytes.size == bytes.size &&
+         std::memcmp(encoded.bytes.data, bytes.data, bytes.size) == 0;
+}
+
+// Byte i of the prefix of node, which starts at depth
+template <typename KT, typename VT>
+unsigned char RadixTree<KT, VT>::prefixByte(const Inner* node, std::size_t i,
+                                            std::size_t depth) {
+  if (i < kMaxPrefix) {
+    return node->prefix[i];
+  }
+  KeyBytes encoded(minLeaf(node)->key);
+  return encoded.bytes[depth + i];
+}
+
+// Length of the common start of the prefix of node and the bytes of a key
+// from depth on. Prefix bytes past the stored ones come from a leaf
+template <typename KT, typename VT>
+std::size_t RadixTree<KT, VT>::prefixMismatch(const Inner* node,
+                                              RadixBytes bytes,
+                                              std::size_t depth) {
+  std::size_t length = node->prefixLength;
+  std::size_t stored = std::min(length, kMaxPrefix);
+  std::size_t i = 0;
+  for (; i < stored; ++i) {
+    if (depth + i == bytes.size || node->prefix[i] != bytes[depth + i]) {
+      return i;
+    }
+  }
+  if (length > stored) {
+    KeyBytes encoded(minLeaf(node)->key);
+    for (; i < length; ++i) {
+      if (depth + i == bytes.size ||
+          encoded.bytes[depth + i] != bytes[depth + i]) {
+        return i;
+      }
+    }
+  }
+  return length;
+}
+
+// Refills the stored prefix of node, which starts at depth, from a leaf
+template <typename KT, typename VT>
+void RadixTree<KT, VT>::loadPrefix(Inner* node, std::size_t depth) {
+  KeyBytes encoded(minLeaf(node)->key);
+  std::size_t stored = std::min<std::size_t>(node->prefixLength, kMaxPrefix);
+  std::memcpy(node->prefix, encoded.bytes.data + depth, stored);
+}
+
+// Restores the shape rules after the node at ref, starting at depth, lost an
+// entry: a node left with its value leaf alone becomes that leaf, one left
+// with a single child merges into it, and a sparse node shrinks
+template <typename KT, typename VT>
+void RadixTree<KT, VT>::compact(Header** ref, std::size_t depth) {
+  auto* node = static_cast<Inner*>(*ref);
+  if (node->count == 0) {
+    *ref = node->value;
+    deleteNode(node);
+    return;
+  }
+  if (node->count == 1 && !node->value) {
+    Header* child = firstChild(node);
+    if (child->type != kLeaf) {
+      auto* inner = static_cast<Inner*>(child);
+      inner->prefixLength += node->prefixLength + 1;
+      loadPrefix(inner, depth);
+    }
+    *ref = child;
+    deleteNode(node);
+    return;
+  }
+  if ((node->type == kNode16 && node->count <= 3) ||
+      (node->type == kNode48 && node->count <= 12) ||
+      (node->type == kNode256 && node->count <= 36)) {
+    shrink(ref);
+  }
+}
+
+// Smallest leaf below node not less than the key, which matches the path up
+// to depth, or nullptr if every key below node is less
+template <typename KT, typename VT>
+typename RadixTree<KT, VT>::Leaf* RadixTree<KT, VT>::lowerLeaf(
+    const Header* node, RadixBytes bytes, std::size_t depth) const {
+  if (node->type == kLeaf) {
+    auto* leaf = static_cast<const Leaf*>(node);
+    KeyBytes encoded(leaf->key);
+    const RadixBytes& own = encoded.bytes;
+    std::size_t common = std::min(own.size, bytes.size);
+    int order = std::memcmp(own.data + depth, bytes.data + depth,
+                            common - depth);
+    bool less = order < 0 || (order == 0 && own.size < bytes.size);
+    return less ? nullptr : const_cast<Leaf*>(leaf);
+  }
+  auto* inner = static_cast<const Inner*>(node);
+  std::size_t match = prefixMismatch(inner, bytes, depth);
+  if (match < inner->prefixLength) {
+    if (depth + match == bytes.size ||
+        prefixByte(inner, match, depth) > bytes[depth + match]) {
+      return minLeaf(inner);
+    }
+    return nullptr;
+  }
+  depth += inner->prefixLength;
+  if (depth == bytes.size) {
+    return minLeaf(inner);
+  }
+  unsigned char byte = bytes[depth];
+  Header** child = findChild(const_cast<Inner*>(inner), byte);
+  if (child) {
+    Leaf* found = lowerLeaf(*child, bytes, depth + 1);
+    if (found) {
+      return found;
+    }
+  }
+  Header* next = childAfter(inner, byte);
+  return next ? minLeaf(next) : nullptr;
+}
+
+// Links leaf in front of next, at the tail if next is nullptr
+template <typename KT, typename VT>
+void RadixTree<KT, VT>::link(Leaf* leaf, Leaf* next) {
+  leaf->next = next;
+  leaf->prev = next ? next->prev : tail_;
+  if (leaf->prev) {
+    leaf->prev->next = leaf;
+  } else {
+    head_ = leaf;
+  }
+  if (next) {
+    next->prev = leaf;
+  } else {
+    tail_ = leaf;
+  }
+}
+
+template <typename KT, typename VT>
+void RadixTree<KT, VT>::unlink(Leaf* leaf) {
+  if (leaf->prev) {
+    leaf->prev->next = leaf->next;
+  } else {
+    head_ = leaf->next;
+  }
+  if (leaf->next) {
+    leaf->next->prev = leaf->prev;
+  } else {
+    tail_ = leaf->prev;
+  }
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_MAP_RADIXTREE_H_
@@ -0,0 +1,154 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_MAP_RED_BLACK_BALANCE_H_
+#define CPP2_S21_CONTAINERS_SRC_MAP_RED_BLACK_BALANCE_H_
+
+namespace s21 {
+
+// Red-black balancing policy for BTree. Keeps the height below 2 * log2(n + 1)
+// with at most two rotations per insert and three per removal, which makes it
+// the cheapest policy for write-heavy trees
+struct RedBlackBalance {
+  static constexpr unsigned kBlack = 0;
+  static constexpr unsigned kRed = 1;
+  static constexpr bool kCloneable = true;
+
+  template <typename NodeT>
+  static bool isRed(const NodeT* node) {
+    return node != nullptr && node->balance() == kRed;
+  }
+
+  // Repairs a red node with a red parent by recoloring and at most two
+  // rotations
+  template <typename Tree>
+  static void afterInsert(Tree& tree, typename Tree::node_type* node) {
+    using node_type = typename Tree::node_type;
+    node->setBalance(kRed);
+    while (node != tree.getRoot() && isRed(node->parent())) {
+      node_type* parent = node->parent();
+      node_type* grand = parent->parent();
+      if (parent == grand->left) {
+        node_type* uncle = grand->right;
+        if (isRed(uncle)) {
+          parent->setBalance(kBlack);
+          uncle->setBalance(kBlack);
+          grand->setBalance(kRed);
+          node = grand;
+          continue;
+        }
+        if (node == parent->right) {
+          node = parent;
+          tree.rotateLeft(node);
+          parent = node->parent();
+        }
+        parent->setBalance(kBlack);
+        grand->setBalance(kRed);
+        tree.rotateRight(grand);
+      } else {
+        node_type* uncle = grand->left;
+        if (isRed(uncle)) {
+          parent->setBalance(kBlack);
+          uncle->setBalance(kBlack);
+          grand->setBalance(kRed);
+          node = grand;
+          continue;
+        }
+        if (node == parent->left) {
+          node = parent;
+          tree.rotateRight(node);
+          parent = node->parent();
+        }
+        parent->setBalance(kBlack);
+        grand->setBalance(kRed);
+        tree.rotateLeft(grand);
+      }
+    }
+    tree.getRoot()->setBalance(kBlack);
+  }
+
+  // Restores the black height when a black node left the tree
+  template <typename Tree>
+  static void afterRemove(Tree& tree, const typename Tree::Removal& removal) {
+    using node_type = typename Tree::node_type;
+    if (removal.balance == kRed) {
+      return;
+    }
+    node_type* parent = removal.parent;
+    node_type* node = parent == nullptr ? tree.getRoot()
+                      : removal.left    ? parent->left
+                                        : parent->right;
+    while (node != tree.getRoot() && !isRed(node)) {
+      if (node == parent->left) {
+        node_type* sibling = parent->right;
+        if (isRed(sibling)) {
+          sibling->setBalance(kBlack);
+          parent->setBalance(kRed);
+          tree.rotateLeft(parent);
+          sibling = parent->right;
+        }
+        if (!isRed(sibling->left) && !isRed(sibling->right)) {
+          sibling->setBalance(kRed);
+          node = parent;
+          parent = node->parent();
+          continue;
+        }
+        if (!isRed(sibling->right)) {
+          sibling->left->setBalance(kBlack);
+          sibling->setBalance(kRed);
+          tree.rotateRight(sibling);
+          sibling = parent->right;
+        }
+        sibling->setBalance(parent->balance());
+        parent->setBalance(kBlack);
+        sibling->right->setBalance(kBlack);
+        tree.rotateLeft(parent);
+      } else {
+        node_type* sibling = parent->left;
+        if (isRed(sibling)) {
+          sibling->setBalance(kBlack);
+          parent->setBalance(kRed);
+          tree.rotateRight(parent);
+          sibling = parent->left;
+        }
+        if (!isRed(sibling->left) && !isRed(sibling->right)) {
+          sibling->setBalance(kRed);
+          node = parent;
+          parent = node->parent();
+          continue;
+        }
+        if (!isRed(sibling->left)) {
+          sibling->right->setBalance(kBlack);
+          sibling->setBalance(kRed);
+          tree.rotateLeft(sibling);
+          sibling = parent->left;
+        }
+        sibling->setBalance(parent->balance());
+        parent->setBalance(kBlack);
+        sibling->left->setBalance(kBlack);
+        tree.rotateRight(parent);
+      }
+      node = tree.getRoot();
+    }
+    if (node) {
+      node->setBalance(kBlack);
+    }
+  }
+
+  // Links sorted nodes into a tree of minimal height. Only the last level can
+  // be incomplete, so its nodes are red and all others black
+  template <typename Tree>
+  static typename Tree::node_type* build(Tree& tree,
+                                         typename Tree::node_type** nodes,
+                                         typename Tree::size_type count) {
+    using node_type = typename Tree::node_type;
+    using size_type = typename Tree::size_type;
+    size_type height = Tree::medianHeight(count);
+    return tree.linkMedians(
+        nodes, count, nullptr, 0,
+        [height](node_type* node, size_type depth, size_type, size_type) {
+          node->setBalance(height > 1 && depth + 1 == height ? kRed : kBlack);
+        });
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_MAP_RED_BLACK_BALANCE_H_
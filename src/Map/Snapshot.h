@@ -0,0 +1,213 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_MAP_SNAPSHOT_H_
+#define CPP2_S21_CONTAINERS_SRC_MAP_SNAPSHOT_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace s21 {
+
+// On-disk layout behind MappedMap and MappedSet: this header, then the keys
+// as one array in ascending order, then the values in the same order. Both
+// arrays start on kAlignment boundaries, so a read-only mapping of the file
+// serves them in place. Integers are stored in the writer's byte order,
+// which byteOrder records, and keys and values as their raw object bytes
+struct SnapshotHeader {
+  static constexpr char kMagic[8] = {'S', '2', '1', 'S', 'N', 'A', 'P', '\0'};
+  static constexpr std::uint32_t kVersion = 1;
+  static constexpr std::uint32_t kByteOrder = 0x01020304;
+  static constexpr std::uint64_t kAlignment = 64;
+
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byteOrder;
+  std::uint32_t keySize;
+  std::uint32_t valueSize;  // zero for sets, which end after the keys
+  std::uint64_t count;
+  std::uint64_t keysOffset;
+  std::uint64_t valuesOffset;
+  std::uint64_t fileSize;
+
+  static SnapshotHeader make(std::uint32_t keySize, std::uint32_t valueSize,
+                             std::uint64_t count) {
+    SnapshotHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byteOrder = kByteOrder;
+    header.keySize = keySize;
+    header.valueSize = valueSize;
+    header.count = count;
+    header.keysOffset = align(sizeof(SnapshotHeader));
+    header.valuesOffset = align(header.keysOffset + count * keySize);
+    header.fileSize = valueSize ? header.valuesOffset + count * valueSize
+                                : header.keysOffset + count * keySize;
+    return header;
+  }
+
+  static std::uint64_t align(std::uint64_t offset) {
+    return (offset + kAlignment - 1) / kAlignment * kAlignment;
+  }
+};
+
+// Writes a snapshot to a temporary file next to path and renames it over
+// path on commit, so a reader never maps a half-written file. Dropping the
+// writer before commit removes the temporary file
+class SnapshotWriter {
+ public:
+  explicit SnapshotWriter(const std::string& path)
+      : path_(path), temporary_(path + ".tmp"), written_(0), done_(false) {
+    out_.open(temporary_, std::ios::binary | std::ios::trunc);
+    if (!out_) {
+      throw std::system_error(errno, std::generic_category(),
+                              "s21::SnapshotWriter: " + temporary_);
+    }
+  }
+
+  SnapshotWriter(const SnapshotWriter&) = delete;
+  SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+  ~SnapshotWriter() {
+    if (!done_) {
+      out_.close();
+      std::remove(temporary_.c_str());
+    }
+  }
+
+  void write(const void* data, std::size_t size) {
+    out_.write(static_cast<const char*>(data),
+               static_cast<std::streamsize>(size));
+    written_ += size;
+  }
+
+  // Pads with zeros up to offset
+  void skipTo(std::uint64_t offset) {
+    static const char kZeros[SnapshotHeader::kAlignment] = {};
+    while (written_ < offset) {
+      write(kZeros, std::min<std::uint64_t>(offset - written_, sizeof(kZeros)));
+    }
+  }
+
+  void commit() {
+    out_.close();
+    if (!out_ || std::rename(temporary_.c_str(), path_.c_str()) != 0) {
+      throw std::system_error(errno, std::generic_category(),
+                              "s21::SnapshotWriter: " + path_);
+    }
+    done_ = true;
+  }
+
+ private:
+  std::string path_;
+  std::string temporary_;
+  std::ofstream out_;
+  std::uint64_t written_;
+  bool done_;
+};
+
+// Read-only mapping of a whole snapshot file. Pages are read on first
+// access, so opening costs the same for any file size. The header is
+// checked against the layout the reader expects
+class SnapshotFile {
+ public:
+  SnapshotFile(const std::string& path, std::uint32_t keySize,
+               std::uint32_t valueSize)
+      : data_(nullptr), size_(0) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(),
+                              "s21::SnapshotFile: " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+      int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(),
+                              "s21::SnapshotFile: " + path);
+    }
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ < sizeof(SnapshotHeader)) {
+      ::close(fd);
+      throw std::runtime_error("s21::SnapshotFile: not a snapshot: " + path);
+    }
+    void* data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    int error = errno;
+    ::close(fd);
+    if (data == MAP_FAILED) {
+      throw std::system_error(error, std::generic_category(),
+                              "s21::SnapshotFile: " + path);
+    }
+    data_ = data;
+    std::memcpy(&header_, data_, sizeof(header_));
+    if (!valid(keySize, valueSize)) {
+      ::munmap(data_, size_);
+      throw std::runtime_error("s21::SnapshotFile: not a snapshot of this "
+                               "key and value type: " + path);
+    }
+  }
+
+  SnapshotFile(SnapshotFile&& other) noexcept
+      : data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        header_(other.header_) {}
+
+  SnapshotFile& operator=(SnapshotFile&& other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(header_, other.header_);
+    return *this;
+  }
+
+  SnapshotFile(const SnapshotFile&) = delete;
+  SnapshotFile& operator=(const SnapshotFile&) = delete;
+
+  ~SnapshotFile() {
+    if (data_) {
+      ::munmap(data_, size_);
+    }
+  }
+
+  bool mapped() const { return data_ != nullptr; }
+  const SnapshotHeader& header() const { return header_; }
+
+  const void* at(std::uint64_t offset) const {
+    return static_cast<const char*>(data_) + offset;
+  }
+
+ private:
+  bool valid(std::uint32_t keySize, std::uint32_t valueSize) const {
+    const SnapshotHeader& h = header_;
+    if (std::memcmp(h.magic, SnapshotHeader::kMagic, sizeof(h.magic)) != 0 ||
+        h.version != SnapshotHeader::kVersion ||
+        h.byteOrder != SnapshotHeader::kByteOrder || h.keySize != keySize ||
+        h.valueSize != valueSize) {
+      return false;
+    }
+    SnapshotHeader expected = SnapshotHeader::make(keySize, valueSize,
+                                                   h.count);
+    return h.count <= size_ / keySize &&
+           h.keysOffset == expected.keysOffset &&
+           h.valuesOffset == expected.valuesOffset &&
+           h.fileSize == expected.fileSize && h.fileSize <= size_;
+  }
+
+  void* data_;
+  std::size_t size_;
+  SnapshotHeader header_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_MAP_SNAPSHOT_H_
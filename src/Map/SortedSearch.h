@@ -0,0 +1,44 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_MAP_SORTEDSEARCH_H_
+#define CPP2_S21_CONTAINERS_SRC_MAP_SORTEDSEARCH_H_
+
+#include <cstddef>
+
+namespace s21 {
+
+// Binary searches over a sorted array that halve the range with a
+// conditional move instead of a branch, so a lookup never pays for a
+// mispredicted comparison. Every search runs the same log2(count) steps
+
+// First element of [first, first + count) not less than key
+template <typename KT, typename K, typename Compare>
+const KT* branchlessLowerBound(const KT* first, std::size_t count,
+                               const K& key, const Compare& less) {
+  if (count == 0) {
+    return first;
+  }
+  while (count > 1) {
+    std::size_t half = count / 2;
+    first = less(first[half - 1], key) ? first + half : first;
+    count -= half;
+  }
+  return first + less(*first, key);
+}
+
+// First element of [first, first + count) greater than key
+template <typename KT, typename K, typename Compare>
+const KT* branchlessUpperBound(const KT* first, std::size_t count,
+                               const K& key, const Compare& less) {
+  if (count == 0) {
+    return first;
+  }
+  while (count > 1) {
+    std::size_t half = count / 2;
+    first = less(key, first[half - 1]) ? first : first + half;
+    count -= half;
+  }
+  return first + !less(key, *first);
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_MAP_SORTEDSEARCH_H_
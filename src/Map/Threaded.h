@@ -0,0 +1,55 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_MAP_THREADED_H_
+#define CPP2_S21_CONTAINERS_SRC_MAP_THREADED_H_
+
+#include "OrderStatistic.h"
+
+namespace s21 {
+
+// Threads the nodes of a tree with another balancing policy, as in
+// Map<int, int, Threaded<AvlBalance>>. Every node also links to its in-order
+// successor and predecessor, which BTree keeps up to date on insert and erase.
+// That costs two words per node, and makes every iterator step a single
+// pointer hop instead of a climb through parents that is O(log n) in the worst
+// case. Combines with OrderStatistic in either order
+template <typename Balance>
+struct Threaded {
+  static constexpr bool kCloneable = Balance::kCloneable;
+
+  template <typename Tree>
+  static void afterInsert(Tree& tree, typename Tree::node_type* node) {
+    Balance::afterInsert(tree, node);
+  }
+
+  template <typename Tree>
+  static void afterRemove(Tree& tree, const typename Tree::Removal& removal) {
+    Balance::afterRemove(tree, removal);
+  }
+
+  template <typename Tree>
+  static typename Tree::node_type* build(Tree& tree,
+                                         typename Tree::node_type** nodes,
+                                         typename Tree::size_type count) {
+    return Balance::build(tree, nodes, count);
+  }
+};
+
+template <typename Balance>
+struct CountedPolicy<Threaded<Balance>> : CountedPolicy<Balance> {};
+
+// Whether the policy threads the nodes
+template <typename Balance>
+struct ThreadedPolicy {
+  static constexpr bool value = false;
+};
+
+template <typename Balance>
+struct ThreadedPolicy<Threaded<Balance>> {
+  static constexpr bool value = true;
+};
+
+template <typename Balance>
+struct ThreadedPolicy<OrderStatistic<Balance>> : ThreadedPolicy<Balance> {};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_MAP_THREADED_H_
@@ -0,0 +1,143 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_MAP_THREE_WAY_COMPARE_H_
+#define CPP2_S21_CONTAINERS_SRC_MAP_THREE_WAY_COMPARE_H_
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+// Holds the Compare object of a tree. A stateless ordering such as std::less
+// is kept as an empty base and adds nothing to the tree's size. Orderings with
+// state, function pointers and final classes are kept as a member
+template <typename Compare,
+          bool = std::is_empty_v<Compare> && !std::is_final_v<Compare>>
+class CompareHolder {
+ public:
+  CompareHolder() : compare_() {}
+  explicit CompareHolder(const Compare& compare) : compare_(compare) {}
+
+  const Compare& keyCompare() const noexcept { return compare_; }
+
+ protected:
+  void swapCompare(CompareHolder& other) {
+    using std::swap;
+    swap(compare_, other.compare_);
+  }
+
+ private:
+  Compare compare_;
+};
+
+template <typename Compare>
+class CompareHolder<Compare, true> : private Compare {
+ public:
+  CompareHolder() = default;
+  explicit CompareHolder(const Compare& compare) : Compare(compare) {}
+
+  const Compare& keyCompare() const noexcept { return *this; }
+
+ protected:
+  void swapCompare(CompareHolder&) noexcept {}
+};
+
+// Three-way comparison of keys under the ordering order: negative when a
+// goes before b, zero for equivalent keys and positive otherwise. kNative
+// tells whether it costs a single comparison. That holds for orderings with a
+// compare(a, b) member returning int and for std::less / std::greater on
+// strings, which use std::basic_string::compare. Other orderings need two
+// calls, so the trees descend with one-sided comparisons for them instead
+template <typename KT, typename Compare, typename = void>
+struct ThreeWayCompare {
+  static constexpr bool kNative = false;
+
+  template <typename L, typename R>
+  static int compare(const Compare& order, const L& a, const R& b) {
+    if (order(a, b)) {
+      return -1;
+    }
+    return order(b, a) ? 1 : 0;
+  }
+};
+
+template <typename KT, typename Compare>
+using MemberCompare = decltype(static_cast<int>(
+    std::declval<const Compare&>().compare(std::declval<const KT&>(),
+                                           std::declval<const KT&>())));
+
+template <typename KT, typename Compare>
+struct ThreeWayCompare<KT, Compare, std::void_t<MemberCompare<KT, Compare>>> {
+  static constexpr bool kNative = true;
+
+  template <typename L, typename R>
+  static int compare(const Compare& order, const L& a, const R& b) {
+    return static_cast<int>(order.compare(a, b));
+  }
+};
+
+template <typename C, typename T, typename A>
+struct ThreeWayCompare<std::basic_string<C, T, A>,
+                       std::less<std::basic_string<C, T, A>>> {
+  static constexpr bool kNative = true;
+
+  static int compare(const std::less<std::basic_string<C, T, A>>&,
+                     const std::basic_string<C, T, A>& a,
+                     const std::basic_string<C, T, A>& b) {
+    return a.compare(b);
+  }
+};
+
+template <typename C, typename T, typename A>
+struct ThreeWayCompare<std::basic_string<C, T, A>,
+                       std::greater<std::basic_string<C, T, A>>> {
+  static constexpr bool kNative = true;
+
+  static int compare(const std::greater<std::basic_string<C, T, A>>&,
+                     const std::basic_string<C, T, A>& a,
+                     const std::basic_string<C, T, A>& b) {
+    return b.compare(a);
+  }
+};
+
+// Transparent string orderings compare through basic_string_view, so a lookup
+// with a string_view or a C string costs one comparison and no allocation
+template <typename C, typename T, typename A>
+struct ThreeWayCompare<std::basic_string<C, T, A>, std::less<>> {
+  static constexpr bool kNative = true;
+
+  template <typename L, typename R>
+  static int compare(const std::less<>&, const L& a, const R& b) {
+    return std::basic_string_view<C, T>(a).compare(
+        std::basic_string_view<C, T>(b));
+  }
+};
+
+template <typename C, typename T, typename A>
+struct ThreeWayCompare<std::basic_string<C, T, A>, std::greater<>> {
+  static constexpr bool kNative = true;
+
+  template <typename L, typename R>
+  static int compare(const std::greater<>&, const L& a, const R& b) {
+    return std::basic_string_view<C, T>(b).compare(
+        std::basic_string_view<C, T>(a));
+  }
+};
+
+// Whether Compare declares is_transparent and so orders keys against values
+// of other types. Containers then take lookup keys of any type K instead of
+// converting them to KT first
+template <typename Compare, typename = void>
+struct IsTransparent : std::false_type {};
+
+template <typename Compare>
+struct IsTransparent<Compare, std::void_t<typename Compare::is_transparent>>
+    : std::true_type {};
+
+template <typename Compare, typename K>
+using EnableTransparent = std::enable_if_t<IsTransparent<Compare>::value, K>;
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_MAP_THREE_WAY_COMPARE_H_
@@ -0,0 +1,103 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_MAP_TREAP_BALANCE_H_
+#define CPP2_S21_CONTAINERS_SRC_MAP_TREAP_BALANCE_H_
+
+#include <cstdint>
+
+namespace s21 {
+
+// Randomized treap balancing policy for BTree. Nodes are kept in heap order of
+// a pseudo-random priority, which gives O(log n) expected height with the
+// simplest rebalancing of all policies. The priority is a hash of the node
+// address, so the node needs no extra storage
+struct TreapBalance {
+  // The priorities of a copied node change with its address, so copies are
+  // rebuilt instead of cloned
+  static constexpr bool kCloneable = false;
+
+  template <typename NodeT>
+  static std::uint64_t priority(const NodeT* node) {
+    // splitmix64 finalizer
+    std::uint64_t hash = reinterpret_cast<std::uintptr_t>(node);
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+  }
+
+  // Rotates the new leaf up while its priority beats the parent's
+  template <typename Tree>
+  static void afterInsert(Tree& tree, typename Tree::node_type* node) {
+    std::uint64_t rank = priority(node);
+    while (node->parent() && priority(node->parent()) < rank) {
+      if (node == node->parent()->left) {
+        tree.rotateRight(node->parent());
+      } else {
+        tree.rotateLeft(node->parent());
+      }
+    }
+  }
+
+  // Only the node moved into the removed position may break the heap order
+  // and only with respect to its children, so it is rotated down
+  template <typename Tree>
+  static void afterRemove(Tree& tree, const typename Tree::Removal& removal) {
+    using node_type = typename Tree::node_type;
+    node_type* node = removal.replacement;
+    if (node == nullptr) {
+      return;
+    }
+    std::uint64_t rank = priority(node);
+    while (true) {
+      node_type* top = node->left;
+      if (node->right &&
+          (top == nullptr || priority(node->right) > priority(top))) {
+        top = node->right;
+      }
+      if (top == nullptr || priority(top) <= rank) {
+        return;
+      }
+      if (top == node->left) {
+        tree.rotateRight(node);
+      } else {
+        tree.rotateLeft(node);
+      }
+    }
+  }
+
+  // Builds the treap of sorted nodes as a Cartesian tree in one pass: each
+  // node takes over the part of the right spine with lower priorities as its
+  // left subtree
+  template <typename Tree>
+  static typename Tree::node_type* build(Tree&,
+                                         typename Tree::node_type** nodes,
+                                         typename Tree::size_type count) {
+    using node_type = typename Tree::node_type;
+    node_type* root = nullptr;
+    node_type* last = nullptr;
+    for (typename Tree::size_type i = 0; i < count; ++i) {
+      node_type* node = nodes[i];
+      std::uint64_t rank = priority(node);
+      node_type* child = nullptr;
+      node_type* top = last;
+      while (top && priority(top) < rank) {
+        child = top;
+        top = top->parent();
+      }
+      node->left = child;
+      if (child) {
+        child->setParent(node);
+      }
+      node->setParent(top);
+      if (top) {
+        top->right = node;
+      } else {
+        root = node;
+      }
+      last = node;
+    }
+    return root;
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_MAP_TREAP_BALANCE_H_
@@ -0,0 +1,204 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_MAP_S21_CONCURRENT_MAP_H_
+#define CPP2_S21_CONTAINERS_SRC_MAP_S21_CONCURRENT_MAP_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+
+#include "s21_map.h"
+
+namespace s21 {
+
+// Map shared between threads, as in ConcurrentMap<int, std::string, 32>. Keys
+// are spread by Hash over Shards independent Maps, each behind its own
+// reader-writer lock, so threads working on different shards never wait for
+// each other and lookups in the same shard run in parallel. Elements are
+// returned by value because a reference would outlive the lock. Ordering holds
+// only within a shard
+template <typename KT, typename VT, std::size_t Shards = 16,
+          typename Balance = RedBlackBalance, typename Compare = std::less<KT>,
+          typename Hash = std::hash<KT>>
+class ConcurrentMap {
+  static_assert(Shards > 0, "ConcurrentMap needs at least one shard");
+
+  using map_type = Map<KT, VT, Balance, Compare>;
+  using size_type = size_t;
+
+ public:
+  ConcurrentMap() = default;
+  ConcurrentMap(const ConcurrentMap &) = delete;
+  ConcurrentMap &operator=(const ConcurrentMap &) = delete;
+
+  std::optional<VT> find(const KT &) const;
+  bool contains(const KT &) const;
+  bool insert(const KT &, const VT &);
+  bool insert_or_assign(const KT &, const VT &);
+  size_type erase(const KT &);
+  void clear();
+  size_type size() const;
+  bool empty() const;
+  template <typename F>
+  void for_each(F f) const;
+
+ private:
+  // One cache line per shard at least, so that taking one shard's lock does
+  // not invalidate its neighbours' lines. Only the lock is mutable, const
+  // methods read the map through its const lookups under a shared lock
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    map_type map;
+  };
+
+  std::array<Shard, Shards> shards_;
+
+  static std::size_t shardIndex(const KT &key);
+  Shard &shardOf(const KT &key);
+  const Shard &shardOf(const KT &key) const;
+};
+
+// The index of the shard a key lives in. The hash is mixed first since
+// std::hash of an integer is the integer itself, which would send runs of keys
+// to one shard
+template <typename KT, typename VT, std::size_t Shards, typename Balance,
+          typename Compare, typename Hash>
+std::size_t ConcurrentMap<KT, VT, Shards, Balance, Compare, Hash>::shardIndex(
+    const KT &key) {
+  std::uint64_t hash =
+      static_cast<std::uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ULL;
+  return (hash >> 32) % Shards;
+}
+
+// The shard a writer changes for key
+template <typename KT, typename VT, std::size_t Shards, typename Balance,
+          typename Compare, typename Hash>
+typename ConcurrentMap<KT, VT, Shards, Balance, Compare, Hash>::Shard &
+ConcurrentMap<KT, VT, Shards, Balance, Compare, Hash>::shardOf(const KT &key) {
+  return shards_[shardIndex(key)];
+}
+
+// The shard a reader looks key up in
+template <typename KT, typename VT, std::size_t Shards, typename Balance,
+          typename Compare, typename Hash>
+const typename ConcurrentMap<KT, VT, Shards, Balance, Compare, Hash>::Shard &
+ConcurrentMap<KT, VT, Shards, Balance, Compare, Hash>::shardOf(
+    const KT &key) const {
+  return shards_[shardIndex(key)];
+}
+
+// Copy of the value stored for key, or nothing when the key is missing
+template <typename KT, typename VT, std::size_t Shards, typename Balance,
+          typename Compare, typename Hash>
+std::optional<VT> ConcurrentMap<KT, VT, Shards, Balance, Compare, Hash>::find(
+    const KT &key) const {
+  const Shard &shard = shardOf(key);
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  auto it = shard.map.find(key);
+  if (it == shard.map.end()) {
+    return std::nullopt;
+  }
+  return it.second();
+}
+
+template <typename KT, typename VT, std::size_t Shards, typename Balance,
+          typename Compare, typename Hash>
+bool ConcurrentMap<KT, VT, Shards, Balance, Compare, Hash>::contains(
+    const KT &key) const {
+  const Shard &shard = shardOf(key);
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  return shard.map.contains(key);
+}
+
+// Inserts the element unless the key is present, returns whether it did
+template <typename KT, typename VT, std::size_t Shards, typename Balance,
+          typename Compare, typename Hash>
+bool ConcurrentMap<KT, VT, Shards, Balance, Compare, Hash>::insert(
+    const KT &key, const VT &value) {
+  Shard &shard = shardOf(key);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  return shard.map.insert(key, value).second;
+}
+
+// Inserts the element or overwrites the value of a present key, returns
+// whether the key was new
+template <typename KT, typename VT, std::size_t Shards, typename Balance,
+          typename Compare, typename Hash>
+bool ConcurrentMap<KT, VT, Shards, Balance, Compare, Hash>::insert_or_assign(
+    const KT &key, const VT &value) {
+  Shard &shard = shardOf(key);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  auto result = shard.map.try_emplace(key, value);
+  if (!result.second) {
+    result.first.second() = value;
+  }
+  return result.second;
+}
+
+// Removes the element with key, returns the number of removed elements
+template <typename KT, typename VT, std::size_t Shards, typename Balance,
+          typename Compare, typename Hash>
+typename ConcurrentMap<KT, VT, Shards, Balance, Compare, Hash>::size_type
+ConcurrentMap<KT, VT, Shards, Balance, Compare, Hash>::erase(const KT &key) {
+  Shard &shard = shardOf(key);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  auto it = shard.map.find(key);
+  if (it == shard.map.end()) {
+    return 0;
+  }
+  shard.map.erase(it);
+  return 1;
+}
+
+// Empties the shards one after another
+template <typename KT, typename VT, std::size_t Shards, typename Balance,
+          typename Compare, typename Hash>
+void ConcurrentMap<KT, VT, Shards, Balance, Compare, Hash>::clear() {
+  for (Shard &shard : shards_) {
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.map.clear();
+  }
+}
+
+// Sum of the shard sizes. Each is read under its lock, but writers may change
+// other shards meanwhile, so under concurrent updates the result is only a
+// snapshot of every shard at a slightly different moment
+template <typename KT, typename VT, std::size_t Shards, typename Balance,
+          typename Compare, typename Hash>
+typename ConcurrentMap<KT, VT, Shards, Balance, Compare, Hash>::size_type
+ConcurrentMap<KT, VT, Shards, Balance, Compare, Hash>::size() const {
+  size_type result = 0;
+  for (const Shard &shard : shards_) {
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    result += shard.map.size();
+  }
+  return result;
+}
+
+template <typename KT, typename VT, std::size_t Shards, typename Balance,
+          typename Compare, typename Hash>
+bool ConcurrentMap<KT, VT, Shards, Balance, Compare, Hash>::empty() const {
+  return size() == 0;
+}
+
+// Calls f(key, value) for every element. A shard is visited in key order
+// under its shared lock, so f sees each shard in a consistent state, but
+// other shards may change between visits. f must not call back into the map
+template <typename KT, typename VT, std::size_t Shards, typename Balance,
+          typename Compare, typename Hash>
+template <typename F>
+void ConcurrentMap<KT, VT, Shards, Balance, Compare, Hash>::for_each(
+    F f) const {
+  for (const Shard &shard : shards_) {
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    for (auto it = shard.map.begin(); it != shard.map.end(); ++it) {
+      f(it.first(), it.second());
+    }
+  }
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_MAP_S21_CONCURRENT_MAP_H_
@@ -0,0 +1,115 @@
+#include "s21_concurrent_map.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(ConcurrentMap, single_thread) {
+  s21::ConcurrentMap<int, std::string, 4> map;
+  ASSERT_TRUE(map.empty());
+  ASSERT_TRUE(map.insert(1, "one"));
+  ASSERT_FALSE(map.insert(1, "uno"));
+  ASSERT_EQ(*map.find(1), "one");
+  ASSERT_FALSE(map.insert_or_assign(1, "uno"));
+  ASSERT_EQ(*map.find(1), "uno");
+  ASSERT_TRUE(map.insert_or_assign(2, "two"));
+  ASSERT_TRUE(map.contains(2));
+  ASSERT_FALSE(map.find(3).has_value());
+  ASSERT_EQ(map.size(), 2U);
+  ASSERT_EQ(map.erase(1), 1U);
+  ASSERT_EQ(map.erase(1), 0U);
+  ASSERT_FALSE(map.contains(1));
+  map.clear();
+  ASSERT_TRUE(map.empty());
+}
+
+TEST(ConcurrentMap, for_each_visits_shards_in_order) {
+  s21::ConcurrentMap<int, int, 8> map;
+  std::map<int, int> expected;
+  for (int i = 0; i < 1000; ++i) {
+    map.insert(i * 7 % 1009, i);
+    expected[i * 7 % 1009] = i;
+  }
+  std::map<int, int> visited;
+  int previous = -1;
+  size_t descents = 0;
+  map.for_each([&](const int &key, const int &value) {
+    if (key < previous) {
+      ++descents;
+    }
+    previous = key;
+    visited[key] = value;
+  });
+  ASSERT_EQ(visited, expected);
+  ASSERT_LT(descents, 8U);
+}
+
+TEST(ConcurrentMap, parallel_writers) {
+  s21::ConcurrentMap<int, int> map;
+  const int threads = 8;
+  const int per_thread = 5000;
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&map, t] {
+      for (int i = 0; i < per_thread; ++i) {
+        map.insert_or_assign(t * per_thread + i, t);
+        if (i % 4 == 0) {
+          map.erase(t * per_thread + i);
+        }
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  ASSERT_EQ(map.size(), static_cast<size_t>(threads * per_thread * 3 / 4));
+  for (int t = 0; t < threads; ++t) {
+    ASSERT_FALSE(map.contains(t * per_thread));
+    ASSERT_EQ(*map.find(t * per_thread + 1), t);
+  }
+}
+
+TEST(ConcurrentMap, readers_during_writes) {
+  s21::ConcurrentMap<int, int, 4> map;
+  for (int i = 0; i < 1000; ++i) {
+    map.insert(i, i);
+  }
+  std::atomic<int> wrong(0);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&] {
+      for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 1000; ++i) {
+          auto value = map.find(i);
+          if (!value || (*value != i && *value != -i)) {
+            ++wrong;
+          }
+        }
+      }
+    });
+  }
+  std::thread writer([&] {
+    for (int round = 0; round < 20; ++round) {
+      for (int i = 0; i < 1000; ++i) {
+        map.insert_or_assign(i, round % 2 ? i : -i);
+        map.insert_or_assign(1000 + i, round);
+        map.erase(1000 + i);
+      }
+    }
+  });
+  writer.join();
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  ASSERT_EQ(wrong, 0);
+  ASSERT_EQ(map.size(), 1000U);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
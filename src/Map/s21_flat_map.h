@@ -0,0 +1,607 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_MAP_S21_FLAT_MAP_H_
+#define CPP2_S21_CONTAINERS_SRC_MAP_S21_FLAT_MAP_H_
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../Vector/s21_vector.h"
+#include "SortedSearch.h"
+#include "ThreeWayCompare.h"
+
+namespace s21 {
+
+// Map kept as two parallel sorted arrays, the keys in one s21::Vector and the
+// values in another, for lookup tables that are built once and read many
+// times. A lookup is a branchless binary search over the keys alone, which
+// are packed densely and touch far fewer cache lines than a tree descent,
+// and there is no per-element allocation. build() loads any number of
+// elements with a single sort. insert and erase shift the arrays in O(n) and
+// invalidate iterators. Keys and values have to be default constructible
+template <typename KT, typename VT, typename Compare = std::less<KT>>
+class FlatMap {
+  using key_type = KT;
+  using mapped_type = VT;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+
+ public:
+  class iterator;
+  using const_iterator = iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  FlatMap();
+  explicit FlatMap(std::initializer_list<value_type> const &items);
+  FlatMap(const FlatMap &other);
+  FlatMap(FlatMap &&other) noexcept;
+  FlatMap &operator=(const FlatMap &other);
+  FlatMap &operator=(FlatMap &&other) noexcept;
+
+  template <typename It>
+  void build(It first, It last);
+
+  VT &at(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  VT &at(const K &key);
+  VT &operator[](const KT &key);
+  iterator find(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  iterator find(const K &key);
+  bool contains(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  bool contains(const K &key);
+  size_type count(const KT &key);
+  iterator lower_bound(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  iterator lower_bound(const K &key);
+  iterator upper_bound(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  iterator upper_bound(const K &key);
+  std::pair<iterator, iterator> equal_range(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  std::pair<iterator, iterator> equal_range(const K &key);
+
+  iterator begin();
+  iterator end();
+  reverse_iterator rbegin();
+  reverse_iterator rend();
+
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+  void reserve(size_type count);
+
+  void clear();
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(const KT &key, const VT &value);
+  std::pair<iterator, bool> insert_or_assign(const KT &key, const VT &value);
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const KT &key, Args &&...args);
+  template <class... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+  void erase(iterator pos);
+  size_type erase(const KT &key);
+  void swap(FlatMap &other);
+  void merge(FlatMap &other);
+
+ private:
+  template <typename K>
+  size_type lowerIndex(const K &key);
+  template <typename K>
+  size_type upperIndex(const K &key);
+  template <typename K>
+  size_type findIndex(const K &key);
+  void insertAt(size_type index, const KT &key, const VT &value);
+
+  Vector<KT> keys_;
+  Vector<VT> values_;
+  Compare compare_;
+};
+
+template <typename KT, typename VT, typename Compare>
+class FlatMap<KT, VT, Compare>::iterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = VT;
+  using difference_type = std::ptrdiff_t;
+  using pointer = VT *;
+  using reference = VT &;
+
+  iterator() : map_(nullptr), index_(0) {}
+  iterator(FlatMap *map, size_type index) : map_(map), index_(index) {}
+
+  iterator &operator++() {
+    ++index_;
+    return *this;
+  }
+
+  iterator operator++(int) {
+    iterator old = *this;
+    ++index_;
+    return old;
+  }
+
+  iterator &operator--() {
+    --index_;
+    return *this;
+  }
+
+  iterator operator--(int) {
+    iterator old = *this;
+    --index_;
+    return old;
+  }
+
+  VT &operator*() const { return map_->values_[index_]; }
+
+  bool operator==(const iterator &other) const {
+    return index_ == other.index_ && map_ == other.map_;
+  }
+
+  bool operator!=(const iterator &other) const { return !(*this == other); }
+
+  const KT &first() const { return map_->keys_[index_]; }
+  VT &second() const { return map_->values_[index_]; }
+
+ private:
+  friend class FlatMap;
+
+  FlatMap *map_;
+  size_type index_;
+};
+
+// Default constructor, creates empty FlatMap
+template <typename KT, typename VT, typename Compare>
+FlatMap<KT, VT, Compare>::FlatMap() : keys_(), values_(), compare_() {}
+
+// Initializer list constructor, built with a single sort. Later duplicates
+// of a key are ignored
+template <typename KT, typename VT, typename Compare>
+FlatMap<KT, VT, Compare>::FlatMap(
+    std::initializer_list<value_type> const &items)
+    : FlatMap() {
+  build(items.begin(), items.end());
+}
+
+// Copy constructor
+template <typename KT, typename VT, typename Compare>
+FlatMap<KT, VT, Compare>::FlatMap(const FlatMap &other)
+    : keys_(other.keys_), values_(other.values_), compare_(other.compare_) {}
+
+// Move constructor
+template <typename KT, typename VT, typename Compare>
+FlatMap<KT, VT, Compare>::FlatMap(FlatMap &&other) noexcept : FlatMap() {
+  swap(other);
+}
+
+// Assignment operator overload for copy object
+template <typename KT, typename VT, typename Compare>
+FlatMap<KT, VT, Compare> &FlatMap<KT, VT, Compare>::operator=(
+    const FlatMap &other) {
+  if (this == &other) return *this;
+  FlatMap tmp(other);
+  swap(tmp);
+  return *this;
+}
+
+// Assignment operator overload for moving object
+template <typename KT, typename VT, typename Compare>
+FlatMap<KT, VT, Compare> &FlatMap<KT, VT, Compare>::operator=(
+    FlatMap &&other) noexcept {
+  if (this == &other) return *this;
+  swap(other);
+  return *this;
+}
+
+// Replaces the contents with the key-value pairs of [first, last). Each pair
+// is copied once, then a stable sort orders their indices, so the elements
+// themselves are only moved once, into the arrays. Input already in key order
+// skips the sort. The first of several equal keys wins, as with repeated
+// insert
+template <typename KT, typename VT, typename Compare>
+template <typename It>
+void FlatMap<KT, VT, Compare>::build(It first, It last) {
+  std::vector<std::pair<KT, VT>> items;
+  for (; first != last; ++first) {
+    items.emplace_back(first->first, first->second);
+  }
+  std::vector<size_type> order(items.size());
+  std::iota(order.begin(), order.end(), size_type{0});
+  auto less = [this, &items](size_type left, size_type right) {
+    return compare_(items[left].first, items[right].first);
+  };
+  if (!std::is_sorted(order.begin(), order.end(), less)) {
+    std::stable_sort(order.begin(), order.end(), less);
+  }
+  auto end = std::unique(
+      order.begin(), order.end(),
+      [&less](size_type left, size_type right) { return !less(left, right); });
+  size_type count = static_cast<size_type>(end - order.begin());
+  Vector<KT> keys(count);
+  Vector<VT> values(count);
+  for (size_type i = 0; i < count; ++i) {
+    keys[i] = std::move(items[order[i]].first);
+    values[i] = std::move(items[order[i]].second);
+  }
+  keys_.swap(keys);
+  values_.swap(values);
+}
+
+// Access specified element with bounds checking
+template <typename KT, typename VT, typename Compare>
+VT &FlatMap<KT, VT, Compare>::at(const KT &key) {
+  size_type index = findIndex(key);
+  if (index == size()) {
+    throw std::out_of_range("s21::FlatMap::at");
+  }
+  return values_[index];
+}
+
+// at for a key of another type under a transparent Compare
+template <typename KT, typename VT, typename Compare>
+template <typename K, typename>
+VT &FlatMap<KT, VT, Compare>::at(const K &key) {
+  size_type index = findIndex(key);
+  if (index == size()) {
+    throw std::out_of_range("s21::FlatMap::at");
+  }
+  return values_[index];
+}
+
+// Access or insert specified element
+template <typename KT, typename VT, typename Compare>
+VT &FlatMap<KT, VT, Compare>::operator[](const KT &key) {
+  size_type index = lowerIndex(key);
+  if (index == size() || compare_(key, keys_[index])) {
+    insertAt(index, key, VT());
+  }
+  return values_[index];
+}
+
+// Find element by key
+template <typename KT, typename VT, typename Compare>
+typename FlatMap<KT, VT, Compare>::iterator FlatMap<KT, VT, Compare>::find(
+    const KT &key) {
+  return iterator(this, findIndex(key));
+}
+
+// Find element by a key of another type under a transparent Compare
+template <typename KT, typename VT, typename Compare>
+template <typename K, typename>
+typename FlatMap<KT, VT, Compare>::iterator FlatMap<KT, VT, Compare>::find(
+    const K &key) {
+  return iterator(this, findIndex(key));
+}
+
+// Checks if there is an element with key equivalent to key in the container
+template <typename KT, typename VT, typename Compare>
+bool FlatMap<KT, VT, Compare>::contains(const KT &key) {
+  return findIndex(key) != size();
+}
+
+// contains for a key of another type under a transparent Compare
+template <typename KT, typename VT, typename Compare>
+template <typename K, typename>
+bool FlatMap<KT, VT, Compare>::contains(const K &key) {
+  return findIndex(key) != size();
+}
+
+// Returns the number of elements with the key, zero or one
+template <typename KT, typename VT, typename Compare>
+typename FlatMap<KT, VT, Compare>::size_type FlatMap<KT, VT, Compare>::count(
+    const KT &key) {
+  return contains(key) ? 1 : 0;
+}
+
+// Returns an iterator to the first element not less than key
+template <typename KT, typename VT, typename Compare>
+typename FlatMap<KT, VT, Compare>::iterator
+FlatMap<KT, VT, Compare>::lower_bound(const KT &key) {
+  return iterator(this, lowerIndex(key));
+}
+
+// lower_bound for a key of another type under a transparent Compare
+template <typename KT, typename VT, typename Compare>
+template <typename K, typename>
+typename FlatMap<KT, VT, Compare>::iterator
+FlatMap<KT, VT, Compare>::lower_bound(const K &key) {
+  return iterator(this, lowerIndex(key));
+}
+
+// Returns an iterator to the first element greater than key
+template <typename KT, typename VT, typename Compare>
+typename FlatMap<KT, VT, Compare>::iterator
+FlatMap<KT, VT, Compare>::upper_bound(const KT &key) {
+  return iterator(this, upperIndex(key));
+}
+
+// upper_bound for a key of another type under a transparent Compare
+template <typename KT, typename VT, typename Compare>
+template <typename K, typename>
+typename FlatMap<KT, VT, Compare>::iterator
+FlatMap<KT, VT, Compare>::upper_bound(const K &key) {
+  return iterator(this, upperIndex(key));
+}
+
+// Returns the range of elements with key, empty or a single one
+template <typename KT, typename VT, typename Compare>
+std::pair<typename FlatMap<KT, VT, Compare>::iterator,
+          typename FlatMap<KT, VT, Compare>::iterator>
+FlatMap<KT, VT, Compare>::equal_range(const KT &key) {
+  size_type index = lowerIndex(key);
+  size_type next = index + (index != size() && !compare_(key, keys_[index]));
+  return {iterator(this, index), iterator(this, next)};
+}
+
+// equal_range for a key of another type under a transparent Compare
+template <typename KT, typename VT, typename Compare>
+template <typename K, typename>
+std::pair<typename FlatMap<KT, VT, Compare>::iterator,
+          typename FlatMap<KT, VT, Compare>::iterator>
+FlatMap<KT, VT, Compare>::equal_range(const K &key) {
+  size_type index = lowerIndex(key);
+  size_type next = index + (index != size() && !compare_(key, keys_[index]));
+  return {iterator(this, index), iterator(this, next)};
+}
+
+// Returns an iterator to the beginning
+template <typename KT, typename VT, typename Compare>
+typename FlatMap<KT, VT, Compare>::iterator FlatMap<KT, VT, Compare>::begin() {
+  return iterator(this, 0);
+}
+
+// Returns an iterator to the end
+template <typename KT, typename VT, typename Compare>
+typename FlatMap<KT, VT, Compare>::iterator FlatMap<KT, VT, Compare>::end() {
+  return iterator(this, size());
+}
+
+// Returns a reverse iterator to the last element
+template <typename KT, typename VT, typename Compare>
+typename FlatMap<KT, VT, Compare>::reverse_iterator
+FlatMap<KT, VT, Compare>::rbegin() {
+  return reverse_iterator(end());
+}
+
+// Returns a reverse iterator before the first element
+template <typename KT, typename VT, typename Compare>
+typename FlatMap<KT, VT, Compare>::reverse_iterator
+FlatMap<KT, VT, Compare>::rend() {
+  return reverse_iterator(begin());
+}
+
+// Checks whether the container is empty
+template <typename KT, typename VT, typename Compare>
+bool FlatMap<KT, VT, Compare>::empty() const noexcept {
+  return keys_.size() == 0;
+}
+
+// Returns the number of elements
+template <typename KT, typename VT, typename Compare>
+typename FlatMap<KT, VT, Compare>::size_type FlatMap<KT, VT, Compare>::size()
+    const noexcept {
+  return keys_.size();
+}
+
+// Returns the maximum possible number of elements
+template <typename KT, typename VT, typename Compare>
+typename FlatMap<KT, VT, Compare>::size_type
+FlatMap<KT, VT, Compare>::max_size() const noexcept {
+  return std::numeric_limits<difference_type>::max() /
+         (sizeof(KT) + sizeof(VT));
+}
+
+// Allocates room for count elements, so inserting up to that many never
+// reallocates
+template <typename KT, typename VT, typename Compare>
+void FlatMap<KT, VT, Compare>::reserve(size_type count) {
+  keys_.reserve(count);
+  values_.reserve(count);
+}
+
+// Clears the contents
+template <typename KT, typename VT, typename Compare>
+void FlatMap<KT, VT, Compare>::clear() {
+  keys_.clear();
+  values_.clear();
+}
+
+// Inserts value and returns iterator to where the element is in the
+// container and bool denoting whether the insertion took place
+template <typename KT, typename VT, typename Compare>
+std::pair<typename FlatMap<KT, VT, Compare>::iterator, bool>
+FlatMap<KT, VT, Compare>::insert(const value_type &value) {
+  return insert(value.first, value.second);
+}
+
+// Inserts value by key unless the key is present, shifting the elements
+// after it
+template <typename KT, typename VT, typename Compare>
+std::pair<typename FlatMap<KT, VT, Compare>::iterator, bool>
+FlatMap<KT, VT, Compare>::insert(const KT &key, const VT &value) {
+  return try_emplace(key, value);
+}
+
+// Inserts an element or assigns to the current one if the key already
+// exists. The bool tells whether the key was new
+template <typename KT, typename VT, typename Compare>
+std::pair<typename FlatMap<KT, VT, Compare>::iterator, bool>
+FlatMap<KT, VT, Compare>::insert_or_assign(const KT &key, const VT &value) {
+  auto result = insert(key, value);
+  if (!result.second) {
+    *result.first = value;
+  }
+  return result;
+}
+
+// Constructs a key-value pair from args and inserts it if the key is missing
+template <typename KT, typename VT, typename Compare>
+template <class... Args>
+std::pair<typename FlatMap<KT, VT, Compare>::iterator, bool>
+FlatMap<KT, VT, Compare>::emplace(Args &&...args) {
+  std::pair<KT, VT> item(std::forward<Args>(args)...);
+  return try_emplace(item.first, std::move(item.second));
+}
+
+// Inserts an element with the value constructed from args if the key is
+// missing, shifting the elements after it. Otherwise nothing is constructed.
+// The value is built before the arrays change, so args may refer to elements
+// of this map
+template <typename KT, typename VT, typename Compare>
+template <class... Args>
+std::pair<typename FlatMap<KT, VT, Compare>::iterator, bool>
+FlatMap<KT, VT, Compare>::try_emplace(const KT &key, Args &&...args) {
+  size_type index = lowerIndex(key);
+  if (index != size() && !compare_(key, keys_[index])) {
+    return {iterator(this, index), false};
+  }
+  VT value(std::forward<Args>(args)...);
+  insertAt(index, key, value);
+  return {iterator(this, index), true};
+}
+
+// Inserts the key-value pairs one by one, as insert does, and returns for
+// each where its key ends up and whether it was new. Every insertion shifts
+// the elements after it, so the iterators are looked up after the last one
+template <typename KT, typename VT, typename Compare>
+template <class... Args>
+std::vector<std::pair<typename FlatMap<KT, VT, Compare>::iterator, bool>>
+FlatMap<KT, VT, Compare>::insert_many(Args &&...args) {
+  std::initializer_list<value_type> items = {
+      value_type(std::forward<Args>(args))...};
+  std::vector<std::pair<iterator, bool>> result;
+  for (const value_type &item : items) {
+    result.push_back(insert(item.first, item.second));
+  }
+  auto position = result.begin();
+  for (const value_type &item : items) {
+    (position++)->first = find(item.first);
+  }
+  return result;
+}
+
+// Removes the element at pos, shifting the elements after it
+template <typename KT, typename VT, typename Compare>
+void FlatMap<KT, VT, Compare>::erase(iterator pos) {
+  std::move(keys_.begin() + pos.index_ + 1, keys_.end(),
+            keys_.begin() + pos.index_);
+  std::move(values_.begin() + pos.index_ + 1, values_.end(),
+            values_.begin() + pos.index_);
+  keys_.pop_back();
+  values_.pop_back();
+}
+
+// Removes the element with key and returns how many were removed
+template <typename KT, typename VT, typename Compare>
+typename FlatMap<KT, VT, Compare>::size_type FlatMap<KT, VT, Compare>::erase(
+    const KT &key) {
+  size_type index = findIndex(key);
+  if (index == size()) {
+    return 0;
+  }
+  erase(iterator(this, index));
+  return 1;
+}
+
+// Swaps the contents
+template <typename KT, typename VT, typename Compare>
+void FlatMap<KT, VT, Compare>::swap(FlatMap &other) {
+  keys_.swap(other.keys_);
+  values_.swap(other.values_);
+  std::swap(compare_, other.compare_);
+}
+
+// Moves the elements of other whose keys are missing here into this map, the
+// rest stays in other. Both arrays are merged in one pass, O(n + m)
+template <typename KT, typename VT, typename Compare>
+void FlatMap<KT, VT, Compare>::merge(FlatMap &other) {
+  if (this == &other) return;
+  size_type total = size() + other.size();
+  Vector<KT> keys(total);
+  Vector<VT> values(total);
+  Vector<KT> keptKeys(other.size());
+  Vector<VT> keptValues(other.size());
+  size_type mine = 0, theirs = 0, added = 0, kept = 0;
+  while (mine != size() || theirs != other.size()) {
+    bool takeMine =
+        theirs == other.size() ||
+        (mine != size() && !compare_(other.keys_[theirs], keys_[mine]));
+    if (takeMine) {
+      if (theirs != other.size() &&
+          !compare_(keys_[mine], other.keys_[theirs])) {
+        keptKeys[kept] = std::move(other.keys_[theirs]);
+        keptValues[kept++] = std::move(other.values_[theirs++]);
+      }
+      keys[added] = std::move(keys_[mine]);
+      values[added++] = std::move(values_[mine++]);
+    } else {
+      keys[added] = std::move(other.keys_[theirs]);
+      values[added++] = std::move(other.values_[theirs++]);
+    }
+  }
+  for (; added != total; --total) {
+    keys.pop_back();
+    values.pop_back();
+  }
+  for (size_type left = other.size(); left != kept; --left) {
+    keptKeys.pop_back();
+    keptValues.pop_back();
+  }
+  keys_.swap(keys);
+  values_.swap(values);
+  other.keys_.swap(keptKeys);
+  other.values_.swap(keptValues);
+}
+
+template <typename KT, typename VT, typename Compare>
+template <typename K>
+typename FlatMap<KT, VT, Compare>::size_type
+FlatMap<KT, VT, Compare>::lowerIndex(const K &key) {
+  return branchlessLowerBound<KT>(keys_.data(), size(), key, compare_) -
+         keys_.data();
+}
+
+template <typename KT, typename VT, typename Compare>
+template <typename K>
+typename FlatMap<KT, VT, Compare>::size_type
+FlatMap<KT, VT, Compare>::upperIndex(const K &key) {
+  return branchlessUpperBound<KT>(keys_.data(), size(), key, compare_) -
+         keys_.data();
+}
+
+// Index of the element with key, or size() if it is missing
+template <typename KT, typename VT, typename Compare>
+template <typename K>
+typename FlatMap<KT, VT, Compare>::size_type
+FlatMap<KT, VT, Compare>::findIndex(const K &key) {
+  size_type index = lowerIndex(key);
+  if (index != size() && compare_(key, keys_[index])) {
+    return size();
+  }
+  return index;
+}
+
+// Appends the element and rotates it into place
+template <typename KT, typename VT, typename Compare>
+void FlatMap<KT, VT, Compare>::insertAt(size_type index, const KT &key,
+                                        const VT &value) {
+  keys_.push_back(key);
+  std::rotate(keys_.begin() + index, keys_.end() - 1, keys_.end());
+  values_.push_back(value);
+  std::rotate(values_.begin() + index, values_.end() - 1, values_.end());
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_MAP_S21_FLAT_MAP_H_
@@ -0,0 +1,190 @@
+#include "s21_flat_map.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST(FlatMap, initializer_list_and_subscript) {
+  // Built with one sort, the first of equal keys wins
+  s21::FlatMap<int, std::string> map{{3, "three"}, {1, "one"}, {3, "drei"}};
+  ASSERT_EQ(map.size(), 2U);
+  ASSERT_EQ(map.at(3), "three");
+  ASSERT_THROW(map.at(2), std::out_of_range);
+  // A missing key is default inserted between its neighbours
+  ASSERT_EQ(map[2], "");
+  std::vector<int> keys;
+  for (auto it = map.rbegin(); it != map.rend(); ++it) {
+    keys.push_back(std::prev(it.base()).first());
+  }
+  ASSERT_EQ(keys, (std::vector<int>{3, 2, 1}));
+}
+
+TEST(FlatMap, copy_and_move_assignment) {
+  s21::FlatMap<std::string, int> map{{"b", 2}, {"a", 1}};
+  s21::FlatMap<std::string, int> copy{{"z", 26}};
+  copy = map;
+  map["c"] = 3;
+  ASSERT_EQ(copy.size(), 2U);
+  ASSERT_EQ(copy.at("a"), 1);
+  ASSERT_FALSE(copy.contains("z"));
+  ASSERT_FALSE(copy.contains("c"));
+  auto &self = copy;
+  copy = self;
+  ASSERT_EQ(copy.at("b"), 2);
+  s21::FlatMap<std::string, int> moved;
+  moved = std::move(map);
+  ASSERT_EQ(moved.size(), 3U);
+  ASSERT_EQ(moved.lower_bound("bb").first(), "c");
+  s21::FlatMap<std::string, int> built(std::move(moved));
+  ASSERT_EQ(built.at("c"), 3);
+}
+
+TEST(FlatMap, insert_copies_own_value_while_growing) {
+  const std::string value(100, 'v');
+  s21::FlatMap<int, std::string> map{{1, value}};
+  for (int key = 2; key < 100; ++key) {
+    ASSERT_TRUE(map.insert(key, map.at(1)).second);
+    ASSERT_EQ(map.at(key), value) << key;
+  }
+  ASSERT_TRUE(map.insert_or_assign(0, map.at(50)).second);
+  ASSERT_EQ(map.at(0), value);
+  ASSERT_TRUE(map.try_emplace(-1, map.at(99)).second);
+  ASSERT_EQ(map.at(-1), value);
+}
+
+TEST(FlatMap, emplace_and_insert_many) {
+  s21::FlatMap<int, std::string> map{{2, "two"}};
+  ASSERT_TRUE(map.emplace(1, "one").second);
+  ASSERT_FALSE(map.emplace(std::make_pair(2, "zwei")).second);
+  auto placed = map.try_emplace(3, 3, 'x');
+  ASSERT_TRUE(placed.second);
+  ASSERT_EQ(*placed.first, "xxx");
+  ASSERT_FALSE(map.try_emplace(3, "three").second);
+  ASSERT_EQ(map.at(3), "xxx");
+  auto results = map.insert_many(std::make_pair(5, "five"),
+                                 std::make_pair(0, "zero"),
+                                 std::make_pair(2, "zwei"),
+                                 std::make_pair(5, "fuenf"));
+  ASSERT_EQ(results.size(), 4U);
+  // Later insertions shift earlier ones, the iterators still point at them
+  ASSERT_TRUE(results[0].second);
+  ASSERT_EQ(results[0].first.first(), 5);
+  ASSERT_EQ(*results[1].first, "zero");
+  ASSERT_FALSE(results[2].second);
+  ASSERT_EQ(*results[2].first, "two");
+  ASSERT_FALSE(results[3].second);
+  ASSERT_EQ(*results[3].first, "five");
+  ASSERT_EQ(map.size(), 5U);
+}
+
+TEST(FlatMap, merge_leaves_present_keys_in_other) {
+  s21::FlatMap<int, int> map;
+  s21::FlatMap<int, int> other;
+  for (int i = 0; i < 30; ++i) {
+    map.insert(i * 2, i);
+    other.insert(i * 3, -i);
+  }
+  // Multiples of six up to 54 are in both
+  map.merge(other);
+  ASSERT_EQ(map.size(), 50U);
+  ASSERT_EQ(other.size(), 10U);
+  int previous = -1;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    ASSERT_LT(previous, it.first());
+    previous = it.first();
+    bool mine = it.first() % 2 == 0 && it.first() < 60;
+    ASSERT_EQ(it.second(), mine ? it.first() / 2 : -it.first() / 3);
+  }
+  for (auto it = other.begin(); it != other.end(); ++it) {
+    ASSERT_EQ(it.first() % 6, 0);
+    ASSERT_EQ(it.second(), -it.first() / 3);
+  }
+  map.merge(map);
+  ASSERT_EQ(map.size(), 50U);
+  s21::FlatMap<int, int> empty;
+  empty.merge(other);
+  ASSERT_EQ(empty.size(), 10U);
+  ASSERT_TRUE(other.empty());
+}
+
+TEST(FlatMap, build_keeps_first_of_equal_keys) {
+  // Even keys in descending order, three times over with different values
+  std::vector<std::pair<int, int>> items;
+  for (int round = 0; round < 3; ++round) {
+    for (int key = 1998; key >= 0; key -= 2) {
+      items.emplace_back(key, round);
+    }
+  }
+  s21::FlatMap<int, int> map;
+  map.insert(-1, -1);
+  map.build(items.begin(), items.end());
+  ASSERT_EQ(map.size(), 1000U);
+  ASSERT_FALSE(map.contains(-1));
+  int expected = 0;
+  for (auto it = map.begin(); it != map.end(); ++it, expected += 2) {
+    ASSERT_EQ(it.first(), expected);
+    ASSERT_EQ(it.second(), 0);
+  }
+  for (int key = -1; key <= 2000; ++key) {
+    auto lower = map.lower_bound(key);
+    ASSERT_EQ(lower == map.end(), key > 1998);
+    if (lower != map.end()) {
+      ASSERT_EQ(lower.first(), key < 0 ? 0 : key + key % 2);
+    }
+    ASSERT_EQ(map.upper_bound(key) == map.end(), key >= 1998);
+  }
+  // Input already in order skips the sort and still keeps the first value
+  std::vector<std::pair<int, int>> sorted{{1, 10}, {1, 11}, {2, 20}, {3, 30},
+                                          {3, 31}, {3, 32}};
+  map.build(sorted.begin(), sorted.end());
+  ASSERT_EQ(map.size(), 3U);
+  ASSERT_EQ(map.at(1), 10);
+  ASSERT_EQ(map.at(3), 30);
+}
+
+TEST(FlatMap, values_follow_shifted_keys) {
+  // Keys land alternately at the front and the back of the arrays
+  s21::FlatMap<int, int, std::greater<int>> map;
+  for (int i = 0; i < 100; ++i) {
+    int key = i % 2 ? 100 - i : i;
+    ASSERT_TRUE(map.insert(key, key * 10).second);
+  }
+  for (int key = 50; key < 100; key += 3) {
+    ASSERT_EQ(map.erase(key), 1U);
+  }
+  map.erase(map.begin());
+  map.erase(map.find(0));
+  map.insert_or_assign(51, -1);
+  int previous = 1000;
+  size_t count = 0;
+  for (auto it = map.begin(); it != map.end(); ++it, ++count) {
+    ASSERT_LT(it.first(), previous);
+    ASSERT_EQ(it.second(), it.first() == 51 ? -1 : it.first() * 10);
+    previous = it.first();
+  }
+  ASSERT_EQ(count, map.size());
+  ASSERT_EQ(map.begin().first(), 97);
+  ASSERT_TRUE(map.lower_bound(0) == map.end());
+  ASSERT_EQ(map.lower_bound(50).first(), 49);
+}
+
+TEST(FlatMap, transparent_lookup) {
+  s21::FlatMap<std::string, int, std::less<>> map{{"alpha", 1},
+                                                  {"beta", 2}};
+  std::string_view key = "beta";
+  ASSERT_EQ(map.at(key), 2);
+  ASSERT_TRUE(map.contains("alpha"));
+  ASSERT_TRUE(map.find(std::string_view("gamma")) == map.end());
+  ASSERT_EQ(map.lower_bound("b").first(), "beta");
+  auto range = map.equal_range(key);
+  ASSERT_EQ(*range.first, 2);
+  ASSERT_TRUE(++range.first == range.second);
+  ASSERT_TRUE(map.equal_range("b").first == map.equal_range("b").second);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
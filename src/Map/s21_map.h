@@ -1,16 +1,22 @@
 #ifndef CPP2_S21_CONTAINERS_SRC_MAP_S21_MAP_H_
 #define CPP2_S21_CONTAINERS_SRC_MAP_S21_MAP_H_
 
+#include <algorithm>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
 #include <limits>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
+#include "BPlusTree.h"
 #include "BTree.h"
 
 namespace s21 {
 
-template <typename KT, typename VT>
+template <typename KT, typename VT, typename Balance = RedBlackBalance,
+          typename Compare = std::less<KT>>
 class Map {
   using difference_type = std::ptrdiff_t;
   using key_type = KT;
@@ -18,230 +24,511 @@ class Map {
   using value_type = std::pair<const key_type, mapped_type>;
   using reference = value_type &;
   using const_reference = const value_type &;
-  using tree_type = s21::BTree<KT, VT>;
+  using tree_type = typename TreeEngine<KT, VT, Balance, Compare>::type;
   using iterator = typename tree_type::iterator;
   using const_iterator = typename tree_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
   using size_type = size_t;
 
  public:
+  using node_type = typename tree_type::node_handle;
+  using insert_return_type = InsertReturn<iterator, node_type>;
+
   Map();
-  explicit Map(std::initializer_list<value_type> const &);
+  explicit Map(const Compare &);
+  explicit Map(std::initializer_list<value_type> const &,
+               const Compare & = Compare());
+  template <typename It>
+  Map(sorted_unique_t, It, It, const Compare & = Compare());
   Map(const Map &);
   Map(Map &&);
-  ~Map();
   Map &operator=(const Map &);
   Map &operator=(Map &&);
   VT &at(const KT &);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  VT &at(const K &);
   iterator find(const KT &);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  iterator find(const K &);
+  const_iterator find(const KT &) const;
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  const_iterator find(const K &) const;
   VT &operator[](const KT &);
+  VT &operator[](KT &&);
   iterator begin();
   iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+  reverse_iterator rbegin();
+  reverse_iterator rend();
   bool empty();
-  size_type size() noexcept;
+  size_type size() const noexcept;
   size_type max_size() const noexcept;
   void clear();
   std::pair<iterator, bool> insert(const value_type &);
+  std::pair<iterator, bool> insert(value_type &&);
   std::pair<iterator, bool> insert(const KT &, const VT &);
   std::pair<iterator, bool> insert_or_assign(const KT &, const VT &);
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const KT &, Args &&...args);
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(KT &&, Args &&...args);
+  insert_return_type insert(node_type &&);
+  node_type extract(iterator);
+  node_type extract(const KT &);
+  template <class... Args>
+  iterator emplace_hint(iterator, Args &&...args);
   void erase(iterator);
   void swap(Map &);
   void merge(Map &);
   bool contains(const KT &);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  bool contains(const K &);
+  bool contains(const KT &) const;
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  bool contains(const K &) const;
+  size_type count(const KT &);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  size_type count(const K &);
+
+  iterator lower_bound(const KT &);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  iterator lower_bound(const K &);
+  iterator upper_bound(const KT &);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  iterator upper_bound(const K &);
+  std::pair<iterator, iterator> equal_range(const KT &);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  std::pair<iterator, iterator> equal_range(const K &);
+
+  iterator nth(size_type);
+  size_type rank(const KT &);
 
   template <class... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args &&...args);
 
  private:
-  s21::BTree<KT, VT> tree_;
+  tree_type tree_;
   size_type size_;
 };
 
 // Default constructor, creates empty Map
-template <typename KT, typename VT>
-Map<KT, VT>::Map() : tree_(), size_(0) {}
+template <typename KT, typename VT, typename Balance, typename Compare>
+Map<KT, VT, Balance, Compare>::Map() : tree_(), size_(0) {}
+
+// Creates an empty Map ordered by compare
+template <typename KT, typename VT, typename Balance, typename Compare>
+Map<KT, VT, Balance, Compare>::Map(const Compare &compare)
+    : tree_(compare), size_(0) {}
 
 // Initializer list constructor,
-// creates the Map initizialized using std::initializer_list
-template <typename KT, typename VT>
-Map<KT, VT>::Map(std::initializer_list<value_type> const &items)
-    : tree_(), size_(0) {
+// creates the Map initizialized using std::initializer_list. A list already
+// in ascending key order is bulk loaded in linear time
+template <typename KT, typename VT, typename Balance, typename Compare>
+Map<KT, VT, Balance, Compare>::Map(
+    std::initializer_list<value_type> const &items, const Compare &compare)
+    : tree_(compare), size_(0) {
+  auto unsorted = std::adjacent_find(
+      items.begin(), items.end(),
+      [&compare](const value_type &left, const value_type &right) {
+        return !compare(left.first, right.first);
+      });
+  if (unsorted == items.end()) {
+    tree_.assignSorted(items.begin(), items.end());
+    size_ = items.size();
+    return;
+  }
   for (auto item : items) {
-    tree_.insert(item.first, item.second);
-    size_++;
+    insert(item);
   }
 }
 
+// Bulk loads [first, last), which has to be in ascending key order without
+// duplicates, in linear time
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename It>
+Map<KT, VT, Balance, Compare>::Map(sorted_unique_t, It first, It last,
+                                   const Compare &compare)
+    : tree_(compare), size_(std::distance(first, last)) {
+  tree_.assignSorted(first, last);
+}
+
 // Copy constructor
-template <typename KT, typename VT>
-Map<KT, VT>::Map(const Map &other) : size_(0) {
-  for (auto it = other.tree_.begin(); it != other.tree_.end(); ++it) {
-    tree_.insert(it.getNode()->key, *it);
-    size_++;
-  }
+template <typename KT, typename VT, typename Balance, typename Compare>
+Map<KT, VT, Balance, Compare>::Map(const Map &other)
+    : tree_(other.tree_.keyCompare()), size_(other.size_) {
+  tree_.assign(other.tree_);
 }
 
 // Move constructor
-template <typename KT, typename VT>
-Map<KT, VT>::Map(Map &&other) : Map() {
+template <typename KT, typename VT, typename Balance, typename Compare>
+Map<KT, VT, Balance, Compare>::Map(Map &&other) : Map() {
   swap(other);
 }
 
-// Destructor
-template <typename KT, typename VT>
-Map<KT, VT>::~Map() {
-  if (size_ > 0 && tree_.getRoot()) {
-    size_ = 0;
-    tree_.destroy(tree_.getRoot());
-  }
-}
-
 // Assignment operator overload for copy object
-template <typename KT, typename VT>
-Map<KT, VT> &Map<KT, VT>::operator=(const Map &m) {
+template <typename KT, typename VT, typename Balance, typename Compare>
+Map<KT, VT, Balance, Compare> &
+Map<KT, VT, Balance, Compare>::operator=(const Map &m) {
   if (this == &m) return *this;
-  for (auto it = m.tree_.begin(); it != m.tree_.end(); ++it) {
-    tree_.insert(it.getNode()->key, *it);
-    size_++;
-  }
+  tree_.assign(m.tree_);
+  size_ = m.size_;
   return *this;
 }
 
 // Assignment operator overload for moving object
-template <typename KT, typename VT>
-Map<KT, VT> &Map<KT, VT>::operator=(Map &&m) {
+template <typename KT, typename VT, typename Balance, typename Compare>
+Map<KT, VT, Balance, Compare> &
+Map<KT, VT, Balance, Compare>::operator=(Map &&m) {
   if (this == &m) return *this;
   swap(m);
+  return *this;
 }
 
 // Access specified element with bounds checking
-template <typename KT, typename VT>
-VT &Map<KT, VT>::at(const KT &key) {
-  return *(tree_.search(key));
+template <typename KT, typename VT, typename Balance, typename Compare>
+VT &Map<KT, VT, Balance, Compare>::at(const KT &key) {
+  VT *value = tree_.search(key);
+  if (value == nullptr) {
+    throw std::out_of_range("s21::Map::at");
+  }
+  return *value;
+}
+
+// at for a key of another type, which Compare has to be transparent for.
+// Looks a std::string key up by std::string_view or const char * without
+// building a temporary std::string
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K, typename>
+VT &Map<KT, VT, Balance, Compare>::at(const K &key) {
+  VT *value = tree_.search(key);
+  if (value == nullptr) {
+    throw std::out_of_range("s21::Map::at");
+  }
+  return *value;
 }
 
 // Find node by key
-template <typename KT, typename VT>
-typename Map<KT, VT>::iterator Map<KT, VT>::find(const KT &key) {
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename Map<KT, VT, Balance, Compare>::iterator
+Map<KT, VT, Balance, Compare>::find(const KT &key) {
+  return tree_.searchNode(key);
+}
+
+// Find node by a key of another type under a transparent Compare
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K, typename>
+typename Map<KT, VT, Balance, Compare>::iterator
+Map<KT, VT, Balance, Compare>::find(const K &key) {
+  return tree_.searchNode(key);
+}
+
+// Find node by key without the right to modify the element
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename Map<KT, VT, Balance, Compare>::const_iterator
+Map<KT, VT, Balance, Compare>::find(const KT &key) const {
   return tree_.searchNode(key);
 }
 
-// Access or insert specified element
-template <typename KT, typename VT>
-VT &Map<KT, VT>::operator[](const KT &key) {
-  VT *result = tree_.search(key);
-  if (result == nullptr) {
-    insert(key, VT());
-    result = &operator[](key);
+// const find for a key of another type under a transparent Compare
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K, typename>
+typename Map<KT, VT, Balance, Compare>::const_iterator
+Map<KT, VT, Balance, Compare>::find(const K &key) const {
+  return tree_.searchNode(key);
+}
+
+// Access or insert specified element, in one descent
+template <typename KT, typename VT, typename Balance, typename Compare>
+VT &Map<KT, VT, Balance, Compare>::operator[](const KT &key) {
+  auto result = tree_.emplaceUnique(key);
+  if (result.second) {
+    size_++;
+  }
+  return result.first.second();
+}
+
+// Like operator[] for a temporary key, which is moved into the new element
+template <typename KT, typename VT, typename Balance, typename Compare>
+VT &Map<KT, VT, Balance, Compare>::operator[](KT &&key) {
+  auto result = tree_.emplaceUnique(std::move(key));
+  if (result.second) {
+    size_++;
   }
-  return *result;
+  return result.first.second();
 }
 
 // Returns an iterator to the beginning
-template <typename KT, typename VT>
-typename s21::Map<KT, VT>::iterator s21::Map<KT, VT>::begin() {
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename s21::Map<KT, VT, Balance, Compare>::iterator
+s21::Map<KT, VT, Balance, Compare>::begin() {
   return tree_.begin();
 }
 
 // Returns an iterator to the end
-template <typename KT, typename VT>
-typename s21::Map<KT, VT>::iterator s21::Map<KT, VT>::end() {
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename s21::Map<KT, VT, Balance, Compare>::iterator
+s21::Map<KT, VT, Balance, Compare>::end() {
+  return tree_.end();
+}
+
+// Returns a read-only iterator to the beginning
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename s21::Map<KT, VT, Balance, Compare>::const_iterator
+s21::Map<KT, VT, Balance, Compare>::begin() const {
+  return tree_.begin();
+}
+
+// Returns a read-only iterator to the end
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename s21::Map<KT, VT, Balance, Compare>::const_iterator
+s21::Map<KT, VT, Balance, Compare>::end() const {
   return tree_.end();
 }
 
+// Returns a reverse iterator to the last element
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename s21::Map<KT, VT, Balance, Compare>::reverse_iterator
+s21::Map<KT, VT, Balance, Compare>::rbegin() {
+  return reverse_iterator(end());
+}
+
+// Returns a reverse iterator before the first element
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename s21::Map<KT, VT, Balance, Compare>::reverse_iterator
+s21::Map<KT, VT, Balance, Compare>::rend() {
+  return reverse_iterator(begin());
+}
+
 // Checks whether the container is empty
-template <typename KT, typename VT>
-bool s21::Map<KT, VT>::empty() {
+template <typename KT, typename VT, typename Balance, typename Compare>
+bool s21::Map<KT, VT, Balance, Compare>::empty() {
   return size_ == 0;
 }
 
 // Returns the number of elements
-template <typename KT, typename VT>
-typename s21::Map<KT, VT>::size_type s21::Map<KT, VT>::size() noexcept {
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename s21::Map<KT, VT, Balance, Compare>::size_type
+s21::Map<KT, VT, Balance, Compare>::size() const noexcept {
   return size_;
 }
 
 // Returns the maximum possible number of elements
-template <typename KT, typename VT>
-typename s21::Map<KT, VT>::size_type s21::Map<KT, VT>::max_size()
-    const noexcept {
-  return std::numeric_limits<difference_type>::max() / (sizeof(Node<KT, VT>));
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename s21::Map<KT, VT, Balance, Compare>::size_type
+s21::Map<KT, VT, Balance, Compare>::max_size() const noexcept {
+  return std::numeric_limits<difference_type>::max() /
+         sizeof(typename tree_type::node_type);
 }
 
 // Clears the contents
-template <typename KT, typename VT>
-void s21::Map<KT, VT>::clear() {
-  tree_.destroy(tree_.getRoot());
+template <typename KT, typename VT, typename Balance, typename Compare>
+void s21::Map<KT, VT, Balance, Compare>::clear() {
+  tree_.clear();
   size_ = 0;
 }
 
 // Inserts node and returns iterator to where the element is in the container
 // and bool denoting whether the insertion took place
-template <typename KT, typename VT>
-std::pair<typename Map<KT, VT>::iterator, bool> s21::Map<KT, VT>::insert(
-    const value_type &v) {
+template <typename KT, typename VT, typename Balance, typename Compare>
+std::pair<typename Map<KT, VT, Balance, Compare>::iterator, bool>
+s21::Map<KT, VT, Balance, Compare>::insert(const value_type &v) {
   return insert(v.first, v.second);
 }
 
+// Inserts a temporary element, moving its value into the node. The key of a
+// value_type is const and still gets copied
+template <typename KT, typename VT, typename Balance, typename Compare>
+std::pair<typename Map<KT, VT, Balance, Compare>::iterator, bool>
+s21::Map<KT, VT, Balance, Compare>::insert(value_type &&v) {
+  return try_emplace(v.first, std::move(v.second));
+}
+
 // Inserts value by key and returns iterator to where the element is in the
-// container and bool denoting whether the insertion took place
-template <typename KT, typename VT>
-std::pair<typename Map<KT, VT>::iterator, bool> s21::Map<KT, VT>::insert(
-    const KT &key, const VT &value) {
-  if (tree_.search(key) || size_ >= max_size()) {
-    return std::pair<iterator, bool>{nullptr, false};
-  }
-  auto it = tree_.insert(key, value);
-  size_++;
-  return std::pair<iterator, bool>{it, true};
+// container and bool denoting whether the insertion took place. The key is
+// looked up and linked in one descent
+template <typename KT, typename VT, typename Balance, typename Compare>
+std::pair<typename Map<KT, VT, Balance, Compare>::iterator, bool>
+s21::Map<KT, VT, Balance, Compare>::insert(const KT &key, const VT &value) {
+  return try_emplace(key, value);
 }
 
 // Inserts an element or assigns to the current element if the key already
 // exists
-template <typename KT, typename VT>
-std::pair<typename Map<KT, VT>::iterator, bool>
-s21::Map<KT, VT>::insert_or_assign(const KT &key, const VT &value) {
-  auto it = tree_.searchNode(key);
-  if (it.getNode() != nullptr) {
-    (*this)[key] = value;
-    return std::pair<iterator, bool>{it, true};
+template <typename KT, typename VT, typename Balance, typename Compare>
+std::pair<typename Map<KT, VT, Balance, Compare>::iterator, bool>
+s21::Map<KT, VT, Balance, Compare>::insert_or_assign(const KT &key,
+                                                     const VT &value) {
+  auto result = insert(key, value);
+  if (!result.second && result.first != tree_.end()) {
+    result.first.second() = value;
+    result.second = true;
   }
-  return insert(key, value);
+  return result;
+}
+
+// Constructs an element from args and inserts it if the key is missing. The
+// key and the value are moved into the node, not copied
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <class... Args>
+std::pair<typename Map<KT, VT, Balance, Compare>::iterator, bool>
+s21::Map<KT, VT, Balance, Compare>::emplace(Args &&...args) {
+  std::pair<KT, VT> item(std::forward<Args>(args)...);
+  return try_emplace(std::move(item.first), std::move(item.second));
+}
+
+// Inserts an element with the value constructed from args right inside the
+// node if the key is missing. Otherwise nothing is constructed and args are
+// left untouched
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <class... Args>
+std::pair<typename Map<KT, VT, Balance, Compare>::iterator, bool>
+s21::Map<KT, VT, Balance, Compare>::try_emplace(const KT &key,
+                                                Args &&...args) {
+  if (size_ >= max_size()) {
+    return std::pair<iterator, bool>{tree_.end(), false};
+  }
+  auto result = tree_.emplaceUnique(key, std::forward<Args>(args)...);
+  if (result.second) {
+    size_++;
+  }
+  return result;
+}
+
+// Like try_emplace, but a new element takes the key by move
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <class... Args>
+std::pair<typename Map<KT, VT, Balance, Compare>::iterator, bool>
+s21::Map<KT, VT, Balance, Compare>::try_emplace(KT &&key, Args &&...args) {
+  if (size_ >= max_size()) {
+    return std::pair<iterator, bool>{tree_.end(), false};
+  }
+  auto result =
+      tree_.emplaceUnique(std::move(key), std::forward<Args>(args)...);
+  if (result.second) {
+    size_++;
+  }
+  return result;
+}
+
+// Like emplace, but tries to place the element right before or after hint
+// first, which makes inserting keys in order amortized O(1) when the previous
+// result or end() is passed as hint
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <class... Args>
+typename Map<KT, VT, Balance, Compare>::iterator
+s21::Map<KT, VT, Balance, Compare>::emplace_hint(iterator hint,
+                                                 Args &&...args) {
+  std::pair<KT, VT> item(std::forward<Args>(args)...);
+  auto result =
+      tree_.emplaceHint(hint, std::move(item.first), std::move(item.second));
+  if (result.second) {
+    size_++;
+  }
+  return result.first;
+}
+
+// Inserts the node owned by the handle if its key is missing. The node is
+// relinked, so the element is neither copied nor moved
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename s21::Map<KT, VT, Balance, Compare>::insert_return_type
+s21::Map<KT, VT, Balance, Compare>::insert(node_type &&node) {
+  auto result = tree_.insertUnique(node);
+  if (result.second) {
+    size_++;
+  }
+  return {result.first, result.second, std::move(node)};
+}
+
+// Unlinks the element at pos and hands its node over to the caller
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename s21::Map<KT, VT, Balance, Compare>::node_type
+s21::Map<KT, VT, Balance, Compare>::extract(iterator pos) {
+  node_type node = tree_.extract(pos);
+  if (node) {
+    size_--;
+  }
+  return node;
+}
+
+// Unlinks the element with the key if there is one
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename s21::Map<KT, VT, Balance, Compare>::node_type
+s21::Map<KT, VT, Balance, Compare>::extract(const KT &key) {
+  return extract(find(key));
 }
 
 // Erases element at pos
-template <typename KT, typename VT>
-void s21::Map<KT, VT>::erase(iterator pos) {
-  auto node = pos.getNode();
-  tree_.removeNode(node, node->key);
+template <typename KT, typename VT, typename Balance, typename Compare>
+void s21::Map<KT, VT, Balance, Compare>::erase(iterator pos) {
+  tree_.erase(pos);
   size_--;
 }
 
 // Swaps the contents
-template <typename KT, typename VT>
-void s21::Map<KT, VT>::swap(Map &other) {
+template <typename KT, typename VT, typename Balance, typename Compare>
+void s21::Map<KT, VT, Balance, Compare>::swap(Map &other) {
   using std::swap;
   swap(size_, other.size_);
   swap(tree_, other.tree_);
 }
 
-// Splices nodes from another container
-template <typename KT, typename VT>
-void s21::Map<KT, VT>::merge(Map &other) {
-  for (auto it = other.tree_.begin(); it != other.tree_.end(); ++it) {
-    insert(it.getNode()->key, *it);
-  }
+// Splices nodes from another container. Elements whose keys are missing here
+// are relinked from other without copies, the rest stays in other
+template <typename KT, typename VT, typename Balance, typename Compare>
+void s21::Map<KT, VT, Balance, Compare>::merge(Map &other) {
+  size_type moved = tree_.mergeUnique(other.tree_);
+  size_ += moved;
+  other.size_ -= moved;
 }
 
 // Checks if there is an element with key equivalent to key in the container
-template <typename KT, typename VT>
-bool s21::Map<KT, VT>::contains(const KT &key) {
+template <typename KT, typename VT, typename Balance, typename Compare>
+bool s21::Map<KT, VT, Balance, Compare>::contains(const KT &key) {
   return (tree_.search(key) != nullptr);
 }
 
-template <typename KT, typename VT>
+// contains for a key of another type under a transparent Compare
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K, typename>
+bool s21::Map<KT, VT, Balance, Compare>::contains(const K &key) {
+  return (tree_.search(key) != nullptr);
+}
+
+// contains on a map that may not be modified
+template <typename KT, typename VT, typename Balance, typename Compare>
+bool s21::Map<KT, VT, Balance, Compare>::contains(const KT &key) const {
+  return find(key) != end();
+}
+
+// const contains for a key of another type under a transparent Compare
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K, typename>
+bool s21::Map<KT, VT, Balance, Compare>::contains(const K &key) const {
+  return find(key) != end();
+}
+
+// Returns the number of elements with key equivalent to key, 0 or 1
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename s21::Map<KT, VT, Balance, Compare>::size_type
+s21::Map<KT, VT, Balance, Compare>::count(const KT &key) {
+  return contains(key) ? 1 : 0;
+}
+
+// count for a key of another type under a transparent Compare
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K, typename>
+typename s21::Map<KT, VT, Balance, Compare>::size_type
+s21::Map<KT, VT, Balance, Compare>::count(const K &key) {
+  return contains(key) ? 1 : 0;
+}
+
+template <typename KT, typename VT, typename Balance, typename Compare>
 template <class... Args>
-std::vector<std::pair<typename Map<KT, VT>::iterator, bool>>
-s21::Map<KT, VT>::insert_many(Args &&...args) {
+std::vector<std::pair<typename Map<KT, VT, Balance, Compare>::iterator, bool>>
+s21::Map<KT, VT, Balance, Compare>::insert_many(Args &&...args) {
   std::vector<std::pair<iterator, bool>> result;
   for (auto &val : {args...}) {
     result.push_back(insert(val.first, val.second));
@@ -249,6 +536,71 @@ s21::Map<KT, VT>::insert_many(Args &&...args) {
   return result;
 }
 
+// Returns an iterator to the first element not less than key, in O(log n)
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename s21::Map<KT, VT, Balance, Compare>::iterator
+s21::Map<KT, VT, Balance, Compare>::lower_bound(const KT &key) {
+  return tree_.lowerBound(key);
+}
+
+// lower_bound for a key of another type under a transparent Compare
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K, typename>
+typename s21::Map<KT, VT, Balance, Compare>::iterator
+s21::Map<KT, VT, Balance, Compare>::lower_bound(const K &key) {
+  return tree_.lowerBound(key);
+}
+
+// Returns an iterator to the first element greater than key, in O(log n)
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename s21::Map<KT, VT, Balance, Compare>::iterator
+s21::Map<KT, VT, Balance, Compare>::upper_bound(const KT &key) {
+  return tree_.upperBound(key);
+}
+
+// upper_bound for a key of another type under a transparent Compare
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K, typename>
+typename s21::Map<KT, VT, Balance, Compare>::iterator
+s21::Map<KT, VT, Balance, Compare>::upper_bound(const K &key) {
+  return tree_.upperBound(key);
+}
+
+// Returns the range of the element with key equivalent to key, empty when
+// there is none
+template <typename KT, typename VT, typename Balance, typename Compare>
+std::pair<typename s21::Map<KT, VT, Balance, Compare>::iterator,
+          typename s21::Map<KT, VT, Balance, Compare>::iterator>
+s21::Map<KT, VT, Balance, Compare>::equal_range(const KT &key) {
+  return tree_.equalRange(key);
+}
+
+// equal_range for a key of another type under a transparent Compare
+template <typename KT, typename VT, typename Balance, typename Compare>
+template <typename K, typename>
+std::pair<typename s21::Map<KT, VT, Balance, Compare>::iterator,
+          typename s21::Map<KT, VT, Balance, Compare>::iterator>
+s21::Map<KT, VT, Balance, Compare>::equal_range(const K &key) {
+  return tree_.equalRange(key);
+}
+
+// Returns the element with index elements before it in key order, or end().
+// O(log n) with an OrderStatistic balancing policy
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename s21::Map<KT, VT, Balance, Compare>::iterator
+s21::Map<KT, VT, Balance, Compare>::nth(size_type index) {
+  return tree_.nth(index);
+}
+
+// Returns the number of elements with a key less than key, which is the index
+// of key in key order when it is present. O(log n) with an OrderStatistic
+// balancing policy
+template <typename KT, typename VT, typename Balance, typename Compare>
+typename s21::Map<KT, VT, Balance, Compare>::size_type
+s21::Map<KT, VT, Balance, Compare>::rank(const KT &key) {
+  return tree_.rank(key);
+}
+
 }  // namespace s21
 
 #endif  // CPP2_S21_CONTAINERS_SRC_MAP_S21_MAP_H_
@@ -0,0 +1,842 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_concurrent_map.h"
+#include "s21_flat_map.h"
+#include "s21_map.h"
+#include "s21_mapped_map.h"
+#include "s21_persistent_map.h"
+#include "s21_radix_map.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Monotonically increasing keys, the worst case for an unbalanced tree
+void sortedInsert(int count) {
+  auto start = Clock::now();
+  s21::Map<int, int> s21_map;
+  for (int i = 0; i < count; ++i) {
+    s21_map.insert(i, i);
+  }
+  double s21_insert = secondsSince(start);
+  start = Clock::now();
+  long long found = 0;
+  for (int i = 0; i < count; ++i) {
+    found += s21_map.contains(i);
+  }
+  double s21_find = secondsSince(start);
+
+  start = Clock::now();
+  std::map<int, int> std_map;
+  for (int i = 0; i < count; ++i) {
+    std_map.insert(std::make_pair(i, i));
+  }
+  double std_insert = secondsSince(start);
+  start = Clock::now();
+  for (int i = 0; i < count; ++i) {
+    found += std_map.count(i);
+  }
+  double std_find = secondsSince(start);
+
+  std::printf("sorted_insert n=%d\n", count);
+  std::printf("  s21::Map insert %.3fs find %.3fs\n", s21_insert, s21_find);
+  std::printf("  std::map insert %.3fs find %.3fs\n", std_insert, std_find);
+  std::printf("  found %lld\n", found);
+}
+
+// Mean number of nodes visited by a successful lookup
+template <typename Tree>
+double meanDepth(const Tree &tree, int count) {
+  double total = 0;
+  for (auto it = tree.begin(); it != tree.end(); ++it) {
+    for (auto node = it.getNode(); node; node = node->parent()) {
+      total += 1;
+    }
+  }
+  return count > 0 ? total / count : 0;
+}
+
+template <typename Balance>
+void policy(const char *name, const std::vector<int> &keys) {
+  s21::BTree<int, int, Balance> tree;
+  auto start = Clock::now();
+  for (int key : keys) {
+    tree.insert(key, key);
+  }
+  double insert = secondsSince(start);
+  start = Clock::now();
+  long long found = 0;
+  for (int key : keys) {
+    found += tree.search(key) != nullptr;
+  }
+  double find = secondsSince(start);
+  std::printf("  %-9s insert %.3fs find %.3fs height %zu depth %.2f "
+              "rotations %zu found %lld\n",
+              name, insert, find, tree.height(),
+              meanDepth(tree, static_cast<int>(keys.size())),
+              tree.rotations(), found);
+}
+
+// Lookup depth and rotation count of every balancing policy
+void policies(int count) {
+  std::vector<int> keys(count);
+  for (int i = 0; i < count; ++i) {
+    keys[i] = i;
+  }
+  std::printf("policies sorted n=%d\n", count);
+  policy<s21::RedBlackBalance>("red-black", keys);
+  policy<s21::AvlBalance>("avl", keys);
+  policy<s21::TreapBalance>("treap", keys);
+  std::mt19937 random(42);
+  std::shuffle(keys.begin(), keys.end(), random);
+  std::printf("policies random n=%d\n", count);
+  policy<s21::NoBalance>("none", keys);
+  policy<s21::RedBlackBalance>("red-black", keys);
+  policy<s21::AvlBalance>("avl", keys);
+  policy<s21::TreapBalance>("treap", keys);
+}
+
+template <typename MapT>
+void layout(const char *name, const std::vector<int> &keys,
+            const std::vector<int> &probes) {
+  MapT map;
+  auto start = Clock::now();
+  for (int key : keys) {
+    map.insert(key, key);
+  }
+  double insert = secondsSince(start);
+  start = Clock::now();
+  long long found = 0;
+  for (int key : probes) {
+    found += map.contains(key);
+  }
+  double find = secondsSince(start);
+  start = Clock::now();
+  long long sum = 0;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    sum += *it;
+  }
+  double scan = secondsSince(start);
+  std::printf("  %-9s insert %.3fs find %.3fs scan %.3fs (%lld %lld)\n", name,
+              insert, find, scan, found, sum);
+}
+
+// Binary red-black tree against the B+-tree layout on random keys
+void bPlus(int count) {
+  std::mt19937 random(7);
+  std::vector<int> keys(count);
+  std::vector<int> probes(count);
+  for (int i = 0; i < count; ++i) {
+    keys[i] = static_cast<int>(random());
+  }
+  for (int i = 0; i < count; ++i) {
+    probes[i] = keys[random() % count];
+  }
+  std::printf("b_plus random n=%d\n", count);
+  layout<s21::Map<int, int>>("red-black", keys, probes);
+  layout<s21::Map<int, int, s21::BPlusLayout<128>>>("b+ 128", keys, probes);
+  layout<s21::Map<int, int, s21::BPlusLayout<256>>>("b+ 256", keys, probes);
+  layout<s21::Map<int, int, s21::BPlusLayout<512>>>("b+ 512", keys, probes);
+}
+
+template <typename MapT>
+void copyOne(const char *name, const MapT &map) {
+  auto start = Clock::now();
+  MapT copy(map);
+  double seconds = secondsSince(start);
+  std::printf("  %-9s copy %.3fs size %zu\n", name, seconds, copy.size());
+}
+
+// Copy of a map filled in key order, which is bulk loaded
+void copy(int count) {
+  std::vector<std::pair<int, int>> items(count);
+  for (int i = 0; i < count; ++i) {
+    items[i] = {i, i};
+  }
+  std::printf("copy n=%d\n", count);
+  copyOne("red-black",
+          s21::Map<int, int>(s21::sorted_unique, items.begin(), items.end()));
+  copyOne("avl", s21::Map<int, int, s21::AvlBalance>(
+                     s21::sorted_unique, items.begin(), items.end()));
+  copyOne("treap", s21::Map<int, int, s21::TreapBalance>(
+                       s21::sorted_unique, items.begin(), items.end()));
+  copyOne("b+ 256", s21::Map<int, int, s21::BPlusLayout<256>>(
+                        s21::sorted_unique, items.begin(), items.end()));
+  auto start = Clock::now();
+  std::map<int, int> std_map(items.begin(), items.end());
+  double build = secondsSince(start);
+  start = Clock::now();
+  std::map<int, int> std_copy(std_map);
+  std::printf("  std::map  copy %.3fs size %zu (range build %.3fs)\n",
+              secondsSince(start), std_copy.size(), build);
+}
+
+template <typename MapT>
+void hintOne(const char *name, int count) {
+  MapT hinted;
+  auto start = Clock::now();
+  for (int i = 0; i < count; ++i) {
+    hinted.emplace_hint(hinted.end(), i, i);
+  }
+  double hint = secondsSince(start);
+  MapT plain;
+  start = Clock::now();
+  for (int i = 0; i < count; ++i) {
+    plain.emplace(i, i);
+  }
+  double insert = secondsSince(start);
+  MapT counters;
+  start = Clock::now();
+  for (int i = 0; i < count; ++i) {
+    ++counters[i % 1024];
+  }
+  double counter = secondsSince(start);
+  std::printf("  %-9s emplace_hint(end) %.3fs emplace %.3fs counters %.3fs\n",
+              name, hint, insert, counter);
+}
+
+// Appending sorted keys with a hint against emplace, and operator[]
+// counter aggregation
+void hint(int count) {
+  std::printf("hint n=%d\n", count);
+  hintOne<s21::Map<int, int>>("red-black", count);
+  hintOne<s21::Map<int, int, s21::AvlBalance>>("avl", count);
+  hintOne<s21::Map<int, int, s21::BPlusLayout<256>>>("b+ 256", count);
+  hintOne<std::map<int, int>>("std::map", count);
+}
+
+long long comparisons = 0;
+
+// std::string ordering that counts its calls, two per level on a plain
+// less-than descent
+struct CountingLess {
+  bool operator()(const std::string &left, const std::string &right) const {
+    ++comparisons;
+    return left < right;
+  }
+};
+
+// The same ordering exposing a three-way compare member
+struct CountingThreeWay {
+  int compare(const std::string &left, const std::string &right) const {
+    ++comparisons;
+    return left.compare(right);
+  }
+  bool operator()(const std::string &left, const std::string &right) const {
+    return compare(left, right) < 0;
+  }
+};
+
+template <typename MapT>
+void compareOne(const char *name, const std::vector<std::string> &keys) {
+  MapT map;
+  comparisons = 0;
+  auto start = Clock::now();
+  for (const std::string &key : keys) {
+    map.emplace(key, 0);
+  }
+  double insert = secondsSince(start);
+  long long insert_comparisons = comparisons;
+  comparisons = 0;
+  start = Clock::now();
+  long long found = 0;
+  for (const std::string &key : keys) {
+    found += map.find(key) != map.end();
+  }
+  double find = secondsSince(start);
+  double count = static_cast<double>(keys.size());
+  std::printf("  %-15s insert %.3fs (%.1f cmp/op) find %.3fs (%.1f cmp/op) "
+              "found %lld\n",
+              name, insert, insert_comparisons / count, find,
+              comparisons / count, found);
+}
+
+// Comparator calls per operation on std::string keys sharing a long prefix
+void compare(int count) {
+  std::mt19937 random(3);
+  std::vector<std::string> keys(count);
+  for (int i = 0; i < count; ++i) {
+    keys[i] = "/var/lib/containers/" + std::to_string(random());
+  }
+  std::printf("compare std::string n=%d\n", count);
+  compareOne<s21::Map<std::string, int, s21::RedBlackBalance, CountingLess>>(
+      "less", keys);
+  compareOne<
+      s21::Map<std::string, int, s21::RedBlackBalance, CountingThreeWay>>(
+      "three-way", keys);
+  compareOne<
+      s21::Map<std::string, int, s21::BPlusLayout<256>, CountingThreeWay>>(
+      "b+ 256 compare", keys);
+  compareOne<std::map<std::string, int, CountingLess>>("std::map less",
+                                                       keys);
+}
+
+template <typename MapT, typename Key>
+void routeOne(const char *name, const std::vector<std::string> &routes,
+              const std::vector<std::string_view> &requests) {
+  MapT map;
+  for (size_t i = 0; i < routes.size(); ++i) {
+    map.emplace(routes[i], static_cast<int>(i));
+  }
+  auto start = Clock::now();
+  long long sum = 0;
+  for (std::string_view request : requests) {
+    auto it = map.find(Key(request));
+    sum += it != map.end();
+  }
+  std::printf("  %-22s find %.3fs found %lld\n", name, secondsSince(start),
+              sum);
+}
+
+// Route table lookups by std::string_view, which a std::less<KT> map has to
+// turn into a temporary std::string first
+void transparent(int count) {
+  std::mt19937 random(9);
+  std::vector<std::string> routes(count / 16 + 1);
+  for (size_t i = 0; i < routes.size(); ++i) {
+    routes[i] = "/api/v2/service/" + std::to_string(random()) + "/handler";
+  }
+  std::vector<std::string_view> requests(count);
+  for (int i = 0; i < count; ++i) {
+    requests[i] = routes[random() % routes.size()];
+  }
+  std::printf("transparent routes=%zu lookups=%d\n", routes.size(), count);
+  routeOne<s21::Map<std::string, int>, std::string>("std::less<KT> + string",
+                                                    routes, requests);
+  routeOne<s21::Map<std::string, int, s21::RedBlackBalance, std::less<>>,
+           std::string_view>("std::less<> + view", routes, requests);
+  routeOne<std::map<std::string, int, std::less<>>, std::string_view>(
+      "std::map less<> + view", routes, requests);
+}
+
+template <typename MapT>
+void percentileOne(const char *name, const std::vector<int> &keys,
+                   int queries) {
+  MapT map;
+  auto start = Clock::now();
+  for (int key : keys) {
+    map.insert(key, key);
+  }
+  double insert = secondsSince(start);
+  start = Clock::now();
+  long long sum = 0;
+  for (int i = 0; i < queries; ++i) {
+    sum += map.nth(map.size() * (i % 100) / 100).first();
+    sum += map.rank(keys[i % keys.size()]);
+  }
+  std::printf("  %-22s insert %.3fs %d nth+rank %.3fs (%lld)\n", name, insert,
+              queries, secondsSince(start), sum);
+}
+
+// Percentile queries on a latency histogram with and without subtree sizes
+void orderStatistic(int count) {
+  std::mt19937 random(13);
+  std::vector<int> keys(count);
+  for (int i = 0; i < count; ++i) {
+    keys[i] = static_cast<int>(random() % 1000000);
+  }
+  std::printf("order_statistic n=%d\n", count);
+  percentileOne<s21::Map<int, int, s21::OrderStatistic<s21::RedBlackBalance>>>(
+      "red-black + statistic", keys, 1000000);
+  percentileOne<s21::Map<int, int>>("red-black walk", keys, 10);
+}
+
+template <typename MapT>
+void rangeOne(const char *name, int count, int windows) {
+  MapT map;
+  for (int i = 0; i < count; ++i) {
+    map.emplace_hint(map.end(), i * 10, i);
+  }
+  auto start = Clock::now();
+  long long sum = 0;
+  for (int i = 0; i < windows; ++i) {
+    int from = (i * 7919 % count) * 10;
+    for (auto it = map.lower_bound(from), last = map.upper_bound(from + 1000);
+         it != last; ++it) {
+      sum += *it;
+    }
+  }
+  std::printf("  %-9s %d windows of 100 keys %.3fs (%lld)\n", name, windows,
+              secondsSince(start), sum);
+}
+
+// Time window scans over timestamps through lower_bound and upper_bound
+void range(int count) {
+  std::printf("range n=%d\n", count);
+  rangeOne<s21::Map<int, int>>("red-black", count, 100000);
+  rangeOne<s21::Map<int, int, s21::BPlusLayout<256>>>("b+ 256", count, 100000);
+}
+
+template <typename MapT>
+void fillShard(MapT &shard, int count, int offset) {
+  for (int i = 0; i < count; ++i) {
+    shard.insert({2 * i + offset, std::string(64, 'x')});
+  }
+}
+
+// Re-sharding: merging one map of string payloads into another by copying
+// every element, as merge used to do, against relinking the nodes
+void merge(int count) {
+  using MapT = s21::Map<int, std::string>;
+  std::printf("merge n=%d\n", count);
+  MapT target;
+  MapT source;
+  fillShard(target, count / 2, 0);
+  fillShard(source, count / 2, 1);
+  auto start = Clock::now();
+  for (auto it = source.begin(); it != source.end(); ++it) {
+    target.insert(it.first(), *it);
+  }
+  std::printf("  copy      %.3fs size %zu\n", secondsSince(start),
+              target.size());
+  target.clear();
+  source.clear();
+  fillShard(target, count / 2, 0);
+  fillShard(source, count / 2, 1);
+  start = Clock::now();
+  target.merge(source);
+  std::printf("  relink    %.3fs size %zu left %zu\n", secondsSince(start),
+              target.size(), source.size());
+  std::map<int, std::string> std_target;
+  std::map<int, std::string> std_source;
+  fillShard(std_target, count / 2, 0);
+  fillShard(std_source, count / 2, 1);
+  start = Clock::now();
+  std_target.merge(std_source);
+  std::printf("  std::map  %.3fs size %zu\n", secondsSince(start),
+              std_target.size());
+}
+
+template <typename MapT>
+void scanOne(const char *name, const std::vector<int> &keys, int passes) {
+  MapT map;
+  for (int key : keys) {
+    map[key] = key;
+  }
+  long long sum = 0;
+  auto start = Clock::now();
+  for (int pass = 0; pass < passes; ++pass) {
+    for (auto it = map.begin(); it != map.end(); ++it) {
+      if constexpr (std::is_same_v<MapT, std::map<int, int>>) {
+        sum += it->second;
+      } else {
+        sum += *it;
+      }
+    }
+  }
+  double seconds = secondsSince(start);
+  std::printf("  %-18s %.3fs %.1f M elements/s (sum %lld)\n", name, seconds,
+              passes * keys.size() / seconds / 1e6, sum);
+}
+
+// Full scans of a map filled in random order, climbing parents against
+// following the in-order threads
+void scan(int count) {
+  std::mt19937 random(29);
+  std::vector<int> keys(count);
+  for (int i = 0; i < count; ++i) {
+    keys[i] = i;
+  }
+  std::shuffle(keys.begin(), keys.end(), random);
+  int passes = 5;
+  std::printf("scan n=%d passes=%d\n", count, passes);
+  scanOne<s21::Map<int, int>>("red-black", keys, passes);
+  scanOne<s21::Map<int, int, s21::Threaded<s21::RedBlackBalance>>>(
+      "threaded red-black", keys, passes);
+  scanOne<s21::Map<int, int, s21::AvlBalance>>("avl", keys, passes);
+  scanOne<s21::Map<int, int, s21::Threaded<s21::AvlBalance>>>(
+      "threaded avl", keys, passes);
+  scanOne<std::map<int, int>>("std::map", keys, passes);
+}
+
+// One Map behind one mutex, what ConcurrentMap replaces
+class LockedMap {
+ public:
+  std::optional<int> find(int key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = map_.find(key);
+    if (it == map_.end()) {
+      return std::nullopt;
+    }
+    return *it;
+  }
+
+  bool insert_or_assign(int key, int value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return map_.insert_or_assign(key, value).second;
+  }
+
+ private:
+  std::mutex mutex_;
+  s21::Map<int, int> map_;
+};
+
+// Millions of operations per second over threads threads sharing map, nine
+// lookups to one write
+template <typename MapT>
+double concurrentRun(MapT &map, int threads, int ops, int keys) {
+  std::atomic<long long> found(0);
+  std::vector<std::thread> workers;
+  auto start = Clock::now();
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&map, &found, t, threads, ops, keys] {
+      std::mt19937 random(t + 1);
+      long long local = 0;
+      for (int i = 0; i < ops / threads; ++i) {
+        int key = static_cast<int>(random() % keys);
+        if (i % 10 == 0) {
+          map.insert_or_assign(key, i);
+        } else {
+          local += map.find(key).has_value();
+        }
+      }
+      found += local;
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  double seconds = secondsSince(start);
+  return found > 0 ? ops / seconds / 1e6 : 0;
+}
+
+// Throughput of a Map shared through one global mutex against a sharded
+// ConcurrentMap, doubling the thread count up to the number of cores
+void concurrent(int count) {
+  int keys = std::min(count, 1 << 20);
+  int threads_max = std::max(1U, std::thread::hardware_concurrency());
+  std::printf("concurrent ops=%d keys=%d, 90%% find 10%% insert_or_assign\n",
+              count, keys);
+  LockedMap locked;
+  s21::ConcurrentMap<int, int, 64> sharded;
+  for (int key = 0; key < keys; key += 2) {
+    locked.insert_or_assign(key, key);
+    sharded.insert_or_assign(key, key);
+  }
+  for (int threads = 1;; threads = std::min(threads * 2, threads_max)) {
+    double global = concurrentRun(locked, threads, count, keys);
+    double split = concurrentRun(sharded, threads, count, keys);
+    std::printf("  threads %3d  global mutex %6.2f Mops/s", threads, global);
+    std::printf("  sharded %6.2f Mops/s\n", split);
+    if (threads == threads_max) {
+      break;
+    }
+  }
+}
+
+// Publishing a version every batch of updates: a deep Map copy against an
+// O(1) PersistentMap snapshot. Keys are loaded in order first, which would
+// degrade an unbalanced tree
+void snapshot(int count) {
+  int size = std::min(count, 1 << 20);
+  int rounds = 100;
+  int batch = 1000;
+  std::printf("snapshot size=%d rounds=%d batch=%d\n", size, rounds, batch);
+  std::mt19937 random(31);
+  auto start = Clock::now();
+  s21::Map<int, int> map;
+  for (int i = 0; i < size; ++i) {
+    map.insert(i, i);
+  }
+  double map_load = secondsSince(start);
+  start = Clock::now();
+  s21::PersistentMap<int, int> persistent;
+  for (int i = 0; i < size; ++i) {
+    persistent.insert(i, i);
+  }
+  double persistent_load = secondsSince(start);
+  std::printf("  load      Map %.3fs  PersistentMap %.3fs\n", map_load,
+              persistent_load);
+
+  size_t kept = 0;
+  start = Clock::now();
+  for (int round = 0; round < rounds; ++round) {
+    s21::Map<int, int> published(map);
+    for (int i = 0; i < batch; ++i) {
+      map.insert_or_assign(static_cast<int>(random() % size), i);
+    }
+    kept += published.size();
+  }
+  double map_publish = secondsSince(start);
+  start = Clock::now();
+  for (int round = 0; round < rounds; ++round) {
+    s21::PersistentMap<int, int> published = persistent.snapshot();
+    for (int i = 0; i < batch; ++i) {
+      persistent.insert_or_assign(static_cast<int>(random() % size), i);
+    }
+    kept += published.size();
+  }
+  double persistent_publish = secondsSince(start);
+  std::printf("  publish   Map copy %.3fs  PersistentMap snapshot %.3fs\n",
+              map_publish, persistent_publish);
+
+  long long sum = 0;
+  start = Clock::now();
+  for (int i = 0; i < size; ++i) {
+    sum += map.contains(static_cast<int>(random() % size));
+  }
+  double map_find = secondsSince(start);
+  start = Clock::now();
+  for (int i = 0; i < size; ++i) {
+    sum += persistent.contains(static_cast<int>(random() % size));
+  }
+  double persistent_find = secondsSince(start);
+  std::printf("  find      Map %.3fs  PersistentMap %.3fs (%lld, %zu)\n",
+              map_find, persistent_find, sum, kept);
+}
+
+template <typename MapT>
+void flatOne(const char *name, const std::vector<std::pair<int, int>> &items,
+             const std::vector<int> &probes) {
+  auto start = Clock::now();
+  MapT map;
+  if constexpr (std::is_same_v<MapT, s21::FlatMap<int, int>>) {
+    map.build(items.begin(), items.end());
+  } else {
+    for (const auto &item : items) {
+      map.insert(item);
+    }
+  }
+  double build = secondsSince(start);
+  long long sum = 0;
+  start = Clock::now();
+  for (int key : probes) {
+    auto it = map.find(key);
+    if (it != map.end()) {
+      sum += it.second();
+    }
+  }
+  double find = secondsSince(start);
+  start = Clock::now();
+  for (int key : probes) {
+    auto it = map.lower_bound(key);
+    if (it != map.end()) {
+      sum += it.first();
+    }
+  }
+  double lower = secondsSince(start);
+  std::printf("  %-12s build %.3fs find %.3fs lower_bound %.3fs (%lld)\n",
+              name, build, find, lower, sum);
+}
+
+// A lookup table built once from random pairs, then probed with random keys
+// of which about half are present
+void flat(int count) {
+  int size = std::min(count, 1 << 22);
+  std::mt19937 random(41);
+  std::vector<std::pair<int, int>> items(size);
+  for (int i = 0; i < size; ++i) {
+    items[i] = {static_cast<int>(random() % (2U * size)), i};
+  }
+  std::vector<int> probes(size);
+  for (int &key : probes) {
+    key = static_cast<int>(random() % (2U * size));
+  }
+  std::printf("flat n=%d\n", size);
+  flatOne<s21::Map<int, int>>("Map", items, probes);
+  flatOne<s21::Map<int, int, s21::BPlusLayout<>>>("Map b+", items, probes);
+  flatOne<s21::FlatMap<int, int>>("FlatMap", items, probes);
+}
+
+template <typename MapT, typename Key>
+void radixOne(const char *name, const std::vector<Key> &keys,
+              const std::vector<Key> &probes) {
+  MapT map;
+  auto start = Clock::now();
+  for (size_t i = 0; i < keys.size(); ++i) {
+    map.insert(keys[i], static_cast<int>(i));
+  }
+  double insert = secondsSince(start);
+  long long found = 0;
+  start = Clock::now();
+  for (const Key &key : probes) {
+    found += map.find(key) != map.end();
+  }
+  double find = secondsSince(start);
+  start = Clock::now();
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    found += *it & 1;
+  }
+  double scan = secondsSince(start);
+  std::printf("  %-10s insert %.3fs find %.3fs scan %.3fs (%lld)\n", name,
+              insert, find, scan, found);
+}
+
+// URL-like strings sharing long prefixes, and random 64-bit integers. Half
+// of the probes are present
+void radix(int count) {
+  int size = std::min(count, 1 << 21);
+  std::mt19937_64 random(59);
+  const char *hosts[] = {"https://www.example.com/", "https://cdn.example.com/",
+                         "https://api.example.org/v2/", "http://shop.test/"};
+  auto url = [&] {
+    std::string key = hosts[random() % 4];
+    key += "catalog/" + std::to_string(random() % 1000) + "/item/";
+    key += std::to_string(random() % 100000000);
+    return key;
+  };
+  std::vector<std::string> strings(size);
+  std::vector<std::string> stringProbes(size);
+  std::vector<std::uint64_t> numbers(size);
+  std::vector<std::uint64_t> numberProbes(size);
+  for (int i = 0; i < size; ++i) {
+    strings[i] = url();
+    numbers[i] = random();
+  }
+  for (int i = 0; i < size; ++i) {
+    stringProbes[i] = i % 2 ? strings[random() % size] : url();
+    numberProbes[i] = i % 2 ? numbers[random() % size] : random();
+  }
+  std::printf("radix std::string n=%d\n", size);
+  radixOne<s21::Map<std::string, int>>("Map", strings, stringProbes);
+  radixOne<s21::Map<std::string, int, s21::BPlusLayout<>>>(
+      "Map b+", strings, stringProbes);
+  radixOne<s21::RadixMap<std::string, int>>("RadixMap", strings,
+                                            stringProbes);
+  std::printf("radix uint64 n=%d\n", size);
+  radixOne<s21::Map<std::uint64_t, int>>("Map", numbers, numberProbes);
+  radixOne<s21::Map<std::uint64_t, int, s21::BPlusLayout<>>>(
+      "Map b+", numbers, numberProbes);
+  radixOne<s21::RadixMap<std::uint64_t, int>>("RadixMap", numbers,
+                                              numberProbes);
+}
+
+// Warm start of a read-only index: rebuilding a Map by inserting every
+// element against opening a snapshot saved from it with MappedMap. The
+// first-lookups column is the time until 1000 queries have been answered.
+// The snapshot is read back from the page cache, not from a cold disk
+void mapped(int count) {
+  int size = std::min(count, 1 << 23);
+  std::mt19937_64 random(67);
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> items(size);
+  for (int i = 0; i < size; ++i) {
+    items[i] = {random(), static_cast<std::uint64_t>(i)};
+  }
+  std::vector<std::uint64_t> probes(size);
+  for (int i = 0; i < size; ++i) {
+    probes[i] = i % 2 ? items[random() % size].first : random();
+  }
+  const char *path = "s21_map_bench.snapshot";
+  std::printf("mapped uint64 -> uint64 n=%d\n", size);
+  std::uint64_t sum = 0;
+  auto start = Clock::now();
+  s21::Map<std::uint64_t, std::uint64_t> map;
+  for (const auto &item : items) {
+    map.insert(item.first, item.second);
+  }
+  double insert = secondsSince(start);
+  start = Clock::now();
+  for (int i = 0; i < 1000; ++i) {
+    auto it = map.find(probes[i]);
+    sum += it != map.end() ? *it : 0;
+  }
+  double first = insert + secondsSince(start);
+  start = Clock::now();
+  for (std::uint64_t key : probes) {
+    auto it = map.find(key);
+    sum += it != map.end() ? *it : 0;
+  }
+  double find = secondsSince(start);
+  std::printf("  %-10s start %.3fs first lookups %.3fs find %.3fs\n",
+              "Map", insert, first, find);
+  start = Clock::now();
+  s21::MappedMap<std::uint64_t, std::uint64_t>::save(map, path);
+  double save = secondsSince(start);
+  start = Clock::now();
+  s21::MappedMap<std::uint64_t, std::uint64_t> mapped(path);
+  double open = secondsSince(start);
+  for (int i = 0; i < 1000; ++i) {
+    auto it = mapped.find(probes[i]);
+    sum += it != mapped.end() ? *it : 0;
+  }
+  first = secondsSince(start);
+  start = Clock::now();
+  for (std::uint64_t key : probes) {
+    auto it = mapped.find(key);
+    sum += it != mapped.end() ? *it : 0;
+  }
+  find = secondsSince(start);
+  std::printf("  %-10s start %.3fs first lookups %.3fs find %.3fs "
+              "save %.3fs (%llu)\n",
+              "MappedMap", open, first, find, save,
+              static_cast<unsigned long long>(sum));
+  std::remove(path);
+}
+
+}  // namespace
+
+// Usage: s21_map_bench [name] [count]
+int main(int argc, char **argv) {
+  const char *name = argc > 1 ? argv[1] : "all";
+  int count = argc > 2 ? std::atoi(argv[2]) : 10000000;
+  bool all = std::strcmp(name, "all") == 0;
+  if (all || std::strcmp(name, "sorted_insert") == 0) {
+    sortedInsert(count);
+  }
+  if (all || std::strcmp(name, "policies") == 0) {
+    policies(count);
+  }
+  if (all || std::strcmp(name, "b_plus") == 0) {
+    bPlus(count);
+  }
+  if (all || std::strcmp(name, "copy") == 0) {
+    copy(count);
+  }
+  if (all || std::strcmp(name, "hint") == 0) {
+    hint(count);
+  }
+  if (all || std::strcmp(name, "compare") == 0) {
+    compare(count);
+  }
+  if (all || std::strcmp(name, "transparent") == 0) {
+    transparent(count);
+  }
+  if (all || std::strcmp(name, "order_statistic") == 0) {
+    orderStatistic(count);
+  }
+  if (all || std::strcmp(name, "range") == 0) {
+    range(count);
+  }
+  if (all || std::strcmp(name, "merge") == 0) {
+    merge(count);
+  }
+  if (all || std::strcmp(name, "scan") == 0) {
+    scan(count);
+  }
+  if (all || std::strcmp(name, "concurrent") == 0) {
+    concurrent(count);
+  }
+  if (all || std::strcmp(name, "snapshot") == 0) {
+    snapshot(count);
+  }
+  if (all || std::strcmp(name, "flat") == 0) {
+    flat(count);
+  }
+  if (all || std::strcmp(name, "radix") == 0) {
+    radix(count);
+  }
+  if (all || std::strcmp(name, "mapped") == 0) {
+    mapped(count);
+  }
+  return 0;
+}
@@ -2,14 +2,37 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
 #include <cstring>
+#include <new>
 #include <map>
+#include <string_view>
+#include <vector>
 
 template <class KT, class VT>
 bool compare(s21::Map<KT, VT> &m1, s21::Map<KT, VT> &m2);
 
+template <class KT, class VT, class Balance, class Compare>
+bool compareWithStd(s21::Map<KT, VT, Balance, Compare> &s21_map,
+                    std::map<KT, VT, Compare> &std_map);
+
+template <class KT, class VT, class Balance>
+size_t maxDepth(s21::Map<KT, VT, Balance> &map);
+
+template <class KT, class VT>
+bool isRedBlack(s21::Map<KT, VT> &map);
+
 template <class KT, class VT>
-bool compareWithStd(s21::Map<KT, VT> &s21_map, std::map<KT, VT> &std_map);
+bool isAvl(s21::Map<KT, VT, s21::AvlBalance> &map);
+
+template <class KT, class VT>
+bool isTreap(s21::Map<KT, VT, s21::TreapBalance> &map);
+
+template <class Balance>
+void randomInsertErase(s21::Map<int, int, Balance> &s21_map,
+                       std::map<int, int> &std_map);
 
 // Constructors
 TEST(Map, base_constructor) {
@@ -232,6 +255,9 @@ TEST(Map, merge) {
   std::map<int, char> std_map2{{1, 'd'}, {10, 'e'}, {11, 'f'}};
   std_map.merge(std_map2);
   ASSERT_TRUE(compareWithStd(s21_map, std_map));
+  ASSERT_TRUE(compareWithStd(s21_map2, std_map2));
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  ASSERT_EQ(s21_map2.size(), std_map2.size());
 }
 
 TEST(Map, braces_empty) {
@@ -262,6 +288,929 @@ TEST(Map, iter_ptr) {
   ASSERT_TRUE((++it) == map.begin());
 }
 
+TEST(Map, sorted_insert_stays_balanced) {
+  s21::Map<int, int> map;
+  const int count = 1 << 16;
+  for (int i = 0; i < count; ++i) {
+    map.insert(i, i);
+  }
+  ASSERT_EQ(map.size(), static_cast<size_t>(count));
+  ASSERT_TRUE(maxDepth(map) <= 2 * 17);
+  ASSERT_TRUE(isRedBlack(map));
+  for (int i = 0; i < count; ++i) {
+    ASSERT_TRUE(map.contains(i));
+  }
+}
+
+TEST(Map, random_insert_erase) {
+  s21::Map<int, int> s21_map;
+  std::map<int, int> std_map;
+  randomInsertErase(s21_map, std_map);
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  ASSERT_TRUE(compareWithStd(s21_map, std_map));
+  ASSERT_TRUE(isRedBlack(s21_map));
+}
+
+template <class Balance>
+bool threadsMatchTree(s21::Map<int, int, Balance> &map) {
+  decltype(map.begin().getNode()) previous = nullptr;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    if (it.getNode()->prev != previous) {
+      return false;
+    }
+    previous = it.getNode();
+  }
+  return previous == nullptr || previous->next == nullptr;
+}
+
+template <class Balance>
+void threadedMatchesStd() {
+  s21::Map<int, int, Balance> s21_map;
+  std::map<int, int> std_map;
+  randomInsertErase(s21_map, std_map);
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  ASSERT_TRUE(compareWithStd(s21_map, std_map));
+  ASSERT_TRUE(threadsMatchTree(s21_map));
+  s21::Map<int, int, Balance> copy(s21_map);
+  ASSERT_TRUE(compareWithStd(copy, std_map));
+  ASSERT_TRUE(threadsMatchTree(copy));
+  std::vector<std::pair<int, int>> items(std_map.begin(), std_map.end());
+  s21::Map<int, int, Balance> loaded(s21::sorted_unique, items.begin(),
+                                     items.end());
+  ASSERT_TRUE(compareWithStd(loaded, std_map));
+  ASSERT_TRUE(threadsMatchTree(loaded));
+  s21::Map<int, int, Balance> other{{-1, 0}, {5000, 0}};
+  auto node = other.extract(-1);
+  loaded.insert(std::move(node));
+  loaded.merge(other);
+  std_map.insert({{-1, 0}, {5000, 0}});
+  ASSERT_TRUE(compareWithStd(loaded, std_map));
+  ASSERT_TRUE(threadsMatchTree(loaded));
+  ASSERT_TRUE(threadsMatchTree(other));
+}
+
+TEST(Map, threaded_policy) {
+  threadedMatchesStd<s21::Threaded<s21::RedBlackBalance>>();
+  threadedMatchesStd<s21::Threaded<s21::TreapBalance>>();
+  threadedMatchesStd<s21::Threaded<s21::OrderStatistic<s21::AvlBalance>>>();
+  threadedMatchesStd<s21::OrderStatistic<s21::Threaded<s21::NoBalance>>>();
+  s21::Map<int, int, s21::OrderStatistic<s21::Threaded<s21::AvlBalance>>> map;
+  for (int i = 0; i < 100; ++i) {
+    map.insert(i, i);
+  }
+  ASSERT_EQ(map.nth(42).first(), 42);
+  ASSERT_EQ(map.rank(42), 42U);
+}
+
+TEST(Map, erase_root_until_empty) {
+  s21::Map<int, int> map{{1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}};
+  while (!map.empty()) {
+    map.erase(map.begin());
+    ASSERT_TRUE(isRedBlack(map));
+  }
+  ASSERT_TRUE(map.begin() == map.end());
+}
+
+TEST(Map, avl_policy) {
+  s21::Map<int, int, s21::AvlBalance> s21_map;
+  std::map<int, int> std_map;
+  randomInsertErase(s21_map, std_map);
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  ASSERT_TRUE(compareWithStd(s21_map, std_map));
+  ASSERT_TRUE(isAvl(s21_map));
+}
+
+TEST(Map, treap_policy) {
+  s21::Map<int, int, s21::TreapBalance> s21_map;
+  std::map<int, int> std_map;
+  randomInsertErase(s21_map, std_map);
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  ASSERT_TRUE(compareWithStd(s21_map, std_map));
+  ASSERT_TRUE(isTreap(s21_map));
+}
+
+TEST(Map, no_balance_policy) {
+  s21::Map<int, int, s21::NoBalance> s21_map;
+  std::map<int, int> std_map;
+  randomInsertErase(s21_map, std_map);
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  ASSERT_TRUE(compareWithStd(s21_map, std_map));
+}
+
+TEST(Map, policy_depth_and_rotations) {
+  s21::BTree<int, int, s21::NoBalance> plain;
+  s21::BTree<int, int, s21::RedBlackBalance> red_black;
+  s21::BTree<int, int, s21::AvlBalance> avl;
+  const int count = 1023;
+  for (int i = 0; i < count; ++i) {
+    plain.insert(i, i);
+    red_black.insert(i, i);
+    avl.insert(i, i);
+  }
+  ASSERT_EQ(plain.height(), static_cast<size_t>(count));
+  ASSERT_EQ(plain.rotations(), 0U);
+  ASSERT_EQ(avl.height(), 10U);
+  ASSERT_TRUE(red_black.height() <= 2 * 10);
+  ASSERT_TRUE(red_black.rotations() < avl.rotations());
+}
+
+TEST(Map, erased_nodes_are_recycled) {
+  s21::Map<int, int> map{{1, 1}, {2, 2}, {3, 3}};
+  auto node = map.find(2).getNode();
+  map.erase(map.find(2));
+  auto result = map.insert(4, 4);
+  ASSERT_EQ(result.first.getNode(), node);
+  ASSERT_EQ(map.size(), 3U);
+}
+
+TEST(Map, clear_and_reuse) {
+  s21::Map<std::string, std::string> map;
+  for (int i = 0; i < 1000; ++i) {
+    map.insert(std::to_string(i), std::string(40, 'a'));
+  }
+  map.clear();
+  ASSERT_TRUE(map.empty());
+  ASSERT_TRUE(map.begin() == map.end());
+  map.insert("key", "value");
+  ASSERT_EQ(map.at("key"), "value");
+  ASSERT_EQ(map.size(), 1U);
+}
+
+TEST(Map, b_plus_layout) {
+  s21::Map<int, int, s21::BPlusLayout<>> s21_map;
+  std::map<int, int> std_map;
+  randomInsertErase(s21_map, std_map);
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  ASSERT_TRUE(compareWithStd(s21_map, std_map));
+  for (auto &item : std_map) {
+    ASSERT_EQ(s21_map.at(item.first), item.second);
+  }
+}
+
+TEST(Map, b_plus_layout_small_nodes) {
+  s21::Map<int, int, s21::BPlusLayout<64>> s21_map;
+  std::map<int, int> std_map;
+  randomInsertErase(s21_map, std_map);
+  ASSERT_TRUE(compareWithStd(s21_map, std_map));
+  while (!s21_map.empty()) {
+    std_map.erase(s21_map.begin().first());
+    s21_map.erase(s21_map.begin());
+    ASSERT_EQ(s21_map.size(), std_map.size());
+  }
+  ASSERT_TRUE(s21_map.begin() == s21_map.end());
+}
+
+TEST(Map, b_plus_layout_string_keys) {
+  s21::Map<std::string, std::string, s21::BPlusLayout<128>> s21_map;
+  std::map<std::string, std::string> std_map;
+  for (int i = 0; i < 2000; ++i) {
+    std::string key = std::to_string(i * 7919 % 2003);
+    s21_map.insert(key, key + "_value");
+    std_map.insert(std::make_pair(key, key + "_value"));
+  }
+  for (int i = 0; i < 2003; i += 2) {
+    std::string key = std::to_string(i);
+    if (s21_map.contains(key)) {
+      s21_map.erase(s21_map.find(key));
+      std_map.erase(key);
+    }
+  }
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  ASSERT_TRUE(compareWithStd(s21_map, std_map));
+  s21_map["new"] = "value";
+  ASSERT_EQ(s21_map.at("new"), "value");
+}
+
+TEST(Map, copy_is_balanced) {
+  s21::Map<int, int> map;
+  const int count = 1 << 16;
+  for (int i = 0; i < count; ++i) {
+    map.insert(i, -i);
+  }
+  s21::Map<int, int> copy(map);
+  ASSERT_TRUE(compare(map, copy));
+  ASSERT_TRUE(isRedBlack(copy));
+  ASSERT_EQ(maxDepth(copy), maxDepth(map));
+  s21::Map<int, int> assigned{{1, 1}, {2, 2}};
+  assigned = copy;
+  ASSERT_TRUE(compare(map, assigned));
+  ASSERT_TRUE(isRedBlack(assigned));
+  assigned.insert(count, count);
+  assigned.erase(assigned.find(0));
+  ASSERT_TRUE(isRedBlack(assigned));
+}
+
+TEST(Map, copy_clones_structure) {
+  s21::BTree<int, int, s21::NoBalance> plain;
+  s21::BTree<int, int, s21::AvlBalance> avl;
+  const int count = 1000;
+  for (int i = 0; i < count; ++i) {
+    plain.insert(i, i);
+    avl.insert((i * 7919) % count, i);
+  }
+  s21::BTree<int, int, s21::NoBalance> plain_copy;
+  s21::BTree<int, int, s21::AvlBalance> avl_copy;
+  plain_copy.assign(plain);
+  avl_copy.assign(avl);
+  ASSERT_EQ(plain_copy.height(), static_cast<size_t>(count));
+  auto it = avl.begin();
+  auto low = avl_copy.begin().getNode();
+  auto high = low;
+  for (auto copy_it = avl_copy.begin(); copy_it != avl_copy.end();
+       ++copy_it, ++it) {
+    auto node = it.getNode();
+    auto copy = copy_it.getNode();
+    ASSERT_EQ(copy->key, node->key);
+    ASSERT_EQ(copy->value, node->value);
+    ASSERT_EQ(copy->balance(), node->balance());
+    ASSERT_EQ(copy->left == nullptr, node->left == nullptr);
+    ASSERT_EQ(copy->right == nullptr, node->right == nullptr);
+    low = std::min(low, copy);
+    high = std::max(high, copy);
+  }
+  ASSERT_TRUE(it == avl.end());
+  ASSERT_EQ(high - low, count - 1);
+}
+
+TEST(Map, sorted_unique_constructor) {
+  std::map<int, int> std_map;
+  for (int i = 0; i < 1000; ++i) {
+    std_map.insert(std::make_pair(i * 3, i));
+  }
+  s21::Map<int, int> red_black(s21::sorted_unique, std_map.begin(),
+                               std_map.end());
+  s21::Map<int, int, s21::AvlBalance> avl(s21::sorted_unique, std_map.begin(),
+                                          std_map.end());
+  s21::Map<int, int, s21::TreapBalance> treap(s21::sorted_unique,
+                                              std_map.begin(), std_map.end());
+  s21::Map<int, int, s21::BPlusLayout<64>> b_plus(
+      s21::sorted_unique, std_map.begin(), std_map.end());
+  ASSERT_EQ(red_black.size(), std_map.size());
+  ASSERT_EQ(b_plus.size(), std_map.size());
+  ASSERT_TRUE(compareWithStd(red_black, std_map));
+  ASSERT_TRUE(compareWithStd(avl, std_map));
+  ASSERT_TRUE(compareWithStd(treap, std_map));
+  ASSERT_TRUE(compareWithStd(b_plus, std_map));
+  ASSERT_TRUE(isRedBlack(red_black));
+  ASSERT_TRUE(isAvl(avl));
+  ASSERT_TRUE(isTreap(treap));
+  randomInsertErase(avl, std_map);
+  ASSERT_TRUE(isAvl(avl));
+  ASSERT_TRUE(compareWithStd(avl, std_map));
+}
+
+TEST(Map, b_plus_layout_copy) {
+  s21::Map<int, int, s21::BPlusLayout<64>> s21_map;
+  std::map<int, int> std_map;
+  randomInsertErase(s21_map, std_map);
+  s21::Map<int, int, s21::BPlusLayout<64>> copy(s21_map);
+  ASSERT_EQ(copy.size(), std_map.size());
+  ASSERT_TRUE(compareWithStd(copy, std_map));
+  while (!copy.empty()) {
+    std_map.erase(copy.begin().first());
+    copy.erase(copy.begin());
+    ASSERT_TRUE(compareWithStd(copy, std_map));
+  }
+}
+
+TEST(Map, insert_existing_key) {
+  s21::Map<int, char> map{{1, 'a'}, {2, 'b'}};
+  auto result = map.insert(2, 'c');
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(result.first.first(), 2);
+  ASSERT_EQ(result.first.second(), 'b');
+  ASSERT_EQ(map.size(), 2U);
+  map[3]++;
+  map[3]++;
+  ASSERT_EQ(map.at(3), 2);
+  ASSERT_EQ(map.size(), 3U);
+}
+
+TEST(Map, emplace) {
+  s21::Map<int, std::string> map;
+  auto result = map.emplace(1, "one");
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(result.first.second(), "one");
+  result = map.emplace(std::make_pair(1, "uno"));
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(map.at(1), "one");
+  ASSERT_EQ(map.size(), 1U);
+}
+
+// Payload counting how often it is copied
+struct Tracked {
+  static int copies;
+  std::string text;
+
+  Tracked() = default;
+  explicit Tracked(std::string text) : text(std::move(text)) {}
+  Tracked(const Tracked &other) : text(other.text) { ++copies; }
+  Tracked(Tracked &&) = default;
+  Tracked &operator=(const Tracked &other) {
+    text = other.text;
+    ++copies;
+    return *this;
+  }
+  Tracked &operator=(Tracked &&) = default;
+};
+
+int Tracked::copies = 0;
+
+template <class Balance>
+void insertWithoutCopies() {
+  Tracked::copies = 0;
+  s21::Map<std::string, Tracked, Balance> map;
+  ASSERT_TRUE(map.emplace("a", Tracked("one")).second);
+  ASSERT_TRUE(map.try_emplace("b", "two").second);
+  ASSERT_TRUE(map.try_emplace(std::string("c"), "three").second);
+  ASSERT_TRUE(map.insert({"d", Tracked("four")}).second);
+  ASSERT_TRUE(map.emplace_hint(map.end(), "e", Tracked("five")) != map.end());
+  std::string key = "f";
+  Tracked six("six");
+  ASSERT_TRUE(map.try_emplace(std::move(key), std::move(six)).second);
+  ASSERT_TRUE(six.text.empty());
+  Tracked kept("kept");
+  ASSERT_FALSE(map.try_emplace("a", std::move(kept)).second);
+  ASSERT_EQ(kept.text, "kept");
+  ASSERT_EQ(Tracked::copies, 0);
+  ASSERT_EQ(map.size(), 6U);
+  ASSERT_EQ(map.at("a").text, "one");
+  ASSERT_EQ(map.at("c").text, "three");
+  ASSERT_EQ(map.at("f").text, "six");
+}
+
+TEST(Map, insert_without_copies) {
+  insertWithoutCopies<s21::RedBlackBalance>();
+  insertWithoutCopies<s21::AvlBalance>();
+  insertWithoutCopies<s21::OrderStatistic<s21::TreapBalance>>();
+  insertWithoutCopies<s21::BPlusLayout<256>>();
+  s21::Map<std::string, int> map;
+  std::string key(100, 'k');
+  map[std::move(key)] = 1;
+  ASSERT_TRUE(key.empty());
+  ASSERT_EQ(map.at(std::string(100, 'k')), 1);
+}
+
+TEST(Map, node_handles) {
+  Tracked::copies = 0;
+  s21::Map<int, Tracked> map;
+  map.try_emplace(1, "one");
+  map.try_emplace(2, "two");
+  map.try_emplace(3, "three");
+  const Tracked *address = &map.at(2);
+  auto node = map.extract(2);
+  ASSERT_FALSE(node.empty());
+  ASSERT_EQ(map.size(), 2U);
+  ASSERT_FALSE(map.contains(2));
+  ASSERT_EQ(node.key(), 2);
+  ASSERT_EQ(node.mapped().text, "two");
+  node.key() = 20;
+  auto result = map.insert(std::move(node));
+  ASSERT_TRUE(result.inserted);
+  ASSERT_TRUE(result.node.empty());
+  ASSERT_EQ(result.position.first(), 20);
+  ASSERT_EQ(&map.at(20), address);
+  ASSERT_TRUE(map.extract(5).empty());
+  ASSERT_TRUE(map.extract(map.end()).empty());
+  ASSERT_EQ(map.size(), 3U);
+
+  auto duplicate = map.extract(map.find(1));
+  duplicate.key() = 3;
+  result = map.insert(std::move(duplicate));
+  ASSERT_FALSE(result.inserted);
+  ASSERT_EQ(result.position.first(), 3);
+  ASSERT_EQ(result.node.mapped().text, "one");
+  ASSERT_EQ(map.size(), 2U);
+  ASSERT_EQ(Tracked::copies, 0);
+}
+
+TEST(Map, node_handle_outlives_source) {
+  s21::Map<int, std::string> target;
+  s21::Map<int, std::string>::node_type kept;
+  {
+    s21::Map<int, std::string> source;
+    for (int i = 0; i < 100; ++i) {
+      source.insert(i, std::string(40, static_cast<char>('a' + i % 26)));
+    }
+    kept = source.extract(7);
+    target.insert(source.extract(8));
+    source.clear();
+    source.insert(1, "reused");
+  }
+  ASSERT_EQ(kept.mapped(), std::string(40, 'h'));
+  ASSERT_EQ(target.at(8), std::string(40, 'i'));
+  ASSERT_TRUE(target.insert(std::move(kept)).inserted);
+  ASSERT_EQ(target.size(), 2U);
+  target.erase(target.find(7));
+  ASSERT_EQ(target.size(), 1U);
+}
+
+template <class Balance>
+void mergeByRelinking() {
+  s21::Map<int, int, Balance> map;
+  s21::Map<int, int, Balance> other;
+  std::map<int, int> std_map;
+  std::map<int, int> std_other;
+  for (int i = 0; i < 300; ++i) {
+    map.insert(i * 3, i);
+    std_map.insert({i * 3, i});
+    other.insert(i * 2, -i);
+    std_other.insert({i * 2, -i});
+  }
+  const int *address = &other.at(4);
+  map.merge(other);
+  std_map.merge(std_other);
+  ASSERT_EQ(map.size(), std_map.size());
+  ASSERT_EQ(other.size(), std_other.size());
+  ASSERT_TRUE(compareWithStd(map, std_map));
+  ASSERT_TRUE(compareWithStd(other, std_other));
+  if constexpr (!std::is_same_v<Balance, s21::BPlusLayout<>>) {
+    ASSERT_EQ(&map.at(4), address);
+  }
+  ASSERT_EQ(map.nth(100).first(), std::next(std_map.begin(), 100)->first);
+  ASSERT_EQ(other.rank(600), 100U);
+  map.merge(map);
+  ASSERT_EQ(map.size(), std_map.size());
+}
+
+TEST(Map, merge_by_relinking) {
+  mergeByRelinking<s21::RedBlackBalance>();
+  mergeByRelinking<s21::AvlBalance>();
+  mergeByRelinking<s21::TreapBalance>();
+  mergeByRelinking<s21::NoBalance>();
+  mergeByRelinking<s21::OrderStatistic<s21::AvlBalance>>();
+  mergeByRelinking<s21::BPlusLayout<>>();
+}
+
+// Node pool slabs are the only over-aligned allocations here, so counting
+// those tells how many slabs are alive
+std::atomic<long> liveSlabs{0};
+std::atomic<long> allocations{0};
+
+void *operator new(std::size_t size) {
+  void *memory = std::malloc(size ? size : 1);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  ++allocations;
+  return memory;
+}
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+
+void operator delete(void *memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+  std::size_t alignment = static_cast<std::size_t>(align);
+  void *memory =
+      std::aligned_alloc(alignment, (size + alignment - 1) / alignment *
+                                        alignment);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  ++liveSlabs;
+  ++allocations;
+  return memory;
+}
+
+void operator delete(void *memory, std::align_val_t) noexcept {
+  --liveSlabs;
+  std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t, std::align_val_t) noexcept {
+  --liveSlabs;
+  std::free(memory);
+}
+
+TEST(Map, extract_insert_cycles_keep_pools_bounded) {
+  long before = liveSlabs;
+  s21::Map<int, std::string> map;
+  for (int i = 0; i < 10; ++i) {
+    map.insert(i, "kept");
+  }
+  for (int round = 0; round < 20000; ++round) {
+    s21::Map<int, std::string> source;
+    for (int i = 0; i < 10; ++i) {
+      source.insert(i, "lent");
+    }
+    map.erase(map.find(round % 10));
+    map.insert(source.extract(round % 10));
+    // The key is present, the handle drops its node
+    map.insert(source.extract((round + 1) % 10));
+  }
+  // Each element pins at most the slab it came from
+  ASSERT_LE(liveSlabs - before, 11);
+  for (int round = 0; round < 20000; ++round) {
+    map.extract(round % 10);
+    map.insert(round % 10, "own");
+  }
+  ASSERT_LE(liveSlabs - before, 11);
+  map.clear();
+  ASSERT_EQ(liveSlabs - before, 0);
+}
+
+TEST(Map, extract_and_insert_allocate_nothing) {
+  s21::Map<int, std::string> first;
+  s21::Map<int, std::string> second;
+  for (int i = 0; i < 100; ++i) {
+    first.insert(i, "short");
+  }
+  long before = allocations;
+  for (int round = 0; round < 1000; ++round) {
+    int key = round % 100;
+    auto &from = round / 100 % 2 ? second : first;
+    auto &to = round / 100 % 2 ? first : second;
+    auto handle = from.extract(key);
+    ASSERT_TRUE(to.insert(std::move(handle)).inserted);
+  }
+  auto handle = first.extract(5);
+  handle.key() = 1000;
+  second.insert(std::move(handle));
+  ASSERT_EQ(allocations - before, 0);
+  ASSERT_EQ(first.size() + second.size(), 100U);
+  ASSERT_EQ(second.at(1000), "short");
+}
+
+template <class Balance>
+void reverseMatchesStd() {
+  s21::Map<int, int, Balance> s21_map;
+  std::map<int, int> std_map;
+  ASSERT_TRUE(s21_map.rbegin() == s21_map.rend());
+  randomInsertErase(s21_map, std_map);
+  auto std_it = std_map.rbegin();
+  for (auto it = s21_map.rbegin(); it != s21_map.rend(); ++it, ++std_it) {
+    ASSERT_EQ(std::prev(it.base()).first(), std_it->first);
+    ASSERT_EQ(*it, std_it->second);
+  }
+  ASSERT_TRUE(std_it == std_map.rend());
+  auto last = --s21_map.end();
+  ASSERT_EQ(last.first(), std_map.rbegin()->first);
+  auto it = s21_map.end();
+  ASSERT_TRUE(it-- == s21_map.end());
+  ASSERT_TRUE(it == last);
+  ASSERT_EQ(std::distance(s21_map.begin(), s21_map.end()),
+            static_cast<std::ptrdiff_t>(std_map.size()));
+  ASSERT_EQ(std::prev(s21_map.end(), 10).first(),
+            std::prev(std_map.end(), 10)->first);
+}
+
+TEST(Map, reverse_iteration) {
+  reverseMatchesStd<s21::RedBlackBalance>();
+  reverseMatchesStd<s21::AvlBalance>();
+  reverseMatchesStd<s21::TreapBalance>();
+  reverseMatchesStd<s21::NoBalance>();
+  reverseMatchesStd<s21::OrderStatistic<s21::AvlBalance>>();
+  reverseMatchesStd<s21::Threaded<s21::RedBlackBalance>>();
+  reverseMatchesStd<s21::BPlusLayout<>>();
+  reverseMatchesStd<s21::BPlusLayout<64>>();
+}
+
+template <class Balance>
+void emplaceHints(s21::Map<int, int, Balance> &s21_map) {
+  std::map<int, int> std_map;
+  for (int i = 0; i < 3000; i += 2) {
+    s21_map.emplace_hint(s21_map.end(), i, i);
+    std_map.emplace_hint(std_map.end(), i, i);
+  }
+  for (int i = 0; i < 3000; i += 7) {
+    s21_map.erase(s21_map.find(i - i % 2));
+    std_map.erase(i - i % 2);
+  }
+  auto hint = s21_map.begin();
+  for (int i = 1; i < 3000; i += 2) {
+    hint = s21_map.emplace_hint(hint, i, -i);
+    std_map.emplace_hint(std_map.end(), i, -i);
+  }
+  for (int i = 3000; i < 4000; ++i) {
+    s21_map.emplace_hint(s21_map.end(), i, i);
+    std_map.emplace_hint(std_map.end(), i, i);
+  }
+  unsigned seed = 11;
+  for (int i = 0; i < 5000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>((seed >> 16) % 5000);
+    s21_map.emplace_hint(s21_map.find(key - 1), key, key);
+    std_map.emplace(key, key);
+  }
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  ASSERT_TRUE(compareWithStd(s21_map, std_map));
+}
+
+TEST(Map, emplace_hint) {
+  s21::Map<int, int> red_black;
+  s21::Map<int, int, s21::AvlBalance> avl;
+  s21::Map<int, int, s21::TreapBalance> treap;
+  s21::Map<int, int, s21::BPlusLayout<64>> b_plus;
+  emplaceHints(red_black);
+  emplaceHints(avl);
+  emplaceHints(treap);
+  emplaceHints(b_plus);
+  ASSERT_TRUE(isRedBlack(red_black));
+  ASSERT_TRUE(isAvl(avl));
+  ASSERT_TRUE(isTreap(treap));
+}
+
+TEST(Map, initializer_list_duplicates) {
+  s21::Map<int, char> sorted{{1, 'a'}, {2, 'b'}, {3, 'c'}};
+  s21::Map<int, char> unsorted{{3, 'c'}, {1, 'a'}, {3, 'd'}, {2, 'b'}};
+  ASSERT_EQ(sorted.size(), 3U);
+  ASSERT_TRUE(compare(sorted, unsorted));
+}
+
+TEST(Map, greater_compare) {
+  s21::Map<int, int, s21::RedBlackBalance, std::greater<int>> s21_map;
+  std::map<int, int, std::greater<int>> std_map;
+  unsigned seed = 5;
+  for (int i = 0; i < 3000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>((seed >> 16) % 1000);
+    if (i % 4 == 3 && s21_map.contains(key)) {
+      s21_map.erase(s21_map.find(key));
+      std_map.erase(key);
+    } else {
+      s21_map.insert(key, i);
+      std_map.insert({key, i});
+    }
+  }
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  ASSERT_TRUE(compareWithStd(s21_map, std_map));
+  s21::Map<int, int, s21::RedBlackBalance, std::greater<int>> sorted{
+      {3, 0}, {2, 0}, {1, 0}};
+  ASSERT_EQ(sorted.begin().first(), 3);
+}
+
+TEST(Map, string_keys_three_way) {
+  s21::Map<std::string, int> s21_map;
+  std::map<std::string, int> std_map;
+  for (int i = 0; i < 2000; ++i) {
+    std::string key = "key_" + std::to_string(i * 7919 % 2000);
+    s21_map.insert(key, i);
+    std_map.insert({key, i});
+  }
+  for (int i = 0; i < 2000; i += 3) {
+    std::string key = "key_" + std::to_string(i);
+    s21_map.erase(s21_map.find(key));
+    std_map.erase(key);
+  }
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  ASSERT_TRUE(compareWithStd(s21_map, std_map));
+  ASSERT_FALSE(s21_map.contains("key_0"));
+  ASSERT_TRUE(s21_map.contains("key_1"));
+  ASSERT_FALSE(s21_map.insert("key_1", 0).second);
+}
+
+// Case-insensitive ordering exposing a three-way compare member
+struct NoCase {
+  int compare(const std::string &left, const std::string &right) const {
+    size_t size = std::min(left.size(), right.size());
+    for (size_t i = 0; i < size; ++i) {
+      int l = std::tolower(static_cast<unsigned char>(left[i]));
+      int r = std::tolower(static_cast<unsigned char>(right[i]));
+      if (l != r) {
+        return l - r;
+      }
+    }
+    return static_cast<int>(left.size()) - static_cast<int>(right.size());
+  }
+  bool operator()(const std::string &left, const std::string &right) const {
+    return compare(left, right) < 0;
+  }
+};
+
+TEST(Map, member_compare) {
+  static_assert(s21::ThreeWayCompare<std::string, NoCase>::kNative);
+  static_assert(!s21::ThreeWayCompare<int, std::less<int>>::kNative);
+  s21::Map<std::string, int, s21::AvlBalance, NoCase> map;
+  ASSERT_TRUE(map.insert("Banana", 1).second);
+  ASSERT_TRUE(map.insert("apple", 2).second);
+  ASSERT_FALSE(map.insert("APPLE", 3).second);
+  ASSERT_TRUE(map.insert("cherry", 4).second);
+  ASSERT_EQ(map.size(), 3U);
+  ASSERT_EQ(map.at("BANANA"), 1);
+  ASSERT_EQ(map.begin().first(), "apple");
+  map.erase(map.find("CHERRY"));
+  ASSERT_FALSE(map.contains("cherry"));
+}
+
+TEST(Map, b_plus_layout_compare) {
+  s21::Map<int, int, s21::BPlusLayout<64>, std::greater<int>> s21_map;
+  std::map<int, int, std::greater<int>> std_map;
+  for (int i = 0; i < 5000; ++i) {
+    int key = i * 2654435761U % 10007;
+    s21_map.insert(key, i);
+    std_map.insert({key, i});
+  }
+  for (int i = 0; i < 10007; i += 5) {
+    if (s21_map.contains(i)) {
+      s21_map.erase(s21_map.find(i));
+      std_map.erase(i);
+    }
+  }
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  ASSERT_TRUE(compareWithStd(s21_map, std_map));
+}
+
+// Ordering whose direction is chosen at run time
+struct Direction {
+  bool descending;
+  bool operator()(int left, int right) const {
+    return descending ? right < left : left < right;
+  }
+};
+
+template <class Balance>
+void storedCompare() {
+  using map_type = s21::Map<int, int, Balance, Direction>;
+  map_type down(Direction{true});
+  map_type up(Direction{false});
+  for (int i = 0; i < 200; ++i) {
+    down.insert(i * 37 % 200, i);
+    up.insert(i * 37 % 200, i);
+  }
+  ASSERT_EQ(down.begin().first(), 199);
+  ASSERT_EQ(up.begin().first(), 0);
+  ASSERT_EQ(down.lower_bound(50).first(), 50);
+  ASSERT_EQ(down.upper_bound(50).first(), 49);
+  ASSERT_TRUE(down.contains(150));
+  // Copies, moves and swaps carry the ordering with the elements
+  map_type copy(down);
+  ASSERT_EQ(copy.begin().first(), 199);
+  copy = up;
+  ASSERT_EQ(copy.begin().first(), 0);
+  map_type moved(std::move(down));
+  ASSERT_EQ(moved.begin().first(), 199);
+  moved.swap(up);
+  ASSERT_EQ(up.begin().first(), 199);
+  ASSERT_TRUE(up.insert(-1, 0).second);
+  ASSERT_EQ(std::prev(up.end()).first(), -1);
+  map_type listed({{1, 1}, {2, 2}, {3, 3}}, Direction{true});
+  ASSERT_EQ(listed.begin().first(), 3);
+}
+
+TEST(Map, stored_compare) {
+  storedCompare<s21::RedBlackBalance>();
+  storedCompare<s21::BPlusLayout<64>>();
+}
+
+TEST(Map, transparent_lookup) {
+  s21::Map<std::string, int, s21::RedBlackBalance, std::less<>> map{
+      {"alpha", 1}, {"beta", 2}, {"gamma", 3}};
+  s21::Map<std::string, int, s21::BPlusLayout<64>, std::less<>> b_plus;
+  for (int i = 0; i < 500; ++i) {
+    b_plus.insert("route/" + std::to_string(i), i);
+  }
+  std::string_view beta = "beta";
+  ASSERT_EQ(map.find(beta).second(), 2);
+  ASSERT_EQ(map.at("gamma"), 3);
+  ASSERT_TRUE(map.contains(std::string_view("alpha")));
+  ASSERT_FALSE(map.contains("delta"));
+  ASSERT_EQ(map.count("beta"), 1U);
+  ASSERT_EQ(map.count(std::string_view("bet")), 0U);
+  ASSERT_EQ(map.find("zeta"), map.end());
+  ASSERT_THROW(map.at(std::string_view("zeta")), std::out_of_range);
+  ASSERT_EQ(b_plus.at(std::string_view("route/321")), 321);
+  ASSERT_FALSE(b_plus.contains("route/500"));
+  s21::Map<std::string, int, s21::AvlBalance, std::greater<>> reversed{
+      {"a", 1}, {"b", 2}};
+  ASSERT_EQ(reversed.begin().first(), "b");
+  ASSERT_EQ(reversed.at("a"), 1);
+}
+
+template <class Balance>
+void checkOrderStatistics(s21::Map<int, int, Balance> &s21_map,
+                          std::map<int, int> &std_map) {
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  size_t index = 0;
+  for (auto it = std_map.begin(); it != std_map.end(); ++it, ++index) {
+    ASSERT_EQ(s21_map.nth(index).first(), it->first);
+    ASSERT_EQ(s21_map.rank(it->first), index);
+    ASSERT_EQ(s21_map.rank(it->first + 1), index + 1);
+  }
+  ASSERT_EQ(s21_map.nth(index), s21_map.end());
+  ASSERT_EQ(s21_map.rank(-1000), 0U);
+}
+
+template <class Balance>
+void orderStatistics() {
+  s21::Map<int, int, s21::OrderStatistic<Balance>> s21_map;
+  std::map<int, int> std_map;
+  unsigned seed = 3;
+  for (int i = 0; i < 6000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>((seed >> 16) % 1500) * 2;
+    if (i % 3 == 2 && s21_map.contains(key)) {
+      s21_map.erase(s21_map.find(key));
+      std_map.erase(key);
+    } else {
+      s21_map.insert(key, i);
+      std_map.insert({key, i});
+    }
+  }
+  checkOrderStatistics(s21_map, std_map);
+  auto copy = s21_map;
+  checkOrderStatistics(copy, std_map);
+  std::vector<std::pair<int, int>> items(std_map.begin(), std_map.end());
+  s21::Map<int, int, s21::OrderStatistic<Balance>> loaded(
+      s21::sorted_unique, items.begin(), items.end());
+  checkOrderStatistics(loaded, std_map);
+  loaded.insert(-2, 0);
+  std_map.insert({-2, 0});
+  checkOrderStatistics(loaded, std_map);
+}
+
+TEST(Map, order_statistic) {
+  orderStatistics<s21::RedBlackBalance>();
+  orderStatistics<s21::AvlBalance>();
+  orderStatistics<s21::TreapBalance>();
+  orderStatistics<s21::NoBalance>();
+}
+
+template <class Balance>
+void constLookups() {
+  s21::Map<std::string, int, Balance, std::less<>> map;
+  for (int i = 0; i < 300; ++i) {
+    map.insert(std::to_string(i), i);
+  }
+  const auto &view = map;
+  ASSERT_EQ(view.size(), 300U);
+  ASSERT_EQ(view.find("42").second(), 42);
+  ASSERT_TRUE(view.find("300") == view.end());
+  ASSERT_TRUE(view.contains(std::string_view("299")));
+  ASSERT_FALSE(view.contains("-1"));
+  int sum = 0;
+  for (auto it = view.begin(); it != view.end(); ++it) {
+    sum += *it;
+  }
+  ASSERT_EQ(sum, 299 * 300 / 2);
+}
+
+TEST(Map, const_lookups) {
+  constLookups<s21::RedBlackBalance>();
+  constLookups<s21::BPlusLayout<64>>();
+}
+
+TEST(Map, nth_and_rank_without_augmentation) {
+  s21::Map<int, int> red_black;
+  s21::Map<int, int, s21::BPlusLayout<64>> b_plus;
+  for (int i = 0; i < 1000; ++i) {
+    red_black.insert(i * 3, i);
+    b_plus.insert(i * 3, i);
+  }
+  ASSERT_EQ(red_black.nth(10).first(), 30);
+  ASSERT_EQ(b_plus.nth(999).first(), 2997);
+  ASSERT_EQ(b_plus.nth(1000), b_plus.end());
+  ASSERT_EQ(red_black.rank(31), 11U);
+  ASSERT_EQ(b_plus.rank(31), 11U);
+  ASSERT_EQ(b_plus.rank(5000), 1000U);
+}
+
+template <class MapT>
+void boundsMatchStd(MapT &s21_map) {
+  std::map<int, int> std_map;
+  for (int i = 0; i < 2000; ++i) {
+    int key = i * 7919 % 4000;
+    s21_map.insert(key, i);
+    std_map.insert({key, i});
+  }
+  for (int key = -5; key < 4005; ++key) {
+    auto lower = std_map.lower_bound(key);
+    auto upper = std_map.upper_bound(key);
+    auto s21_lower = s21_map.lower_bound(key);
+    auto s21_upper = s21_map.upper_bound(key);
+    ASSERT_EQ(lower == std_map.end(), s21_lower == s21_map.end());
+    ASSERT_EQ(upper == std_map.end(), s21_upper == s21_map.end());
+    if (lower != std_map.end()) {
+      ASSERT_EQ(s21_lower.first(), lower->first);
+    }
+    if (upper != std_map.end()) {
+      ASSERT_EQ(s21_upper.first(), upper->first);
+    }
+    auto range = s21_map.equal_range(key);
+    ASSERT_EQ(range.first, s21_lower);
+    ASSERT_EQ(range.second, s21_upper);
+  }
+}
+
+TEST(Map, lower_upper_bound) {
+  s21::Map<int, int> red_black;
+  s21::Map<int, int, s21::TreapBalance> treap;
+  s21::Map<int, int, s21::BPlusLayout<64>> b_plus;
+  boundsMatchStd(red_black);
+  boundsMatchStd(treap);
+  boundsMatchStd(b_plus);
+  s21::Map<std::string, int, s21::AvlBalance, std::less<>> log{
+      {"10:00", 1}, {"10:05", 2}, {"10:10", 3}, {"10:15", 4}};
+  int sum = 0;
+  for (auto it = log.lower_bound(std::string_view("10:03"));
+       it != log.upper_bound("10:10"); ++it) {
+    sum += it.second();
+  }
+  ASSERT_EQ(sum, 5);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -282,8 +1231,9 @@ bool compare(s21::Map<KT, VT> &m1, s21::Map<KT, VT> &m2) {
   return true;
 }
 
-template <class KT, class VT>
-bool compareWithStd(s21::Map<KT, VT> &s21_map, std::map<KT, VT> &std_map) {
+template <class KT, class VT, class Balance, class Compare>
+bool compareWithStd(s21::Map<KT, VT, Balance, Compare> &s21_map,
+                    std::map<KT, VT, Compare> &std_map) {
   auto s21_it = s21_map.begin();
   auto std_it = std_map.begin();
   for (; std_it != std_map.end(); ++std_it, ++s21_it) {
@@ -295,4 +1245,102 @@ bool compareWithStd(s21::Map<KT, VT> &s21_map, std::map<KT, VT> &std_map) {
     }
   }
   return true;
-}
\ No newline at end of file
+}
+template <class KT, class VT, class Balance>
+size_t maxDepth(s21::Map<KT, VT, Balance> &map) {
+  size_t result = 0;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    size_t depth = 1;
+    for (auto node = it.getNode(); node->parent(); node = node->parent()) {
+      ++depth;
+    }
+    result = std::max(result, depth);
+  }
+  return result;
+}
+
+template <class KT, class VT>
+bool isRedBlack(s21::Map<KT, VT> &map) {
+  if (map.empty()) {
+    return true;
+  }
+  auto root = map.begin().getNode();
+  while (root->parent()) {
+    root = root->parent();
+  }
+  if (s21::RedBlackBalance::isRed(root)) {
+    return false;
+  }
+  int blackHeight = -1;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    auto node = it.getNode();
+    if (s21::RedBlackBalance::isRed(node) &&
+        (s21::RedBlackBalance::isRed(node->left) ||
+         s21::RedBlackBalance::isRed(node->right))) {
+      return false;
+    }
+    if (node->left && node->right) {
+      continue;
+    }
+    int height = 0;
+    for (auto up = node; up; up = up->parent()) {
+      height += s21::RedBlackBalance::isRed(up) ? 0 : 1;
+    }
+    if (blackHeight == -1) {
+      blackHeight = height;
+    } else if (blackHeight != height) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class NodeT>
+int subtreeHeight(NodeT *node) {
+  if (node == nullptr) {
+    return 0;
+  }
+  return 1 + std::max(subtreeHeight(node->left), subtreeHeight(node->right));
+}
+
+template <class KT, class VT>
+bool isAvl(s21::Map<KT, VT, s21::AvlBalance> &map) {
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    auto node = it.getNode();
+    int factor = subtreeHeight(node->right) - subtreeHeight(node->left);
+    if (factor < -1 || factor > 1 ||
+        static_cast<int>(node->balance()) != factor + 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class KT, class VT>
+bool isTreap(s21::Map<KT, VT, s21::TreapBalance> &map) {
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    auto node = it.getNode();
+    if (node->parent() && s21::TreapBalance::priority(node->parent()) <
+                              s21::TreapBalance::priority(node)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class Balance>
+void randomInsertErase(s21::Map<int, int, Balance> &s21_map,
+                       std::map<int, int> &std_map) {
+  unsigned seed = 7;
+  for (int i = 0; i < 20000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>((seed >> 16) % 2000);
+    if (i % 3 == 2 && s21_map.contains(key)) {
+      s21_map.erase(s21_map.find(key));
+      std_map.erase(key);
+    } else {
+      s21_map.insert(key, i);
+      std_map.insert(std::make_pair(key, i));
+    }
+  }
+}
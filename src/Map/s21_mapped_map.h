@@ -0,0 +1,317 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_MAP_S21_MAPPED_MAP_H_
+#define CPP2_S21_CONTAINERS_SRC_MAP_S21_MAPPED_MAP_H_
+
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "Snapshot.h"
+#include "SortedSearch.h"
+
+namespace s21 {
+
+// Read-only map served straight from a snapshot file written by save(). The
+// file holds the keys as one sorted array and the values as another, and is
+// mapped into memory as is, so opening a snapshot of any size costs one
+// mmap instead of re-inserting every element, and pages are read from disk
+// only as lookups touch them. Lookups are a branchless binary search over
+// the mapped keys. Keys and values have to be trivially copyable, and a
+// snapshot can only be read back by a program with the same layout of KT
+// and VT and the same byte order
+template <typename KT, typename VT, typename Compare = std::less<KT>>
+class MappedMap {
+  static_assert(std::is_trivially_copyable_v<KT> &&
+                    std::is_trivially_copyable_v<VT>,
+                "MappedMap stores keys and values as raw bytes");
+
+  using key_type = KT;
+  using mapped_type = VT;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+
+ public:
+  class iterator;
+  using const_iterator = iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  explicit MappedMap(const std::string &path);
+  MappedMap(MappedMap &&other) noexcept;
+  MappedMap &operator=(MappedMap &&other) noexcept;
+
+  template <typename Container>
+  static void save(Container &items, const std::string &path);
+
+  const VT &at(const KT &key) const;
+  iterator find(const KT &key) const;
+  bool contains(const KT &key) const;
+  size_type count(const KT &key) const;
+  iterator lower_bound(const KT &key) const;
+  iterator upper_bound(const KT &key) const;
+  std::pair<iterator, iterator> equal_range(const KT &key) const;
+
+  iterator begin() const;
+  iterator end() const;
+  reverse_iterator rbegin() const;
+  reverse_iterator rend() const;
+
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  void swap(MappedMap &other) noexcept;
+
+ private:
+  size_type findIndex(const KT &key) const;
+  void bind();
+
+  SnapshotFile file_;
+  const KT *keys_;
+  const VT *values_;
+  size_type size_;
+  Compare compare_;
+};
+
+template <typename KT, typename VT, typename Compare>
+class MappedMap<KT, VT, Compare>::iterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = VT;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const VT *;
+  using reference = const VT &;
+
+  iterator() : map_(nullptr), index_(0) {}
+  iterator(const MappedMap *map, size_type index) : map_(map), index_(index) {}
+
+  iterator &operator++() {
+    ++index_;
+    return *this;
+  }
+
+  iterator operator++(int) {
+    iterator old = *this;
+    ++index_;
+    return old;
+  }
+
+  iterator &operator--() {
+    --index_;
+    return *this;
+  }
+
+  iterator operator--(int) {
+    iterator old = *this;
+    --index_;
+    return old;
+  }
+
+  const VT &operator*() const { return map_->values_[index_]; }
+
+  bool operator==(const iterator &other) const {
+    return index_ == other.index_ && map_ == other.map_;
+  }
+
+  bool operator!=(const iterator &other) const { return !(*this == other); }
+
+  const KT &first() const { return map_->keys_[index_]; }
+  const VT &second() const { return map_->values_[index_]; }
+
+ private:
+  const MappedMap *map_;
+  size_type index_;
+};
+
+// Maps the snapshot at path, throws std::system_error if it cannot be read
+// and std::runtime_error if it is not a snapshot of this KT and VT
+template <typename KT, typename VT, typename Compare>
+MappedMap<KT, VT, Compare>::MappedMap(const std::string &path)
+    : file_(path, sizeof(KT), sizeof(VT)), compare_() {
+  bind();
+}
+
+// Move constructor
+template <typename KT, typename VT, typename Compare>
+MappedMap<KT, VT, Compare>::MappedMap(MappedMap &&other) noexcept
+    : file_(std::move(other.file_)), compare_(other.compare_) {
+  bind();
+  other.bind();
+}
+
+// Assignment operator overload for moving object
+template <typename KT, typename VT, typename Compare>
+MappedMap<KT, VT, Compare> &MappedMap<KT, VT, Compare>::operator=(
+    MappedMap &&other) noexcept {
+  swap(other);
+  return *this;
+}
+
+// Writes the elements of items, an ordered map such as Map, FlatMap or
+// another MappedMap, to a snapshot at path. items has to iterate in
+// ascending key order under Compare without duplicates, which is checked,
+// and std::invalid_argument is thrown otherwise. The file is written next to
+// path and renamed over it, so readers see the old snapshot or the new one
+template <typename KT, typename VT, typename Compare>
+template <typename Container>
+void MappedMap<KT, VT, Compare>::save(Container &items,
+                                      const std::string &path) {
+  SnapshotHeader header =
+      SnapshotHeader::make(sizeof(KT), sizeof(VT), items.size());
+  SnapshotWriter writer(path);
+  writer.write(&header, sizeof(header));
+  writer.skipTo(header.keysOffset);
+  Compare compare;
+  const KT *previous = nullptr;
+  for (auto it = items.begin(); it != items.end(); ++it) {
+    const KT &key = it.first();
+    if (previous && !compare(*previous, key)) {
+      throw std::invalid_argument("s21::MappedMap::save: keys out of order");
+    }
+    writer.write(&key, sizeof(KT));
+    previous = &key;
+  }
+  writer.skipTo(header.valuesOffset);
+  for (auto it = items.begin(); it != items.end(); ++it) {
+    writer.write(&it.second(), sizeof(VT));
+  }
+  writer.commit();
+}
+
+// Access specified element with bounds checking
+template <typename KT, typename VT, typename Compare>
+const VT &MappedMap<KT, VT, Compare>::at(const KT &key) const {
+  size_type index = findIndex(key);
+  if (index == size_) {
+    throw std::out_of_range("s21::MappedMap::at");
+  }
+  return values_[index];
+}
+
+// Find element by key
+template <typename KT, typename VT, typename Compare>
+typename MappedMap<KT, VT, Compare>::iterator MappedMap<KT, VT, Compare>::find(
+    const KT &key) const {
+  return iterator(this, findIndex(key));
+}
+
+// Checks if there is an element with key equivalent to key in the container
+template <typename KT, typename VT, typename Compare>
+bool MappedMap<KT, VT, Compare>::contains(const KT &key) const {
+  return findIndex(key) != size_;
+}
+
+// Returns the number of elements with the key, zero or one
+template <typename KT, typename VT, typename Compare>
+typename MappedMap<KT, VT, Compare>::size_type
+MappedMap<KT, VT, Compare>::count(const KT &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+// Returns an iterator to the first element not less than key
+template <typename KT, typename VT, typename Compare>
+typename MappedMap<KT, VT, Compare>::iterator
+MappedMap<KT, VT, Compare>::lower_bound(const KT &key) const {
+  return iterator(this,
+                  branchlessLowerBound(keys_, size_, key, compare_) - keys_);
+}
+
+// Returns an iterator to the first element greater than key
+template <typename KT, typename VT, typename Compare>
+typename MappedMap<KT, VT, Compare>::iterator
+MappedMap<KT, VT, Compare>::upper_bound(const KT &key) const {
+  return iterator(this,
+                  branchlessUpperBound(keys_, size_, key, compare_) - keys_);
+}
+
+// Returns the range of elements with key, empty or a single one
+template <typename KT, typename VT, typename Compare>
+std::pair<typename MappedMap<KT, VT, Compare>::iterator,
+          typename MappedMap<KT, VT, Compare>::iterator>
+MappedMap<KT, VT, Compare>::equal_range(const KT &key) const {
+  iterator first = lower_bound(key);
+  iterator last = first;
+  if (last != end() && !compare_(key, last.first())) {
+    ++last;
+  }
+  return {first, last};
+}
+
+// Returns an iterator to the beginning
+template <typename KT, typename VT, typename Compare>
+typename MappedMap<KT, VT, Compare>::iterator
+MappedMap<KT, VT, Compare>::begin() const {
+  return iterator(this, 0);
+}
+
+// Returns an iterator to the end
+template <typename KT, typename VT, typename Compare>
+typename MappedMap<KT, VT, Compare>::iterator MappedMap<KT, VT, Compare>::end()
+    const {
+  return iterator(this, size_);
+}
+
+// Returns a reverse iterator to the last element
+template <typename KT, typename VT, typename Compare>
+typename MappedMap<KT, VT, Compare>::reverse_iterator
+MappedMap<KT, VT, Compare>::rbegin() const {
+  return reverse_iterator(end());
+}
+
+// Returns a reverse iterator before the first element
+template <typename KT, typename VT, typename Compare>
+typename MappedMap<KT, VT, Compare>::reverse_iterator
+MappedMap<KT, VT, Compare>::rend() const {
+  return reverse_iterator(begin());
+}
+
+// Checks whether the container is empty
+template <typename KT, typename VT, typename Compare>
+bool MappedMap<KT, VT, Compare>::empty() const noexcept {
+  return size_ == 0;
+}
+
+// Returns the number of elements
+template <typename KT, typename VT, typename Compare>
+typename MappedMap<KT, VT, Compare>::size_type
+MappedMap<KT, VT, Compare>::size() const noexcept {
+  return size_;
+}
+
+// Swaps the mappings. Iterators keep pointing into their own MappedMap
+template <typename KT, typename VT, typename Compare>
+void MappedMap<KT, VT, Compare>::swap(MappedMap &other) noexcept {
+  std::swap(file_, other.file_);
+  std::swap(compare_, other.compare_);
+  bind();
+  other.bind();
+}
+
+// Index of the element with key, or size() if there is none
+template <typename KT, typename VT, typename Compare>
+typename MappedMap<KT, VT, Compare>::size_type
+MappedMap<KT, VT, Compare>::findIndex(const KT &key) const {
+  const KT *it = branchlessLowerBound(keys_, size_, key, compare_);
+  if (it == keys_ + size_ || compare_(key, *it)) {
+    return size_;
+  }
+  return static_cast<size_type>(it - keys_);
+}
+
+// Points the arrays at the current mapping, empty after a move
+template <typename KT, typename VT, typename Compare>
+void MappedMap<KT, VT, Compare>::bind() {
+  if (!file_.mapped()) {
+    keys_ = nullptr;
+    values_ = nullptr;
+    size_ = 0;
+    return;
+  }
+  const SnapshotHeader &header = file_.header();
+  keys_ = static_cast<const KT *>(file_.at(header.keysOffset));
+  values_ = static_cast<const VT *>(file_.at(header.valuesOffset));
+  size_ = static_cast<size_type>(header.count);
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_MAP_S21_MAPPED_MAP_H_
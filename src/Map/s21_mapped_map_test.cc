@@ -0,0 +1,158 @@
+#include "s21_mapped_map.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "s21_flat_map.h"
+#include "s21_map.h"
+
+namespace {
+
+const std::string kPath = "s21_mapped_map_test.snapshot";
+
+struct Point {
+  double x;
+  double y;
+  std::int32_t id;
+};
+
+}  // namespace
+
+TEST(MappedMap, lookups_on_the_snapshot) {
+  s21::Map<int, double> source{{5, 0.5}, {1, 0.1}, {3, 0.3}};
+  s21::MappedMap<int, double>::save(source, kPath);
+  s21::MappedMap<int, double> map(kPath);
+  ASSERT_EQ(map.size(), 3U);
+  ASSERT_EQ(map.at(3), 0.3);
+  ASSERT_THROW(map.at(2), std::out_of_range);
+  ASSERT_TRUE(map.find(4) == map.end());
+  ASSERT_TRUE(map.upper_bound(5) == map.end());
+  auto range = map.equal_range(4);
+  ASSERT_TRUE(range.first == range.second);
+  ASSERT_EQ(range.first.first(), 5);
+  std::vector<int> keys;
+  for (auto it = map.rbegin(); it != map.rend(); ++it) {
+    keys.push_back(std::prev(it.base()).first());
+  }
+  ASSERT_EQ(keys, (std::vector<int>{5, 3, 1}));
+  std::remove(kPath.c_str());
+}
+
+TEST(MappedMap, layout_round_trip) {
+  // An odd count, so neither array ends on an alignment boundary, and a
+  // value type with padding
+  const int kCount = 1001;
+  {
+    s21::Map<std::int64_t, Point> source;
+    for (int i = 0; i < kCount; ++i) {
+      source.insert(i * 3 - 1500, Point{i * 0.5, -i * 0.25, i});
+    }
+    s21::MappedMap<std::int64_t, Point>::save(source, kPath);
+  }
+  {
+    s21::MappedMap<std::int64_t, Point> map(kPath);
+    ASSERT_EQ(map.size(), static_cast<size_t>(kCount));
+    auto address = [](const void *data) {
+      return reinterpret_cast<std::uintptr_t>(data);
+    };
+    ASSERT_EQ(address(&map.begin().first()) % 64, 0U);
+    ASSERT_EQ(address(&*map.begin()) % 64, 0U);
+    int i = 0;
+    for (auto it = map.begin(); it != map.end(); ++it, ++i) {
+      ASSERT_EQ(it.first(), i * 3 - 1500);
+      ASSERT_EQ(it.second().id, i);
+      ASSERT_EQ(it.second().y, -i * 0.25);
+    }
+    ASSERT_EQ(i, kCount);
+    // Keys between the stored ones, and past both ends
+    ASSERT_EQ(map.lower_bound(-2000).first(), -1500);
+    for (int j = 0; j + 1 < kCount; ++j) {
+      ASSERT_EQ(map.lower_bound(j * 3 - 1499).second().id, j + 1);
+      ASSERT_EQ(map.upper_bound(j * 3 - 1500).second().id, j + 1);
+    }
+    ASSERT_TRUE(map.lower_bound(kCount * 3) == map.end());
+  }
+  // A file cut short of the last value is rejected, not read past its end
+  std::string bytes;
+  {
+    std::ifstream in(kPath, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(in),
+                 std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream out(kPath, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 1));
+  }
+  ASSERT_THROW((s21::MappedMap<std::int64_t, Point>(kPath)),
+               std::runtime_error);
+  std::remove(kPath.c_str());
+}
+
+TEST(MappedMap, save_from_other_containers) {
+  s21::FlatMap<int, int> flat{{2, 20}, {1, 10}};
+  s21::MappedMap<int, int>::save(flat, kPath);
+  s21::MappedMap<int, int> map(kPath);
+  ASSERT_EQ(map.at(2), 20);
+  // Saving over a mapped snapshot replaces the file, the old mapping stays
+  const std::string copy = kPath + ".copy";
+  s21::MappedMap<int, int>::save(map, copy);
+  s21::Map<int, int> empty;
+  s21::MappedMap<int, int>::save(empty, kPath);
+  ASSERT_EQ(map.at(1), 10);
+  s21::MappedMap<int, int> reopened(copy);
+  ASSERT_EQ(reopened.size(), 2U);
+  ASSERT_EQ(reopened.at(1), 10);
+  s21::MappedMap<int, int> none(kPath);
+  ASSERT_TRUE(none.empty());
+  ASSERT_TRUE(none.begin() == none.end());
+  ASSERT_FALSE(none.contains(1));
+  s21::MappedMap<int, int> moved(std::move(reopened));
+  ASSERT_EQ(moved.at(2), 20);
+  ASSERT_TRUE(reopened.empty());
+  moved = std::move(none);
+  ASSERT_TRUE(moved.empty());
+  ASSERT_EQ(none.at(2), 20);
+  std::remove(kPath.c_str());
+  std::remove(copy.c_str());
+}
+
+TEST(MappedMap, rejects_bad_files) {
+  ASSERT_THROW((s21::MappedMap<int, int>("no/such/snapshot")),
+               std::system_error);
+  s21::Map<int, int> source{{1, 1}, {2, 2}};
+  ASSERT_THROW((s21::MappedMap<int, int>::save(source, "no/such/snapshot")),
+               std::system_error);
+  s21::MappedMap<int, int>::save(source, kPath);
+  ASSERT_THROW((s21::MappedMap<int, double>(kPath)), std::runtime_error);
+  ASSERT_THROW((s21::MappedMap<std::int64_t, int>(kPath)),
+               std::runtime_error);
+  // Keys out of order for the reader's Compare
+  ASSERT_THROW(
+      (s21::MappedMap<int, int, std::greater<int>>::save(source, kPath)),
+      std::invalid_argument);
+  s21::MappedMap<int, int> kept(kPath);
+  ASSERT_EQ(kept.size(), 2U);
+  {
+    std::ofstream out(kPath, std::ios::binary | std::ios::trunc);
+    out << "not a snapshot at all, but long enough to hold a header......";
+  }
+  ASSERT_THROW((s21::MappedMap<int, int>(kPath)), std::runtime_error);
+  {
+    std::ofstream out(kPath, std::ios::binary | std::ios::trunc);
+  }
+  ASSERT_THROW((s21::MappedMap<int, int>(kPath)), std::runtime_error);
+  std::remove(kPath.c_str());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,490 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_MAP_S21_PERSISTENT_MAP_H_
+#define CPP2_S21_CONTAINERS_SRC_MAP_S21_PERSISTENT_MAP_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ThreeWayCompare.h"
+
+namespace s21 {
+
+// Map whose copies are O(1) snapshots, as in a configuration that is
+// published every few seconds and read meanwhile. Versions share nodes: an
+// AVL tree without parent pointers, where each node counts the versions and
+// parents referring to it. insert and erase copy only the O(log n) nodes on
+// the path to the key that another version still refers to, nodes owned by
+// this version alone are updated in place. Shared nodes are never modified,
+// so different versions can be read, changed and destroyed on different
+// threads without locking. A single version is not safe to change and read
+// concurrently
+template <typename KT, typename VT, typename Compare = std::less<KT>>
+class PersistentMap : private CompareHolder<Compare> {
+  using key_type = KT;
+  using mapped_type = VT;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = size_t;
+
+ public:
+  class iterator;
+  using const_iterator = iterator;
+
+  PersistentMap();
+  explicit PersistentMap(std::initializer_list<value_type> const &items);
+  PersistentMap(const PersistentMap &other);
+  PersistentMap(PersistentMap &&other) noexcept;
+  ~PersistentMap();
+  PersistentMap &operator=(const PersistentMap &other);
+  PersistentMap &operator=(PersistentMap &&other) noexcept;
+
+  PersistentMap snapshot() const;
+
+  const VT &at(const KT &key) const;
+  iterator find(const KT &key) const;
+  bool contains(const KT &key) const;
+  iterator begin() const;
+  iterator end() const;
+
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+
+  bool insert(const KT &key, const VT &value);
+  bool insert_or_assign(const KT &key, const VT &value);
+  size_type erase(const KT &key);
+  void clear();
+  void swap(PersistentMap &other) noexcept;
+
+ private:
+  // Nodes are allocated one by one rather than from a NodePool, since the
+  // last version referring to a node may be destroyed on any thread
+  struct Node {
+    KT key;
+    VT value;
+    const Node *left;
+    const Node *right;
+    int height;
+    mutable std::atomic<int> refs;
+
+    Node(const KT &key, const VT &value, const Node *left, const Node *right)
+        : key(key), value(value), left(left), right(right), height(1),
+          refs(1) {}
+  };
+
+  using compare_type = ThreeWayCompare<KT, Compare>;
+
+  const Node *root_;
+  size_type size_;
+
+  // Functions below that take a node consume one reference to it, and the
+  // nodes they return carry one
+  static const Node *retain(const Node *node);
+  static void release(const Node *node);
+  static Node *writable(const Node *node);
+  static int heightOf(const Node *node);
+  static Node *rebalance(Node *node);
+  static Node *rotateLeft(Node *node);
+  static Node *rotateRight(Node *node);
+  const Node *insertAt(const Node *node, const KT &key, const VT &value,
+                       bool &inserted) const;
+  const Node *eraseAt(const Node *node, const KT &key) const;
+  static const Node *takeMin(const Node *node, const Node *&min);
+  const Node *findNode(const KT &key) const;
+};
+
+// In-order iterator keeping the path of nodes still to visit. It refers to
+// the version it came from and stays valid as long as that version is
+// neither changed nor destroyed
+template <typename KT, typename VT, typename Compare>
+class PersistentMap<KT, VT, Compare>::iterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = VT;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const VT *;
+  using reference = const VT &;
+
+  iterator() = default;
+
+  iterator &operator++() {
+    const Node *node = path_.back();
+    path_.pop_back();
+    descendLeft(node->right);
+    return *this;
+  }
+
+  iterator operator++(int) {
+    iterator old = *this;
+    ++*this;
+    return old;
+  }
+
+  const VT &operator*() const { return path_.back()->value; }
+
+  bool operator==(const iterator &other) const {
+    if (path_.empty() || other.path_.empty()) {
+      return path_.empty() == other.path_.empty();
+    }
+    return path_.back() == other.path_.back();
+  }
+
+  bool operator!=(const iterator &other) const { return !(*this == other); }
+
+  const KT &first() const { return path_.back()->key; }
+  const VT &second() const { return path_.back()->value; }
+
+ private:
+  friend class PersistentMap;
+
+  void descendLeft(const Node *node) {
+    for (; node; node = node->left) {
+      path_.push_back(node);
+    }
+  }
+
+  std::vector<const Node *> path_;
+};
+
+template <typename KT, typename VT, typename Compare>
+PersistentMap<KT, VT, Compare>::PersistentMap() : root_(nullptr), size_(0) {}
+
+template <typename KT, typename VT, typename Compare>
+PersistentMap<KT, VT, Compare>::PersistentMap(
+    std::initializer_list<value_type> const &items)
+    : PersistentMap() {
+  for (const value_type &item : items) {
+    insert(item.first, item.second);
+  }
+}
+
+// A snapshot: both versions share every node until one of them changes
+template <typename KT, typename VT, typename Compare>
+PersistentMap<KT, VT, Compare>::PersistentMap(const PersistentMap &other)
+    : CompareHolder<Compare>(other),
+      root_(retain(other.root_)),
+      size_(other.size_) {}
+
+template <typename KT, typename VT, typename Compare>
+PersistentMap<KT, VT, Compare>::PersistentMap(PersistentMap &&other) noexcept
+    : CompareHolder<Compare>(other), root_(other.root_), size_(other.size_) {
+  other.root_ = nullptr;
+  other.size_ = 0;
+}
+
+template <typename KT, typename VT, typename Compare>
+PersistentMap<KT, VT, Compare>::~PersistentMap() {
+  release(root_);
+}
+
+template <typename KT, typename VT, typename Compare>
+PersistentMap<KT, VT, Compare> &PersistentMap<KT, VT, Compare>::operator=(
+    const PersistentMap &other) {
+  const Node *old = root_;
+  CompareHolder<Compare>::operator=(other);
+  root_ = retain(other.root_);
+  size_ = other.size_;
+  release(old);
+  return *this;
+}
+
+template <typename KT, typename VT, typename Compare>
+PersistentMap<KT, VT, Compare> &PersistentMap<KT, VT, Compare>::operator=(
+    PersistentMap &&other) noexcept {
+  if (this != &other) {
+    PersistentMap(std::move(other)).swap(*this);
+  }
+  return *this;
+}
+
+// The current version, which later changes to this map do not affect
+template <typename KT, typename VT, typename Compare>
+PersistentMap<KT, VT, Compare> PersistentMap<KT, VT, Compare>::snapshot()
+    const {
+  return *this;
+}
+
+template <typename KT, typename VT, typename Compare>
+const VT &PersistentMap<KT, VT, Compare>::at(const KT &key) const {
+  const Node *node = findNode(key);
+  if (!node) {
+    throw std::out_of_range("PersistentMap::at: key not found");
+  }
+  return node->value;
+}
+
+// Keeps the nodes the search went left at, which come after the key
+template <typename KT, typename VT, typename Compare>
+typename PersistentMap<KT, VT, Compare>::iterator
+PersistentMap<KT, VT, Compare>::find(const KT &key) const {
+  iterator result;
+  for (const Node *node = root_; node;) {
+    int order = compare_type::compare(this->keyCompare(), key, node->key);
+    if (order == 0) {
+      result.path_.push_back(node);
+      return result;
+    }
+    if (order < 0) {
+      result.path_.push_back(node);
+      node = node->left;
+    } else {
+      node = node->right;
+    }
+  }
+  return end();
+}
+
+template <typename KT, typename VT, typename Compare>
+bool PersistentMap<KT, VT, Compare>::contains(const KT &key) const {
+  return findNode(key) != nullptr;
+}
+
+template <typename KT, typename VT, typename Compare>
+typename PersistentMap<KT, VT, Compare>::iterator
+PersistentMap<KT, VT, Compare>::begin() const {
+  iterator result;
+  result.descendLeft(root_);
+  return result;
+}
+
+template <typename KT, typename VT, typename Compare>
+typename PersistentMap<KT, VT, Compare>::iterator
+PersistentMap<KT, VT, Compare>::end() const {
+  return iterator();
+}
+
+template <typename KT, typename VT, typename Compare>
+bool PersistentMap<KT, VT, Compare>::empty() const noexcept {
+  return size_ == 0;
+}
+
+template <typename KT, typename VT, typename Compare>
+typename PersistentMap<KT, VT, Compare>::size_type
+PersistentMap<KT, VT, Compare>::size() const noexcept {
+  return size_;
+}
+
+// Inserts the element unless the key is present, which leaves every node
+// shared
+template <typename KT, typename VT, typename Compare>
+bool PersistentMap<KT, VT, Compare>::insert(const KT &key, const VT &value) {
+  if (findNode(key)) {
+    return false;
+  }
+  bool inserted = false;
+  root_ = insertAt(root_, key, value, inserted);
+  ++size_;
+  return true;
+}
+
+// Inserts the element or overwrites the value of a present key, returns
+// whether the key was new
+template <typename KT, typename VT, typename Compare>
+bool PersistentMap<KT, VT, Compare>::insert_or_assign(const KT &key,
+                                                      const VT &value) {
+  bool inserted = false;
+  root_ = insertAt(root_, key, value, inserted);
+  size_ += inserted;
+  return inserted;
+}
+
+template <typename KT, typename VT, typename Compare>
+typename PersistentMap<KT, VT, Compare>::size_type
+PersistentMap<KT, VT, Compare>::erase(const KT &key) {
+  if (!findNode(key)) {
+    return 0;
+  }
+  root_ = eraseAt(root_, key);
+  --size_;
+  return 1;
+}
+
+// Drops this version's nodes, snapshots keep theirs
+template <typename KT, typename VT, typename Compare>
+void PersistentMap<KT, VT, Compare>::clear() {
+  release(root_);
+  root_ = nullptr;
+  size_ = 0;
+}
+
+template <typename KT, typename VT, typename Compare>
+void PersistentMap<KT, VT, Compare>::swap(PersistentMap &other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(size_, other.size_);
+  this->swapCompare(other);
+}
+
+template <typename KT, typename VT, typename Compare>
+const typename PersistentMap<KT, VT, Compare>::Node *
+PersistentMap<KT, VT, Compare>::retain(const Node *node) {
+  if (node) {
+    node->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+  return node;
+}
+
+// Frees the node once no version or parent refers to it, and with it the
+// references it holds to its children
+template <typename KT, typename VT, typename Compare>
+void PersistentMap<KT, VT, Compare>::release(const Node *node) {
+  if (node && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    release(node->left);
+    release(node->right);
+    delete node;
+  }
+}
+
+// The node itself when nothing else refers to it, since then nobody else can
+// start referring to it either, otherwise a private copy
+template <typename KT, typename VT, typename Compare>
+typename PersistentMap<KT, VT, Compare>::Node *
+PersistentMap<KT, VT, Compare>::writable(const Node *node) {
+  if (node->refs.load(std::memory_order_acquire) == 1) {
+    return const_cast<Node *>(node);
+  }
+  Node *copy = new Node(node->key, node->value, retain(node->left),
+                        retain(node->right));
+  copy->height = node->height;
+  release(node);
+  return copy;
+}
+
+template <typename KT, typename VT, typename Compare>
+int PersistentMap<KT, VT, Compare>::heightOf(const Node *node) {
+  return node ? node->height : 0;
+}
+
+// Restores the AVL invariant at node, whose subtrees differ in height by at
+// most two
+template <typename KT, typename VT, typename Compare>
+typename PersistentMap<KT, VT, Compare>::Node *
+PersistentMap<KT, VT, Compare>::rebalance(Node *node) {
+  int balance = heightOf(node->left) - heightOf(node->right);
+  if (balance > 1) {
+    if (heightOf(node->left->left) < heightOf(node->left->right)) {
+      node->left = rotateLeft(writable(node->left));
+    }
+    return rotateRight(node);
+  }
+  if (balance < -1) {
+    if (heightOf(node->right->right) < heightOf(node->right->left)) {
+      node->right = rotateRight(writable(node->right));
+    }
+    return rotateLeft(node);
+  }
+  node->height = std::max(heightOf(node->left), heightOf(node->right)) + 1;
+  return node;
+}
+
+template <typename KT, typename VT, typename Compare>
+typename PersistentMap<KT, VT, Compare>::Node *
+PersistentMap<KT, VT, Compare>::rotateLeft(Node *node) {
+  Node *right = writable(node->right);
+  node->right = right->left;
+  node->height = std::max(heightOf(node->left), heightOf(node->right)) + 1;
+  right->left = node;
+  right->height = std::max(heightOf(right->left), heightOf(right->right)) + 1;
+  return right;
+}
+
+template <typename KT, typename VT, typename Compare>
+typename PersistentMap<KT, VT, Compare>::Node *
+PersistentMap<KT, VT, Compare>::rotateRight(Node *node) {
+  Node *left = writable(node->left);
+  node->left = left->right;
+  node->height = std::max(heightOf(node->left), heightOf(node->right)) + 1;
+  left->right = node;
+  left->height = std::max(heightOf(left->left), heightOf(left->right)) + 1;
+  return left;
+}
+
+template <typename KT, typename VT, typename Compare>
+const typename PersistentMap<KT, VT, Compare>::Node *
+PersistentMap<KT, VT, Compare>::insertAt(const Node *node, const KT &key,
+                                         const VT &value,
+                                         bool &inserted) const {
+  if (!node) {
+    inserted = true;
+    return new Node(key, value, nullptr, nullptr);
+  }
+  int order = compare_type::compare(this->keyCompare(), key, node->key);
+  Node *result = writable(node);
+  if (order == 0) {
+    result->value = value;
+    return result;
+  }
+  if (order < 0) {
+    result->left = insertAt(result->left, key, value, inserted);
+  } else {
+    result->right = insertAt(result->right, key, value, inserted);
+  }
+  return rebalance(result);
+}
+
+// key has to be present
+template <typename KT, typename VT, typename Compare>
+const typename PersistentMap<KT, VT, Compare>::Node *
+PersistentMap<KT, VT, Compare>::eraseAt(const Node *node,
+                                        const KT &key) const {
+  int order = compare_type::compare(this->keyCompare(), key, node->key);
+  if (order != 0) {
+    Node *result = writable(node);
+    if (order < 0) {
+      result->left = eraseAt(result->left, key);
+    } else {
+      result->right = eraseAt(result->right, key);
+    }
+    return rebalance(result);
+  }
+  if (!node->left || !node->right) {
+    const Node *child = retain(node->left ? node->left : node->right);
+    release(node);
+    return child;
+  }
+  // The successor takes the node's place. Keys need not be assignable, so
+  // the place gets a new node that inherits the children
+  Node *old = writable(node);
+  const Node *min = nullptr;
+  const Node *right = takeMin(old->right, min);
+  Node *result = new Node(min->key, min->value, old->left, right);
+  old->left = nullptr;
+  old->right = nullptr;
+  release(old);
+  release(min);
+  return rebalance(result);
+}
+
+// Detaches the leftmost node of the subtree, passing a reference to it in min
+template <typename KT, typename VT, typename Compare>
+const typename PersistentMap<KT, VT, Compare>::Node *
+PersistentMap<KT, VT, Compare>::takeMin(const Node *node, const Node *&min) {
+  if (!node->left) {
+    min = node;
+    return retain(node->right);
+  }
+  Node *result = writable(node);
+  result->left = takeMin(result->left, min);
+  return rebalance(result);
+}
+
+template <typename KT, typename VT, typename Compare>
+const typename PersistentMap<KT, VT, Compare>::Node *
+PersistentMap<KT, VT, Compare>::findNode(const KT &key) const {
+  const Node *node = root_;
+  while (node) {
+    int order = compare_type::compare(this->keyCompare(), key, node->key);
+    if (order == 0) {
+      return node;
+    }
+    node = order < 0 ? node->left : node->right;
+  }
+  return nullptr;
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_MAP_S21_PERSISTENT_MAP_H_
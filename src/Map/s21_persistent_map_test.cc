@@ -0,0 +1,163 @@
+#include "s21_persistent_map.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Contents of one version, which has to iterate in ascending key order
+std::map<int, int> contents(const s21::PersistentMap<int, int> &version) {
+  std::map<int, int> items;
+  for (auto it = version.begin(); it != version.end(); ++it) {
+    if (!items.empty() && items.rbegin()->first >= it.first()) {
+      ADD_FAILURE() << "key " << it.first() << " out of order";
+    }
+    items.emplace_hint(items.end(), it.first(), *it);
+  }
+  EXPECT_EQ(items.size(), version.size());
+  return items;
+}
+
+}  // namespace
+
+TEST(PersistentMap, basic_operations) {
+  s21::PersistentMap<int, std::string> map{{2, "two"}, {1, "one"}};
+  ASSERT_EQ(map.size(), 2U);
+  ASSERT_TRUE(map.insert(3, "three"));
+  ASSERT_FALSE(map.insert(3, "drei"));
+  ASSERT_EQ(map.at(3), "three");
+  ASSERT_FALSE(map.insert_or_assign(3, "drei"));
+  ASSERT_EQ(map.at(3), "drei");
+  ASSERT_THROW(map.at(4), std::out_of_range);
+  ASSERT_TRUE(map.contains(1));
+  ASSERT_EQ(*map.find(2), "two");
+  ASSERT_TRUE(map.find(5) == map.end());
+  ASSERT_EQ(map.erase(1), 1U);
+  ASSERT_EQ(map.erase(1), 0U);
+  ASSERT_EQ(map.begin().first(), 2);
+  map.clear();
+  ASSERT_TRUE(map.empty());
+  ASSERT_TRUE(map.begin() == map.end());
+}
+
+TEST(PersistentMap, branches_are_isolated) {
+  s21::PersistentMap<int, int> base;
+  for (int key = 0; key < 1000; ++key) {
+    base.insert(key, key);
+  }
+  std::map<int, int> original = contents(base);
+  // Two branches share every node with base until they are written
+  s21::PersistentMap<int, int> odd = base.snapshot();
+  s21::PersistentMap<int, int> doubled = base.snapshot();
+  std::map<int, int> expectedOdd = original;
+  std::map<int, int> expectedDoubled = original;
+  for (int key = 0; key < 1000; key += 2) {
+    ASSERT_EQ(odd.erase(key), 1U);
+    expectedOdd.erase(key);
+  }
+  for (int key = 0; key < 1000; ++key) {
+    ASSERT_FALSE(doubled.insert_or_assign(key, key * 2));
+    expectedDoubled[key] = key * 2;
+  }
+  ASSERT_EQ(contents(base), original);
+  ASSERT_EQ(contents(odd), expectedOdd);
+  ASSERT_EQ(contents(doubled), expectedDoubled);
+  // With base gone each branch owns its nodes alone and is updated in place
+  base.clear();
+  for (int key = 1000; key < 1500; ++key) {
+    ASSERT_TRUE(odd.insert(key, -key));
+    expectedOdd[key] = -key;
+  }
+  ASSERT_EQ(odd.erase(1), 1U);
+  expectedOdd.erase(1);
+  ASSERT_EQ(contents(odd), expectedOdd);
+  ASSERT_EQ(contents(doubled), expectedDoubled);
+  // A copy assigned over a branch leaves the branch it replaced intact
+  s21::PersistentMap<int, int> kept = doubled;
+  doubled = odd;
+  ASSERT_EQ(contents(kept), expectedDoubled);
+  ASSERT_EQ(contents(doubled), expectedOdd);
+  ASSERT_EQ(odd.find(expectedOdd.begin()->first).first(), 3);
+}
+
+TEST(PersistentMap, snapshots_are_unaffected) {
+  s21::PersistentMap<int, int> map;
+  std::vector<s21::PersistentMap<int, int>> versions;
+  std::vector<std::map<int, int>> expected;
+  std::map<int, int> current;
+  for (int i = 0; i < 3000; ++i) {
+    int key = (i * 37) % 500;
+    if (i % 4 == 3) {
+      map.erase(key);
+      current.erase(key);
+    } else {
+      map.insert_or_assign(key, i);
+      current[key] = i;
+    }
+    if (i % 100 == 0) {
+      versions.push_back(map.snapshot());
+      expected.push_back(current);
+    }
+  }
+  ASSERT_EQ(contents(map), current);
+  for (size_t v = 0; v < versions.size(); ++v) {
+    ASSERT_EQ(contents(versions[v]), expected[v]);
+  }
+  s21::PersistentMap<int, int> copy(versions[5]);
+  copy.insert_or_assign(-1, -1);
+  copy.erase(expected[5].begin()->first);
+  ASSERT_EQ(contents(versions[5]), expected[5]);
+  versions.clear();
+  ASSERT_EQ(contents(map), current);
+}
+
+TEST(PersistentMap, readers_on_published_versions) {
+  using Version = s21::PersistentMap<int, int>;
+  std::mutex mutex;
+  auto published = std::make_shared<const Version>();
+  std::atomic<bool> done(false);
+  std::atomic<int> wrong(0);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 3; ++t) {
+    readers.emplace_back([&] {
+      while (!done) {
+        std::shared_ptr<const Version> version;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          version = published;
+        }
+        int expected = 0;
+        for (auto it = version->begin(); it != version->end(); ++it) {
+          wrong += it.first() != expected || *it != expected;
+          ++expected;
+        }
+        wrong += static_cast<size_t>(expected) != version->size();
+      }
+    });
+  }
+  Version writer;
+  for (int i = 0; i < 2000; ++i) {
+    writer.insert(i, i);
+    auto next = std::make_shared<const Version>(writer.snapshot());
+    std::lock_guard<std::mutex> lock(mutex);
+    published = next;
+  }
+  done = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  ASSERT_EQ(wrong, 0);
+  ASSERT_EQ(published->size(), 2000U);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,319 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_MAP_S21_RADIX_MAP_H_
+#define CPP2_S21_CONTAINERS_SRC_MAP_S21_RADIX_MAP_H_
+
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "RadixTree.h"
+
+namespace s21 {
+
+// Ordered map on an adaptive radix tree, a drop-in for Map with std::string
+// or integer keys. A lookup reads each key byte once on the way down instead
+// of comparing whole keys at every level, so long keys with shared prefixes,
+// like URLs, cost O(key length) rather than O(key length * log n). Keys are
+// ordered as by std::less: strings bytewise, integers numerically.
+// prefix_range() returns the keys starting with a string in one descent.
+// Iterators stay valid until their element is erased
+template <typename KT, typename VT>
+class RadixMap {
+  using key_type = KT;
+  using mapped_type = VT;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using tree_type = RadixTree<KT, VT>;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+
+ public:
+  using iterator = typename tree_type::iterator;
+  using const_iterator = iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  RadixMap();
+  explicit RadixMap(std::initializer_list<value_type> const &items);
+  RadixMap(const RadixMap &other);
+  RadixMap(RadixMap &&other) noexcept;
+  RadixMap &operator=(const RadixMap &other);
+  RadixMap &operator=(RadixMap &&other) noexcept;
+
+  VT &at(const KT &key);
+  VT &operator[](const KT &key);
+  VT &operator[](KT &&key);
+  iterator find(const KT &key);
+  bool contains(const KT &key);
+  size_type count(const KT &key);
+  iterator lower_bound(const KT &key);
+  iterator upper_bound(const KT &key);
+  std::pair<iterator, iterator> equal_range(const KT &key);
+  std::pair<iterator, iterator> prefix_range(std::string_view prefix);
+
+  iterator begin();
+  iterator end();
+  reverse_iterator rbegin();
+  reverse_iterator rend();
+
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+
+  void clear();
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  std::pair<iterator, bool> insert(const KT &key, const VT &value);
+  std::pair<iterator, bool> insert_or_assign(const KT &key, const VT &value);
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const KT &key, Args &&...args);
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(KT &&key, Args &&...args);
+  void erase(iterator pos);
+  size_type erase(const KT &key);
+  void swap(RadixMap &other) noexcept;
+
+ private:
+  tree_type tree_;
+};
+
+// Default constructor, creates empty RadixMap
+template <typename KT, typename VT>
+RadixMap<KT, VT>::RadixMap() : tree_() {}
+
+// Initializer list constructor, later duplicates of a key are ignored
+template <typename KT, typename VT>
+RadixMap<KT, VT>::RadixMap(std::initializer_list<value_type> const &items)
+    : tree_() {
+  for (const auto &item : items) {
+    insert(item);
+  }
+}
+
+// Copy constructor
+template <typename KT, typename VT>
+RadixMap<KT, VT>::RadixMap(const RadixMap &other) : tree_() {
+  tree_.assign(other.tree_);
+}
+
+// Move constructor
+template <typename KT, typename VT>
+RadixMap<KT, VT>::RadixMap(RadixMap &&other) noexcept
+    : tree_(std::move(other.tree_)) {}
+
+// Assignment operator overload for copy object
+template <typename KT, typename VT>
+RadixMap<KT, VT> &RadixMap<KT, VT>::operator=(const RadixMap &other) {
+  tree_.assign(other.tree_);
+  return *this;
+}
+
+// Assignment operator overload for moving object
+template <typename KT, typename VT>
+RadixMap<KT, VT> &RadixMap<KT, VT>::operator=(RadixMap &&other) noexcept {
+  if (this != &other) {
+    tree_.swap(other.tree_);
+  }
+  return *this;
+}
+
+// Access specified element with bounds checking
+template <typename KT, typename VT>
+VT &RadixMap<KT, VT>::at(const KT &key) {
+  iterator it = tree_.search(key);
+  if (it == tree_.end()) {
+    throw std::out_of_range("s21::RadixMap::at");
+  }
+  return *it;
+}
+
+// Access or insert specified element, in one descent
+template <typename KT, typename VT>
+VT &RadixMap<KT, VT>::operator[](const KT &key) {
+  return tree_.emplaceUnique(key).first.second();
+}
+
+// Like operator[] for a temporary key, which is moved into the new element
+template <typename KT, typename VT>
+VT &RadixMap<KT, VT>::operator[](KT &&key) {
+  return tree_.emplaceUnique(std::move(key)).first.second();
+}
+
+// Find element by key
+template <typename KT, typename VT>
+typename RadixMap<KT, VT>::iterator RadixMap<KT, VT>::find(const KT &key) {
+  return tree_.search(key);
+}
+
+// Checks if there is an element with key equivalent to key in the container
+template <typename KT, typename VT>
+bool RadixMap<KT, VT>::contains(const KT &key) {
+  return tree_.search(key) != tree_.end();
+}
+
+// Returns the number of elements with the key, zero or one
+template <typename KT, typename VT>
+typename RadixMap<KT, VT>::size_type RadixMap<KT, VT>::count(const KT &key) {
+  return contains(key) ? 1 : 0;
+}
+
+// Returns an iterator to the first element not less than key
+template <typename KT, typename VT>
+typename RadixMap<KT, VT>::iterator RadixMap<KT, VT>::lower_bound(
+    const KT &key) {
+  return tree_.lowerBound(key);
+}
+
+// Returns an iterator to the first element greater than key
+template <typename KT, typename VT>
+typename RadixMap<KT, VT>::iterator RadixMap<KT, VT>::upper_bound(
+    const KT &key) {
+  return tree_.upperBound(key);
+}
+
+// Returns the range of elements with key, empty or a single one
+template <typename KT, typename VT>
+std::pair<typename RadixMap<KT, VT>::iterator,
+          typename RadixMap<KT, VT>::iterator>
+RadixMap<KT, VT>::equal_range(const KT &key) {
+  iterator first = tree_.lowerBound(key);
+  iterator last = first;
+  if (last != tree_.end() && tree_.search(key) == last) {
+    ++last;
+  }
+  return {first, last};
+}
+
+// Returns the elements whose key starts with prefix, in key order. Integer
+// keys are matched on their big-endian bytes
+template <typename KT, typename VT>
+std::pair<typename RadixMap<KT, VT>::iterator,
+          typename RadixMap<KT, VT>::iterator>
+RadixMap<KT, VT>::prefix_range(std::string_view prefix) {
+  return tree_.prefixRange(prefix);
+}
+
+// Returns an iterator to the beginning
+template <typename KT, typename VT>
+typename RadixMap<KT, VT>::iterator RadixMap<KT, VT>::begin() {
+  return tree_.begin();
+}
+
+// Returns an iterator to the end
+template <typename KT, typename VT>
+typename RadixMap<KT, VT>::iterator RadixMap<KT, VT>::end() {
+  return tree_.end();
+}
+
+// Returns a reverse iterator to the last element
+template <typename KT, typename VT>
+typename RadixMap<KT, VT>::reverse_iterator RadixMap<KT, VT>::rbegin() {
+  return reverse_iterator(end());
+}
+
+// Returns a reverse iterator before the first element
+template <typename KT, typename VT>
+typename RadixMap<KT, VT>::reverse_iterator RadixMap<KT, VT>::rend() {
+  return reverse_iterator(begin());
+}
+
+// Checks whether the container is empty
+template <typename KT, typename VT>
+bool RadixMap<KT, VT>::empty() const noexcept {
+  return tree_.size() == 0;
+}
+
+// Returns the number of elements
+template <typename KT, typename VT>
+typename RadixMap<KT, VT>::size_type RadixMap<KT, VT>::size() const noexcept {
+  return tree_.size();
+}
+
+// Returns the maximum possible number of elements
+template <typename KT, typename VT>
+typename RadixMap<KT, VT>::size_type RadixMap<KT, VT>::max_size()
+    const noexcept {
+  return std::numeric_limits<difference_type>::max() / (sizeof(value_type) +
+                                                        3 * sizeof(void *));
+}
+
+// Clears the contents
+template <typename KT, typename VT>
+void RadixMap<KT, VT>::clear() {
+  tree_.clear();
+}
+
+// Inserts value and returns iterator to where the element is in the
+// container and bool denoting whether the insertion took place
+template <typename KT, typename VT>
+std::pair<typename RadixMap<KT, VT>::iterator, bool> RadixMap<KT, VT>::insert(
+    const value_type &value) {
+  return tree_.emplaceUnique(value.first, value.second);
+}
+
+// Inserts a temporary element, moving its value into the leaf. The key of a
+// value_type is const and still gets copied
+template <typename KT, typename VT>
+std::pair<typename RadixMap<KT, VT>::iterator, bool> RadixMap<KT, VT>::insert(
+    value_type &&value) {
+  return tree_.emplaceUnique(value.first, std::move(value.second));
+}
+
+// Inserts value by key unless the key is present
+template <typename KT, typename VT>
+std::pair<typename RadixMap<KT, VT>::iterator, bool> RadixMap<KT, VT>::insert(
+    const KT &key, const VT &value) {
+  return tree_.emplaceUnique(key, value);
+}
+
+// Inserts an element or assigns to the current one if the key already
+// exists. The bool tells whether the key was new
+template <typename KT, typename VT>
+std::pair<typename RadixMap<KT, VT>::iterator, bool>
+RadixMap<KT, VT>::insert_or_assign(const KT &key, const VT &value) {
+  auto result = tree_.emplaceUnique(key, value);
+  if (!result.second) {
+    *result.first = value;
+  }
+  return result;
+}
+
+// Constructs the value from args in a new leaf if the key is missing
+template <typename KT, typename VT>
+template <class... Args>
+std::pair<typename RadixMap<KT, VT>::iterator, bool>
+RadixMap<KT, VT>::try_emplace(const KT &key, Args &&...args) {
+  return tree_.emplaceUnique(key, std::forward<Args>(args)...);
+}
+
+// try_emplace for a temporary key, which is moved only if it gets inserted
+template <typename KT, typename VT>
+template <class... Args>
+std::pair<typename RadixMap<KT, VT>::iterator, bool>
+RadixMap<KT, VT>::try_emplace(KT &&key, Args &&...args) {
+  return tree_.emplaceUnique(std::move(key), std::forward<Args>(args)...);
+}
+
+// Removes the element at pos
+template <typename KT, typename VT>
+void RadixMap<KT, VT>::erase(iterator pos) {
+  tree_.erase(pos.first());
+}
+
+// Removes the element with key and returns how many were removed
+template <typename KT, typename VT>
+typename RadixMap<KT, VT>::size_type RadixMap<KT, VT>::erase(const KT &key) {
+  return tree_.erase(key);
+}
+
+// Swaps the contents
+template <typename KT, typename VT>
+void RadixMap<KT, VT>::swap(RadixMap &other) noexcept {
+  tree_.swap(other.tree_);
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_MAP_S21_RADIX_MAP_H_
@@ -0,0 +1,263 @@
+#include "s21_radix_map.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// Keys of the map in iteration order
+template <class VT>
+std::vector<std::string> keysOf(s21::RadixMap<std::string, VT> &map) {
+  std::vector<std::string> keys;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    keys.push_back(it.first());
+  }
+  return keys;
+}
+
+// Checks the map against the keys it should hold, in order and by lookup
+void assertHolds(s21::RadixMap<std::string, int> &map,
+                 const std::set<std::string> &expected) {
+  ASSERT_EQ(keysOf(map),
+            std::vector<std::string>(expected.begin(), expected.end()));
+  for (const std::string &key : expected) {
+    ASSERT_TRUE(map.contains(key)) << key;
+  }
+}
+
+// Value whose copies throw while fail is set
+struct Fragile {
+  static bool fail;
+  int id = 0;
+
+  Fragile() = default;
+  explicit Fragile(int id) : id(id) {}
+  Fragile(const Fragile &other) : id(other.id) {
+    if (fail) {
+      throw std::runtime_error("copy");
+    }
+  }
+  Fragile &operator=(const Fragile &) = default;
+};
+
+bool Fragile::fail = false;
+
+}  // namespace
+
+TEST(RadixMap, keys_that_prefix_each_other) {
+  s21::RadixMap<std::string, int> map{{"car", 1}, {"cart", 2}, {"ca", 3}};
+  map[""] = 4;
+  ASSERT_THROW(map.at("c"), std::out_of_range);
+  ASSERT_TRUE(map.find("care") == map.end());
+  ASSERT_EQ(map.lower_bound("card").first(), "cart");
+  ASSERT_EQ(map.upper_bound("car").first(), "cart");
+  std::vector<std::string> keys;
+  for (auto it = map.rbegin(); it != map.rend(); ++it) {
+    keys.push_back(std::prev(it.base()).first());
+  }
+  ASSERT_EQ(keys, (std::vector<std::string>{"cart", "car", "ca", ""}));
+  // Erasing a key that is a prefix of another keeps both neighbours
+  ASSERT_EQ(map.erase("car"), 1U);
+  ASSERT_EQ(map.at("cart"), 2);
+  ASSERT_EQ(map.at("ca"), 3);
+  ASSERT_EQ(map.at(""), 4);
+}
+
+TEST(RadixMap, prefixes_longer_than_stored) {
+  // Only the first bytes of a compressed path are kept in the node, so keys
+  // that split or miss past them are told apart at the leaves
+  const std::string stem(40, 'p');
+  std::set<std::string> expected{stem,
+                                 stem + "a",
+                                 stem + "ab",
+                                 stem + "b",
+                                 stem.substr(0, 25) + "x",
+                                 stem.substr(0, 5) + "y",
+                                 stem + std::string(100, 'q') + "1",
+                                 stem + std::string(100, 'q') + "2"};
+  s21::RadixMap<std::string, int> map;
+  int value = 0;
+  for (const std::string &key : expected) {
+    ASSERT_TRUE(map.insert(key, ++value).second);
+  }
+  assertHolds(map, expected);
+  std::vector<std::string> misses{stem.substr(0, 30) + "a",
+                                  stem.substr(0, 12),
+                                  stem + std::string(100, 'q'),
+                                  stem + std::string(99, 'q') + "r",
+                                  stem.substr(0, 25) + "w"};
+  for (const std::string &key : misses) {
+    ASSERT_FALSE(map.contains(key)) << key;
+    auto lower = expected.lower_bound(key);
+    auto it = map.lower_bound(key);
+    ASSERT_EQ(it == map.end(), lower == expected.end());
+    if (lower != expected.end()) {
+      ASSERT_EQ(it.first(), *lower);
+    }
+  }
+  // Erasing merges single-child nodes back into long paths
+  ASSERT_EQ(map.erase(stem.substr(0, 5) + "y"), 1U);
+  expected.erase(stem.substr(0, 5) + "y");
+  ASSERT_EQ(map.erase(stem + "a"), 1U);
+  expected.erase(stem + "a");
+  ASSERT_EQ(map.erase(stem), 1U);
+  expected.erase(stem);
+  assertHolds(map, expected);
+  ASSERT_TRUE(map.insert(stem.substr(0, 35) + "z", 0).second);
+  expected.insert(stem.substr(0, 35) + "z");
+  assertHolds(map, expected);
+}
+
+TEST(RadixMap, nul_and_high_bytes) {
+  std::set<std::string> expected{"",
+                                 std::string(1, '\0'),
+                                 std::string(2, '\0'),
+                                 "a",
+                                 std::string("a\0", 2),
+                                 std::string("a\0\0", 3),
+                                 "a\xff",
+                                 "a\xff\xff",
+                                 "\x7f",
+                                 "\x80",
+                                 "\xff",
+                                 std::string("\xff\0", 2)};
+  s21::RadixMap<std::string, int> map;
+  for (auto it = expected.rbegin(); it != expected.rend(); ++it) {
+    ASSERT_TRUE(map.insert(*it, 0).second);
+  }
+  // Bytes above 127 order after the rest, as std::string compares them
+  assertHolds(map, expected);
+  ASSERT_EQ(map.upper_bound("a").first(), std::string("a\0", 2));
+  ASSERT_EQ(map.lower_bound("a\x01").first(), "a\xff");
+  ASSERT_EQ(map.upper_bound("\x80").first(), "\xff");
+  ASSERT_TRUE(map.upper_bound(std::string("\xff\0", 2)) == map.end());
+  auto range = map.prefix_range(std::string_view("a\0", 2));
+  ASSERT_EQ(range.first.first(), std::string("a\0", 2));
+  ASSERT_EQ(range.second.first(), "a\xff");
+  // A key that ends where longer keys go on, with a NUL as next byte
+  ASSERT_EQ(map.erase("a"), 1U);
+  expected.erase("a");
+  ASSERT_EQ(map.erase(std::string(1, '\0')), 1U);
+  expected.erase(std::string(1, '\0'));
+  assertHolds(map, expected);
+  ASSERT_FALSE(map.contains("a"));
+  ASSERT_EQ(map.lower_bound("a").first(), std::string("a\0", 2));
+}
+
+TEST(RadixMap, nodes_grow_and_shrink) {
+  // Keys that differ in the last byte hang from one node, which passes
+  // through every size on the way to 256 children and back
+  s21::RadixMap<std::int64_t, int> map;
+  const std::int64_t base = 7LL << 40;
+  for (int i = 0; i < 256; ++i) {
+    std::int64_t key = base + (i * 37) % 256;
+    ASSERT_TRUE(map.insert(key, i).second);
+    ASSERT_EQ(map.size(), static_cast<size_t>(i + 1));
+    ASSERT_EQ(map.at(key), i);
+    ASSERT_EQ(map.begin().first(), base);
+  }
+  std::int64_t previous = base - 1;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    ASSERT_EQ(it.first(), previous + 1);
+    previous = it.first();
+  }
+  for (int i = 0; i < 256; ++i) {
+    std::int64_t key = base + (i * 101) % 256;
+    ASSERT_EQ(map.erase(key), 1U);
+    ASSERT_FALSE(map.contains(key));
+    for (int j = i + 1; j < 256; j += 17) {
+      ASSERT_TRUE(map.contains(base + (j * 101) % 256));
+    }
+  }
+  ASSERT_TRUE(map.empty());
+  // Signed keys flip the sign bit, so negative keys come first
+  for (std::int64_t key = -300; key <= 300; key += 3) {
+    map.insert(key, 0);
+  }
+  ASSERT_EQ(map.begin().first(), -300);
+  ASSERT_EQ(map.lower_bound(-5).first(), -3);
+  ASSERT_EQ(map.upper_bound(-3).first(), 0);
+  ASSERT_EQ(std::prev(map.end()).first(), 300);
+}
+
+TEST(RadixMap, throwing_insert_leaves_tree_unchanged) {
+  s21::RadixMap<std::string, Fragile> map;
+  const Fragile value(7);
+  auto attempt = [&](const std::string &key) {
+    Fragile::fail = true;
+    EXPECT_THROW(map.insert(key, value), std::runtime_error) << key;
+    Fragile::fail = false;
+  };
+  attempt("empty");
+  ASSERT_TRUE(map.empty());
+  ASSERT_TRUE(map.begin() == map.end());
+  std::vector<std::string> keys{"abcdefghijklmnop1", "abcdefghijklmnop2",
+                                "b1", "b2", "b3", "b4"};
+  for (const std::string &key : keys) {
+    map.insert(key, value);
+  }
+  // A leaf split, a prefix split past the stored bytes, a value leaf and a
+  // child that makes a full node grow
+  std::vector<std::string> failing{"b1x", "abcdefghijklmX",
+                                   "abcdefghijklmnop", "b5", ""};
+  for (const std::string &key : failing) {
+    attempt(key);
+    ASSERT_EQ(map.size(), keys.size());
+    ASSERT_FALSE(map.contains(key));
+    ASSERT_EQ(keysOf(map), keys);
+  }
+  ASSERT_TRUE(map.insert("b5", value).second);
+  ASSERT_EQ(map.size(), keys.size() + 1);
+}
+
+TEST(RadixMap, prefix_range) {
+  s21::RadixMap<std::string, int> map;
+  std::set<std::string> expected;
+  const std::string stems[] = {"", "https://example.com/",
+                               "https://example.com/static/img/", "a"};
+  const std::string tails[] = {"", "a", "ab", "/", "\xff", std::string(1, '\0'),
+                               std::string("a\0z", 3), "zz"};
+  for (const std::string &stem : stems) {
+    for (const std::string &tail : tails) {
+      map.insert(stem + tail, 0);
+      expected.insert(stem + tail);
+    }
+  }
+  std::vector<std::string> prefixes = {"",
+                                       "h",
+                                       "https://example.com/",
+                                       "https://example.com/static/",
+                                       "https://example.com/static/img/a",
+                                       "https://example.org/",
+                                       "a",
+                                       "ab",
+                                       std::string("a\0", 2),
+                                       "zzz"};
+  for (const std::string &prefix : prefixes) {
+    std::vector<std::string> want;
+    for (auto it = expected.lower_bound(prefix); it != expected.end();
+         ++it) {
+      if (it->compare(0, prefix.size(), prefix) != 0) {
+        break;
+      }
+      want.push_back(*it);
+    }
+    std::vector<std::string> got;
+    auto range = map.prefix_range(prefix);
+    for (auto it = range.first; it != range.second; ++it) {
+      got.push_back(it.first());
+    }
+    ASSERT_EQ(got, want) << prefix;
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,36 +1,142 @@
 #ifndef CPP2_S21_CONTAINERS_SRC_MULTISET_S21_MULTISET_H_
 #define CPP2_S21_CONTAINERS_SRC_MULTISET_S21_MULTISET_H_
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
 #include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "../Map/BTree.h"
 
 namespace s21 {
 
-template <typename KT>
+// Multiset layout keeping each distinct key in one node together with the
+// number of its copies, as in Multiset<int, RunLength<AvlBalance>>. Memory and
+// lookup depth then depend on the number of distinct keys only, which suits
+// low-cardinality data such as latency samples. Iteration still yields every
+// copy
+template <typename Balance = RedBlackBalance>
+struct RunLength {};
+
+// Tree and iterator behind a Multiset for its policy parameter, one node per
+// element unless the policy is RunLength
+template <typename KT, typename Policy, typename Compare>
+struct MultisetLayout {
+  static constexpr bool kRunLength = false;
+  using tree_type = BTree<KT, KeyOnly, Policy, Compare>;
+  using iterator = typename tree_type::iterator;
+};
+
+template <typename KT, typename Balance, typename Compare>
+struct MultisetLayout<KT, RunLength<Balance>, Compare> {
+  static constexpr bool kRunLength = true;
+  using tree_type = BTree<KT, std::size_t, Balance, Compare>;
+
+  // Visits every copy of a run before moving on to the next node
+  class iterator {
+   public:
+    using run_iterator = typename tree_type::iterator;
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = KT;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const KT*;
+    using reference = const KT&;
+
+    iterator() : run_(), copy_(0) {}
+    iterator(run_iterator run, std::size_t copy) : run_(run), copy_(copy) {}
+
+    iterator& operator++() {
+      if (run_.getNode() && ++copy_ == run_.second()) {
+        ++run_;
+        copy_ = 0;
+      }
+      return *this;
+    }
+
+    iterator operator++(int) {
+      iterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    // From end() or the first copy this steps to the last copy of the
+    // previous run
+    iterator& operator--() {
+      if (copy_ > 0) {
+        --copy_;
+      } else {
+        --run_;
+        copy_ = run_.getNode() ? run_.second() - 1 : 0;
+      }
+      return *this;
+    }
+
+    iterator operator--(int) {
+      iterator old = *this;
+      --*this;
+      return old;
+    }
+
+    const KT& operator*() const { return run_.first(); }
+
+    bool operator==(const iterator& other) const {
+      return run_ == other.run_ && copy_ == other.copy_;
+    }
+
+    bool operator!=(const iterator& other) const { return !(*this == other); }
+
+    typename tree_type::node_type* getNode() const { return run_.getNode(); }
+    run_iterator run() const { return run_; }
+    std::size_t copy() const { return copy_; }
+
+   private:
+    run_iterator run_;
+    std::size_t copy_;
+  };
+};
+
+template <typename KT, typename Balance = RedBlackBalance,
+          typename Compare = std::less<KT>>
 class Multiset {
   using key_type = KT;
   using value_type = KT;
   using reference = value_type &;
   using const_reference = const value_type &;
-  using tree_type = s21::BTree<KT>;
-  using iterator = typename tree_type::iterator;
-  using const_iterator = const typename tree_type::iterator;
+  using layout = MultisetLayout<KT, Balance, Compare>;
+  using tree_type = typename layout::tree_type;
+  using iterator = typename layout::iterator;
+  using const_iterator = const iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
   using size_type = size_t;
 
  public:
+  // Runs hold several copies in one node, so the run-length layout has no
+  // per-element nodes to hand out
+  using node_type =
+      std::conditional_t<layout::kRunLength, NoNodeHandle,
+                         typename tree_type::node_handle>;
+
   Multiset();
-  explicit Multiset(std::initializer_list<value_type> const &items);
+  explicit Multiset(const Compare &compare);
+  explicit Multiset(std::initializer_list<value_type> const &items,
+                    const Compare &compare = Compare());
+  template <typename It>
+  Multiset(sorted_equivalent_t, It first, It last,
+           const Compare &compare = Compare());
   Multiset(const Multiset &s);
   Multiset(Multiset &&s);
-  ~Multiset();
 
-  reference operator=(std::initializer_list<value_type> const &items);
-  reference operator=(const Multiset &s);
-  reference operator=(Multiset &&s);
+  Multiset &operator=(std::initializer_list<value_type> const &items);
+  Multiset &operator=(const Multiset &s);
+  Multiset &operator=(Multiset &&s);
 
   iterator begin();
   iterator end();
+  reverse_iterator rbegin();
+  reverse_iterator rend();
 
   bool empty();
   size_type size();
@@ -39,161 +145,537 @@ class Multiset {
   void clear();
 
   std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  iterator insert(node_type &&node);
+  node_type extract(iterator pos);
+  node_type extract(const KT &key);
   void erase(iterator pos);
+  size_type erase(iterator first, iterator last);
+  size_type erase(const KT &key);
   void swap(Multiset &other);
   void merge(Multiset &other);
 
   iterator find(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  iterator find(const K &key);
   bool contains(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  bool contains(const K &key);
+  size_type count(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  size_type count(const K &key);
+
+  iterator lower_bound(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  iterator lower_bound(const K &key);
+  iterator upper_bound(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  iterator upper_bound(const K &key);
+  std::pair<iterator, iterator> equal_range(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  std::pair<iterator, iterator> equal_range(const K &key);
+
+  iterator nth(size_type index);
+  size_type rank(const KT &key);
 
  private:
+  static constexpr bool kRunLength = layout::kRunLength;
+
   tree_type tree_;
   size_type size_;
+
+  template <typename It>
+  void assignRuns(It first, It last);
+  iterator wrap(typename tree_type::iterator it);
 };
 
 // Default constructor
-template <typename KT>
-Multiset<KT>::Multiset() : tree_(), size_(0) {}
-
-// Constructor for initializer list
-template <typename KT>
-Multiset<KT>::Multiset(std::initializer_list<value_type> const &items)
-    : tree_(), size_(0) {
+template <typename KT, typename Balance, typename Compare>
+Multiset<KT, Balance, Compare>::Multiset() : tree_(), size_(0) {}
+
+// Creates an empty Multiset ordered by compare
+template <typename KT, typename Balance, typename Compare>
+Multiset<KT, Balance, Compare>::Multiset(const Compare &compare)
+    : tree_(compare), size_(0) {}
+
+// Constructor for initializer list, a list already in ascending order is
+// bulk loaded in linear time
+template <typename KT, typename Balance, typename Compare>
+Multiset<KT, Balance, Compare>::Multiset(
+    std::initializer_list<value_type> const &items, const Compare &compare)
+    : tree_(compare), size_(items.size()) {
+  auto unsorted = std::adjacent_find(
+      items.begin(), items.end(),
+      [&compare](const value_type &left, const value_type &right) {
+        return compare(right, left);
+      });
+  if (unsorted == items.end()) {
+    assignRuns(items.begin(), items.end());
+    return;
+  }
+  size_ = 0;
   for (auto item : items) {
-    tree_.insert(item, item);
-    size_++;
+    insert(item);
   }
 }
 
+// Bulk loads [first, last), which has to be in ascending order, in linear
+// time
+template <typename KT, typename Balance, typename Compare>
+template <typename It>
+Multiset<KT, Balance, Compare>::Multiset(sorted_equivalent_t, It first, It last,
+                                         const Compare &compare)
+    : tree_(compare), size_(std::distance(first, last)) {
+  assignRuns(first, last);
+}
+
 // Copy constructor
-template <typename KT>
-Multiset<KT>::Multiset(const Multiset &other) : size_(0) {
-  for (auto it = other.tree_.begin(); it != other.tree_.end(); ++it) {
-    tree_.insert(it.getNode()->key, *it);
-    size_++;
-  }
+template <typename KT, typename Balance, typename Compare>
+Multiset<KT, Balance, Compare>::Multiset(const Multiset &other)
+    : tree_(other.tree_.keyCompare()), size_(other.size_) {
+  tree_.assign(other.tree_);
 }
 
 // Move constructor
-template <typename KT>
-Multiset<KT>::Multiset(Multiset &&other) : Multiset() {
+template <typename KT, typename Balance, typename Compare>
+Multiset<KT, Balance, Compare>::Multiset(Multiset &&other) : Multiset() {
   swap(other);
 }
 
-// Destructor
-template <typename KT>
-Multiset<KT>::~Multiset() {
-  if (size_ > 0 && tree_.getRoot()) {
-    size_ = 0;
-    tree_.destroy(tree_.getRoot());
-  }
-}
-
 // Getter size_
-template <typename KT>
-typename Multiset<KT>::size_type Multiset<KT>::size() {
+template <typename KT, typename Balance, typename Compare>
+typename Multiset<KT, Balance, Compare>::size_type
+Multiset<KT, Balance, Compare>::size() {
   return size_;
 }
 
 // Getter maxsize
-template <typename KT>
-typename Multiset<KT>::size_type Multiset<KT>::max_size() {
-  return ((std::numeric_limits<size_type>::max() / 2) - sizeof(BTree<KT>) -
-          sizeof(Node<KT>)) /
-         sizeof(Node<KT>);
+template <typename KT, typename Balance, typename Compare>
+typename Multiset<KT, Balance, Compare>::size_type
+Multiset<KT, Balance, Compare>::max_size() {
+  using node_type = typename tree_type::node_type;
+  return ((std::numeric_limits<size_type>::max() / 2) - sizeof(tree_type) -
+          sizeof(node_type)) /
+         sizeof(node_type);
 }
 
-template <typename KT>
-typename Multiset<KT>::reference Multiset<KT>::operator=(
+template <typename KT, typename Balance, typename Compare>
+Multiset<KT, Balance, Compare> &
+Multiset<KT, Balance, Compare>::operator=(
     std::initializer_list<value_type> const &items) {
-  swap(Multiset<KT>(items));
+  Multiset<KT, Balance, Compare> other(items);
+  swap(other);
   return *this;
 }
 
-template <typename KT>
-typename Multiset<KT>::reference Multiset<KT>::operator=(const Multiset &s) {
+template <typename KT, typename Balance, typename Compare>
+Multiset<KT, Balance, Compare> &
+Multiset<KT, Balance, Compare>::operator=(const Multiset &s) {
   if (this == &s) return *this;
-  swap(Multiset<KT>(s));
+  tree_.assign(s.tree_);
+  size_ = s.size_;
   return *this;
 }
 
-template <typename KT>
-typename Multiset<KT>::reference Multiset<KT>::operator=(Multiset &&s) {
+template <typename KT, typename Balance, typename Compare>
+Multiset<KT, Balance, Compare> &
+Multiset<KT, Balance, Compare>::operator=(Multiset &&s) {
   if (this == &s) return *this;
   swap(s);
   return *this;
 }
 
 // Method to find iterator to specific node
-template <typename KT>
-typename Multiset<KT>::iterator Multiset<KT>::find(const KT &key) {
-  return tree_.searchNode(key);
+template <typename KT, typename Balance, typename Compare>
+typename Multiset<KT, Balance, Compare>::iterator
+Multiset<KT, Balance, Compare>::find(const KT &key) {
+  return wrap(tree_.searchNode(key));
+}
+
+// Method to find iterator to specific node by a key of another type, which
+// Compare has to be transparent for
+template <typename KT, typename Balance, typename Compare>
+template <typename K, typename>
+typename Multiset<KT, Balance, Compare>::iterator
+Multiset<KT, Balance, Compare>::find(const K &key) {
+  return wrap(tree_.searchNode(key));
 }
 
 // Returns iterator to begin
-template <typename KT>
-typename Multiset<KT>::iterator Multiset<KT>::begin() {
-  return tree_.begin();
+template <typename KT, typename Balance, typename Compare>
+typename Multiset<KT, Balance, Compare>::iterator
+Multiset<KT, Balance, Compare>::begin() {
+  return wrap(tree_.begin());
 }
 
 // Returns iterator after end node
-template <typename KT>
-typename Multiset<KT>::iterator Multiset<KT>::end() {
-  return tree_.end();
+template <typename KT, typename Balance, typename Compare>
+typename Multiset<KT, Balance, Compare>::iterator
+Multiset<KT, Balance, Compare>::end() {
+  return wrap(tree_.end());
+}
+
+// Reverse iterator to the last element
+template <typename KT, typename Balance, typename Compare>
+typename Multiset<KT, Balance, Compare>::reverse_iterator
+Multiset<KT, Balance, Compare>::rbegin() {
+  return reverse_iterator(end());
+}
+
+// Reverse iterator before the first element
+template <typename KT, typename Balance, typename Compare>
+typename Multiset<KT, Balance, Compare>::reverse_iterator
+Multiset<KT, Balance, Compare>::rend() {
+  return reverse_iterator(begin());
 }
 
 // Method to check, is Multiset empty
-template <typename KT>
-bool Multiset<KT>::empty() {
+template <typename KT, typename Balance, typename Compare>
+bool Multiset<KT, Balance, Compare>::empty() {
   return size_ == 0;
 }
 
 // Destroy the all Multiset
-template <typename KT>
-void Multiset<KT>::clear() {
-  tree_.destroy(tree_.getRoot());
+template <typename KT, typename Balance, typename Compare>
+void Multiset<KT, Balance, Compare>::clear() {
+  tree_.clear();
   size_ = 0;
 }
 
-// Insert a new value into multiset
-template <typename KT>
-std::pair<typename Multiset<KT>::iterator, bool> Multiset<KT>::insert(
-    const KT &value) {
-  auto it = tree_.insert(value, value);
+// Insert a new value into multiset. In run-length layout a copy of a present
+// key only bumps the count of its node
+template <typename KT, typename Balance, typename Compare>
+std::pair<typename Multiset<KT, Balance, Compare>::iterator, bool>
+Multiset<KT, Balance, Compare>::insert(const KT &value) {
   size_++;
-  return std::pair<iterator, bool>{it, true};
+  if constexpr (kRunLength) {
+    auto run = tree_.emplaceUnique(value, 0).first;
+    return {iterator(run, run.second()++), true};
+  } else {
+    return {tree_.insert(value, key_only), true};
+  }
+}
+
+// Insert a temporary value, which is moved into a new node. A run-length node
+// for the key takes it only when there is none yet
+template <typename KT, typename Balance, typename Compare>
+std::pair<typename Multiset<KT, Balance, Compare>::iterator, bool>
+Multiset<KT, Balance, Compare>::insert(KT &&value) {
+  size_++;
+  if constexpr (kRunLength) {
+    auto run = tree_.emplaceUnique(std::move(value), 0).first;
+    return {iterator(run, run.second()++), true};
+  } else {
+    return {tree_.insert(std::move(value), key_only), true};
+  }
+}
+
+// Constructs a value from args and moves it into the multiset
+template <typename KT, typename Balance, typename Compare>
+template <class... Args>
+std::pair<typename Multiset<KT, Balance, Compare>::iterator, bool>
+Multiset<KT, Balance, Compare>::emplace(Args &&...args) {
+  return insert(KT(std::forward<Args>(args)...));
+}
+
+// Insert the node owned by the handle after the equal values, by relinking it
+template <typename KT, typename Balance, typename Compare>
+typename Multiset<KT, Balance, Compare>::iterator
+Multiset<KT, Balance, Compare>::insert(node_type &&node) {
+  static_assert(!kRunLength, "run-length multisets have no node handles");
+  if (node.empty()) {
+    return end();
+  }
+  size_++;
+  return tree_.insertEqual(node);
+}
+
+// Unlink the value at pos and hand its node over to the caller
+template <typename KT, typename Balance, typename Compare>
+typename Multiset<KT, Balance, Compare>::node_type
+Multiset<KT, Balance, Compare>::extract(iterator pos) {
+  static_assert(!kRunLength, "run-length multisets have no node handles");
+  node_type node = tree_.extract(pos);
+  if (node) {
+    size_--;
+  }
+  return node;
+}
+
+// Unlink the first value equal to key if there is one
+template <typename KT, typename Balance, typename Compare>
+typename Multiset<KT, Balance, Compare>::node_type
+Multiset<KT, Balance, Compare>::extract(const KT &key) {
+  iterator first = lower_bound(key);
+  if (first == end() || tree_.keyCompare()(key, *first)) {
+    return node_type();
+  }
+  return extract(first);
 }
 
-// Delete one node by getting iterator
-template <typename KT>
-void Multiset<KT>::erase(typename Multiset<KT>::iterator pos) {
-  auto node = pos.getNode();
-  tree_.removeNode(node, node->key);
+// Delete one node by getting iterator, in run-length layout the node goes
+// away with its last copy
+template <typename KT, typename Balance, typename Compare>
+void Multiset<KT, Balance, Compare>::erase(
+    typename Multiset<KT, Balance, Compare>::iterator pos) {
+  if (pos == end()) {
+    return;
+  }
+  if constexpr (kRunLength) {
+    auto run = pos.run();
+    if (--run.second() == 0) {
+      tree_.erase(run);
+    }
+  } else {
+    tree_.erase(pos);
+  }
   size_--;
 }
 
+// Deletes the elements in [first, last) and returns how many there were. In
+// run-length layout the runs strictly inside the range go away whole and the
+// ones it cuts lose their copies in it
+template <typename KT, typename Balance, typename Compare>
+typename Multiset<KT, Balance, Compare>::size_type
+Multiset<KT, Balance, Compare>::erase(iterator first, iterator last) {
+  size_type removed = 0;
+  if constexpr (kRunLength) {
+    auto run = first.run();
+    if (first == last) {
+      return 0;
+    }
+    if (run == last.run()) {
+      removed = last.copy() - first.copy();
+      run.second() -= removed;
+    } else {
+      removed = run.second() - first.copy();
+      run.second() = first.copy();
+      auto next = run;
+      ++next;
+      if (run.second() == 0) {
+        tree_.erase(run);
+      }
+      for (auto it = next; it != last.run(); ++it) {
+        removed += it.second();
+      }
+      tree_.erase(next, last.run());
+      if (last != end()) {
+        removed += last.copy();
+        last.run().second() -= last.copy();
+      }
+    }
+  } else {
+    removed = tree_.erase(first, last);
+  }
+  size_ -= removed;
+  return removed;
+}
+
+// Deletes all copies of key and returns how many there were. One lookup and
+// one node removal in run-length layout. Otherwise the k copies are counted
+// and then unlinked one by one or, when that would cost more than n, dropped
+// by rebuilding the tree, so O(log n + min(k log n, n))
+template <typename KT, typename Balance, typename Compare>
+typename Multiset<KT, Balance, Compare>::size_type
+Multiset<KT, Balance, Compare>::erase(const KT &key) {
+  if constexpr (kRunLength) {
+    auto run = tree_.searchNode(key);
+    if (run == tree_.end()) {
+      return 0;
+    }
+    size_type removed = run.second();
+    tree_.erase(run);
+    size_ -= removed;
+    return removed;
+  } else {
+    auto range = tree_.equalRange(key);
+    return erase(range.first, range.second);
+  }
+}
+
 // Swap two multisets
-template <typename KT>
-void Multiset<KT>::swap(Multiset &other) {
+template <typename KT, typename Balance, typename Compare>
+void Multiset<KT, Balance, Compare>::swap(Multiset &other) {
   using std::swap;
   swap(size_, other.size_);
   swap(tree_, other.tree_);
 }
 
-// Merge two multisets
-template <typename KT>
-void Multiset<KT>::merge(Multiset &other) {
-  for (auto it = other.tree_.begin(); it != other.tree_.end(); ++it) {
-    insert(it.getNode()->key);
+// Merge two multisets, the nodes of other are relinked into this one. In
+// run-length layout only runs of keys missing here move, the others add their
+// counts to the existing runs
+template <typename KT, typename Balance, typename Compare>
+void Multiset<KT, Balance, Compare>::merge(Multiset &other) {
+  if (&other == this) {
+    return;
+  }
+  if constexpr (kRunLength) {
+    tree_.mergeUnique(other.tree_);
+    for (auto it = other.tree_.begin(); it != other.tree_.end(); ++it) {
+      *tree_.search(it.first()) += it.second();
+    }
+    other.tree_.clear();
+  } else {
+    tree_.mergeEqual(other.tree_);
   }
+  size_ += other.size_;
+  other.size_ = 0;
 }
 
 // Check is key containing in Multiset
-template <typename KT>
-bool Multiset<KT>::contains(const KT &key) {
+template <typename KT, typename Balance, typename Compare>
+bool Multiset<KT, Balance, Compare>::contains(const KT &key) {
   return (tree_.search(key) != nullptr);
 }
 
+// contains for a key of another type under a transparent Compare
+template <typename KT, typename Balance, typename Compare>
+template <typename K, typename>
+bool Multiset<KT, Balance, Compare>::contains(const K &key) {
+  return (tree_.search(key) != nullptr);
+}
+
+// Returns the number of copies of key. A single lookup in run-length layout,
+// O(log n) with an OrderStatistic balancing policy and O(log n + k) otherwise
+template <typename KT, typename Balance, typename Compare>
+typename Multiset<KT, Balance, Compare>::size_type
+Multiset<KT, Balance, Compare>::count(const KT &key) {
+  if constexpr (kRunLength) {
+    size_type *copies = tree_.search(key);
+    return copies ? *copies : 0;
+  } else {
+    return tree_.count(key);
+  }
+}
+
+// count for a key of another type under a transparent Compare
+template <typename KT, typename Balance, typename Compare>
+template <typename K, typename>
+typename Multiset<KT, Balance, Compare>::size_type
+Multiset<KT, Balance, Compare>::count(const K &key) {
+  if constexpr (kRunLength) {
+    size_type *copies = tree_.search(key);
+    return copies ? *copies : 0;
+  } else {
+    return tree_.count(key);
+  }
+}
+
+// Returns an iterator to the first element not less than key, in O(log n)
+template <typename KT, typename Balance, typename Compare>
+typename Multiset<KT, Balance, Compare>::iterator
+Multiset<KT, Balance, Compare>::lower_bound(const KT &key) {
+  return wrap(tree_.lowerBound(key));
+}
+
+// lower_bound for a key of another type under a transparent Compare
+template <typename KT, typename Balance, typename Compare>
+template <typename K, typename>
+typename Multiset<KT, Balance, Compare>::iterator
+Multiset<KT, Balance, Compare>::lower_bound(const K &key) {
+  return wrap(tree_.lowerBound(key));
+}
+
+// Returns an iterator to the first element greater than key, in O(log n)
+template <typename KT, typename Balance, typename Compare>
+typename Multiset<KT, Balance, Compare>::iterator
+Multiset<KT, Balance, Compare>::upper_bound(const KT &key) {
+  return wrap(tree_.upperBound(key));
+}
+
+// upper_bound for a key of another type under a transparent Compare
+template <typename KT, typename Balance, typename Compare>
+template <typename K, typename>
+typename Multiset<KT, Balance, Compare>::iterator
+Multiset<KT, Balance, Compare>::upper_bound(const K &key) {
+  return wrap(tree_.upperBound(key));
+}
+
+// Returns the range of all elements with key equivalent to key
+template <typename KT, typename Balance, typename Compare>
+std::pair<typename Multiset<KT, Balance, Compare>::iterator,
+          typename Multiset<KT, Balance, Compare>::iterator>
+Multiset<KT, Balance, Compare>::equal_range(const KT &key) {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+// equal_range for a key of another type under a transparent Compare
+template <typename KT, typename Balance, typename Compare>
+template <typename K, typename>
+std::pair<typename Multiset<KT, Balance, Compare>::iterator,
+          typename Multiset<KT, Balance, Compare>::iterator>
+Multiset<KT, Balance, Compare>::equal_range(const K &key) {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+// Returns the element with index elements before it in key order, or end().
+// O(log n) with an OrderStatistic balancing policy, a walk over the distinct
+// keys in run-length layout
+template <typename KT, typename Balance, typename Compare>
+typename Multiset<KT, Balance, Compare>::iterator
+Multiset<KT, Balance, Compare>::nth(size_type index) {
+  if constexpr (kRunLength) {
+    auto run = tree_.begin();
+    for (; run != tree_.end() && index >= run.second(); ++run) {
+      index -= run.second();
+    }
+    return iterator(run, run == tree_.end() ? 0 : index);
+  } else {
+    return tree_.nth(index);
+  }
+}
+
+// Returns the number of elements with a key less than key, which is the index
+// of its first copy in key order when it is present. O(log n) with an
+// OrderStatistic balancing policy, a walk over the distinct keys in run-length
+// layout
+template <typename KT, typename Balance, typename Compare>
+typename Multiset<KT, Balance, Compare>::size_type
+Multiset<KT, Balance, Compare>::rank(const KT &key) {
+  if constexpr (kRunLength) {
+    size_type result = 0;
+    for (auto run = tree_.begin();
+         run != tree_.end() && tree_.keyCompare()(run.first(), key); ++run) {
+      result += run.second();
+    }
+    return result;
+  } else {
+    return tree_.rank(key);
+  }
+}
+
+// Bulk loads [first, last) in ascending order, collapsing equal keys into one
+// node each in run-length layout
+template <typename KT, typename Balance, typename Compare>
+template <typename It>
+void Multiset<KT, Balance, Compare>::assignRuns(It first, It last) {
+  if constexpr (kRunLength) {
+    std::vector<std::pair<KT, size_type>> runs;
+    for (; first != last; ++first) {
+      if (runs.empty() || tree_.keyCompare()(runs.back().first, *first)) {
+        runs.emplace_back(*first, 0);
+      }
+      ++runs.back().second;
+    }
+    tree_.assignSorted(runs.begin(), runs.end());
+  } else {
+    tree_.assignSorted(first, last);
+  }
+}
+
+// Turns a tree iterator into a container iterator at the first copy
+template <typename KT, typename Balance, typename Compare>
+typename Multiset<KT, Balance, Compare>::iterator
+Multiset<KT, Balance, Compare>::wrap(typename tree_type::iterator it) {
+  if constexpr (kRunLength) {
+    return iterator(it, 0);
+  } else {
+    return it;
+  }
+}
+
 }  // namespace s21
 
 #endif  // CPP2_S21_CONTAINERS_SRC_MULTISET_S21_MULTISET_H_
\ No newline at end of file
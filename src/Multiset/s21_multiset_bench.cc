@@ -0,0 +1,108 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "s21_multiset.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+template <typename MultisetT>
+void samplesOne(const char *name, const std::vector<int> &samples,
+                std::size_t nodes) {
+  auto start = Clock::now();
+  MultisetT multiset;
+  for (int sample : samples) {
+    multiset.insert(sample);
+  }
+  double insert = secondsSince(start);
+  start = Clock::now();
+  long long found = 0;
+  for (int i = 0; i < 1000000; ++i) {
+    found += multiset.contains(samples[i % samples.size()]);
+  }
+  double find = secondsSince(start);
+  std::size_t bytes =
+      nodes * sizeof(*std::declval<MultisetT &>().begin().getNode());
+  std::printf("  %-10s insert %.3fs 1M contains %.3fs nodes %.1f MiB (%lld)\n",
+              name, insert, find, bytes / 1048576.0, found);
+}
+
+// Low-cardinality samples in a Multiset, one node per element against one
+// node per distinct value
+void runLength(int count) {
+  std::mt19937 random(17);
+  std::vector<int> samples(count);
+  for (int i = 0; i < count; ++i) {
+    samples[i] = static_cast<int>(random() % 10000);
+  }
+  std::printf("run_length n=%d distinct=10000\n", count);
+  samplesOne<s21::Multiset<int>>("per copy", samples, count);
+  samplesOne<s21::Multiset<int, s21::RunLength<>>>("run-length", samples,
+                                                   10000);
+}
+
+template <typename MultisetT>
+void frequencyOne(const char *name, const std::vector<int> &samples) {
+  MultisetT multiset;
+  for (int sample : samples) {
+    multiset.insert(sample);
+  }
+  auto start = Clock::now();
+  long long total = 0;
+  for (int key = 0; key < 1000; ++key) {
+    total += multiset.count(key);
+  }
+  double count = secondsSince(start);
+  start = Clock::now();
+  for (int key = 0; key < 1000; key += 2) {
+    total -= multiset.erase(key);
+  }
+  double erase = secondsSince(start);
+  start = Clock::now();
+  total -= multiset.erase(multiset.begin(), multiset.lower_bound(500));
+  double range = secondsSince(start);
+  std::printf("  %-15s 1000 count %.3fs 500 erase(key) %.3fs "
+              "erase(range) %.3fs (%lld)\n",
+              name, count, erase, range, total);
+}
+
+// Frequency counting and bulk removal over 1000 values
+void frequency(int count) {
+  std::mt19937 random(19);
+  std::vector<int> samples(count);
+  for (int i = 0; i < count; ++i) {
+    samples[i] = static_cast<int>(random() % 1000);
+  }
+  std::printf("frequency n=%d distinct=1000\n", count);
+  frequencyOne<s21::Multiset<int>>("red-black", samples);
+  frequencyOne<s21::Multiset<int, s21::OrderStatistic<s21::RedBlackBalance>>>(
+      "order statistic", samples);
+  frequencyOne<s21::Multiset<int, s21::RunLength<>>>("run-length", samples);
+}
+
+}  // namespace
+
+// Usage: s21_multiset_bench [name] [count]
+int main(int argc, char **argv) {
+  const char *name = argc > 1 ? argv[1] : "all";
+  int count = argc > 2 ? std::atoi(argv[2]) : 10000000;
+  bool all = std::strcmp(name, "all") == 0;
+  if (all || std::strcmp(name, "run_length") == 0) {
+    runLength(count);
+  }
+  if (all || std::strcmp(name, "frequency") == 0) {
+    frequency(count);
+  }
+  return 0;
+}
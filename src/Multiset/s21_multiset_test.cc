@@ -4,12 +4,15 @@
 
 #include <cstring>
 #include <set>
+#include <string>
+#include <string_view>
+#include <vector>
 
 template <class T>
 bool comparisonMultiset(s21::Multiset<T> &s21_multiset,
                         s21::Multiset<T> &s21_multiset2);
-template <class T>
-bool comparisonMultiset(s21::Multiset<T> &s21_multiset,
+template <class T, class Balance>
+bool comparisonMultiset(s21::Multiset<T, Balance> &s21_multiset,
                         std::multiset<T> &stl_multiset);
 
 // Constructors
@@ -128,7 +131,7 @@ TEST(Multiset, max_size) {
   s21::Multiset<int> multiset;
   std::multiset<int> stdmultiset;
   ASSERT_TRUE(multiset.max_size() > 0);
-  ASSERT_TRUE(multiset.max_size() == 288230376151711742);
+  ASSERT_TRUE(multiset.max_size() == 288230376151711740);
 }
 
 // Multiset
@@ -169,6 +172,42 @@ TEST(Multiset, insert_key_value_int) {
   ASSERT_TRUE(comparisonMultiset(multiset, stdmultiset));
 }
 
+// Value counting how often it is copied
+struct Tracked {
+  static int copies;
+  std::string text;
+
+  explicit Tracked(std::string text) : text(std::move(text)) {}
+  Tracked(const Tracked &other) : text(other.text) { ++copies; }
+  Tracked(Tracked &&) = default;
+  Tracked &operator=(const Tracked &other) {
+    text = other.text;
+    ++copies;
+    return *this;
+  }
+  Tracked &operator=(Tracked &&) = default;
+  bool operator<(const Tracked &other) const { return text < other.text; }
+};
+
+int Tracked::copies = 0;
+
+template <class Layout>
+void insertWithoutCopies() {
+  Tracked::copies = 0;
+  s21::Multiset<Tracked, Layout> multiset;
+  ASSERT_TRUE(multiset.insert(Tracked("b")).second);
+  ASSERT_TRUE(multiset.emplace("a").second);
+  ASSERT_TRUE(multiset.emplace("b").second);
+  ASSERT_EQ(Tracked::copies, 0);
+  ASSERT_EQ(multiset.size(), 3U);
+  ASSERT_EQ(multiset.count(Tracked("b")), 2U);
+}
+
+TEST(Multiset, insert_without_copies) {
+  insertWithoutCopies<s21::RedBlackBalance>();
+  insertWithoutCopies<s21::RunLength<s21::AvlBalance>>();
+}
+
 TEST(Multiset, erase_no_child) {
   s21::Multiset<int> multiset;
   multiset.insert(7);
@@ -226,6 +265,348 @@ TEST(Multiset, merge) {
   s21::Multiset<int> multiset1{1, 10, 11};
   multiset.merge(multiset1);
   ASSERT_TRUE(multiset.size() == 6);
+  ASSERT_TRUE(multiset1.empty());
+  ASSERT_EQ(multiset.count(11), 2U);
+}
+
+template <class Layout>
+void mergeAll() {
+  s21::Multiset<int, Layout> multiset{1, 1, 2, 5};
+  s21::Multiset<int, Layout> other{1, 3, 5, 5, 7};
+  std::multiset<int> expected{1, 1, 2, 5, 1, 3, 5, 5, 7};
+  multiset.merge(other);
+  ASSERT_TRUE(other.empty());
+  ASSERT_EQ(other.begin(), other.end());
+  ASSERT_EQ(multiset.size(), expected.size());
+  ASSERT_TRUE(comparisonMultiset(multiset, expected));
+  ASSERT_EQ(multiset.count(5), 3U);
+  other.insert(4);
+  multiset.merge(other);
+  ASSERT_EQ(multiset.size(), expected.size() + 1);
+}
+
+TEST(Multiset, merge_all) {
+  mergeAll<s21::RedBlackBalance>();
+  mergeAll<s21::OrderStatistic<s21::AvlBalance>>();
+  mergeAll<s21::RunLength<>>();
+}
+
+TEST(Multiset, node_handles) {
+  s21::Multiset<int> multiset{4, 2, 2, 8};
+  auto node = multiset.extract(2);
+  ASSERT_EQ(node.value(), 2);
+  ASSERT_EQ(multiset.count(2), 1U);
+  ASSERT_EQ(multiset.size(), 3U);
+  node.value() = 8;
+  auto position = multiset.insert(std::move(node));
+  ASSERT_TRUE(node.empty());
+  ASSERT_EQ(*position, 8);
+  ASSERT_EQ(multiset.count(8), 2U);
+  ASSERT_TRUE(multiset.extract(5).empty());
+  ASSERT_EQ(multiset.insert(std::move(node)), multiset.end());
+  ASSERT_EQ(multiset.size(), 4U);
+}
+
+TEST(Multiset, extract_takes_first_equal) {
+  // Strings are looked up with one three-way comparison per node, which may
+  // stop at any of the equal ones
+  s21::Multiset<std::string> multiset;
+  for (int i = 0; i < 64; ++i) {
+    multiset.insert("b");
+  }
+  for (int left = 64; left > 0; --left) {
+    const std::string *first = &*multiset.lower_bound("b");
+    auto node = multiset.extract("b");
+    // The handle keeps the node where it was
+    ASSERT_EQ(&node.value(), first);
+  }
+  ASSERT_TRUE(multiset.extract("b").empty());
+  ASSERT_TRUE(multiset.empty());
+}
+
+TEST(Multiset, balance_policies) {
+  s21::Multiset<int, s21::AvlBalance> avl;
+  s21::Multiset<int, s21::TreapBalance> treap;
+  std::multiset<int> stdmultiset;
+  for (int i = 0; i < 500; ++i) {
+    int value = i % 17;
+    avl.insert(value);
+    treap.insert(value);
+    stdmultiset.insert(value);
+  }
+  for (int value = 0; value < 17; value += 2) {
+    avl.erase(avl.find(value));
+    treap.erase(treap.find(value));
+    stdmultiset.erase(stdmultiset.find(value));
+  }
+  ASSERT_EQ(avl.size(), stdmultiset.size());
+  ASSERT_EQ(treap.size(), stdmultiset.size());
+  ASSERT_TRUE(comparisonMultiset(avl, stdmultiset));
+  ASSERT_TRUE(comparisonMultiset(treap, stdmultiset));
+}
+
+TEST(Multiset, sorted_equivalent_constructor) {
+  std::multiset<int> stdmultiset;
+  for (int i = 0; i < 1000; ++i) {
+    stdmultiset.insert(i / 3);
+  }
+  s21::Multiset<int> multiset(s21::sorted_equivalent, stdmultiset.begin(),
+                              stdmultiset.end());
+  s21::Multiset<int, s21::TreapBalance> treap(
+      s21::sorted_equivalent, stdmultiset.begin(), stdmultiset.end());
+  ASSERT_EQ(multiset.size(), stdmultiset.size());
+  ASSERT_TRUE(comparisonMultiset(multiset, stdmultiset));
+  ASSERT_TRUE(comparisonMultiset(treap, stdmultiset));
+  s21::Multiset<int> copymultiSet{1, 1, 2};
+  copymultiSet = multiset;
+  ASSERT_TRUE(comparisonMultiset(copymultiSet, multiset));
+  for (int value = 0; value < 333; value += 2) {
+    multiset.erase(multiset.find(value));
+    treap.erase(treap.find(value));
+    stdmultiset.erase(stdmultiset.find(value));
+  }
+  ASSERT_TRUE(comparisonMultiset(multiset, stdmultiset));
+  ASSERT_TRUE(comparisonMultiset(treap, stdmultiset));
+}
+
+TEST(Multiset, greater_compare) {
+  s21::Multiset<int, s21::RedBlackBalance, std::greater<int>> multiset{
+      2, 5, 2, 7, 5, 2};
+  int expected[] = {7, 5, 5, 2, 2, 2};
+  int index = 0;
+  for (auto it = multiset.begin(); it != multiset.end(); ++it) {
+    ASSERT_EQ(*it, expected[index++]);
+  }
+  ASSERT_EQ(index, 6);
+  ASSERT_TRUE(multiset.contains(5));
+  ASSERT_FALSE(multiset.contains(4));
+}
+
+// Ordering whose direction is chosen at run time
+struct Direction {
+  bool descending;
+  bool operator()(int left, int right) const {
+    return descending ? right < left : left < right;
+  }
+};
+
+TEST(Multiset, stored_compare) {
+  s21::Multiset<int, s21::RunLength<>, Direction> runs({2, 5, 2, 7, 5, 2},
+                                                       Direction{true});
+  ASSERT_EQ(std::vector<int>(runs.begin(), runs.end()),
+            (std::vector<int>{7, 5, 5, 2, 2, 2}));
+  ASSERT_EQ(runs.rank(2), 3U);
+  ASSERT_EQ(runs.count(5), 2U);
+  s21::Multiset<int, s21::RedBlackBalance, Direction> sorted(
+      s21::sorted_equivalent, runs.begin(), runs.end(), Direction{true});
+  s21::Multiset<int, s21::RedBlackBalance, Direction> copy(sorted);
+  auto nine = copy.insert(9).first;
+  ASSERT_TRUE(nine == copy.begin());
+  ASSERT_EQ(std::vector<int>(copy.begin(), copy.end()),
+            (std::vector<int>{9, 7, 5, 5, 2, 2, 2}));
+}
+
+TEST(Multiset, order_statistic) {
+  s21::Multiset<int, s21::OrderStatistic<s21::RedBlackBalance>> latencies;
+  std::multiset<int> expected;
+  unsigned seed = 17;
+  for (int i = 0; i < 5000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int latency = static_cast<int>((seed >> 16) % 300);
+    latencies.insert(latency);
+    expected.insert(latency);
+  }
+  for (int i = 0; i < 1000; ++i) {
+    latencies.erase(latencies.find(i % 300));
+    expected.erase(expected.find(i % 300));
+  }
+  ASSERT_EQ(latencies.size(), expected.size());
+  size_t index = 0;
+  for (auto it = expected.begin(); it != expected.end(); ++it, ++index) {
+    ASSERT_EQ(*latencies.nth(index), *it);
+    ASSERT_EQ(latencies.rank(*it),
+              std::distance(expected.begin(), expected.lower_bound(*it)));
+  }
+  size_t p99 = latencies.size() * 99 / 100;
+  ASSERT_EQ(*latencies.nth(p99), *std::next(expected.begin(), p99));
+}
+
+TEST(Multiset, equal_range) {
+  s21::Multiset<int> multiset{4, 1, 4, 2, 4, 9, 2};
+  auto range = multiset.equal_range(4);
+  int copies = 0;
+  for (auto it = range.first; it != range.second; ++it) {
+    ASSERT_EQ(*it, 4);
+    ++copies;
+  }
+  ASSERT_EQ(copies, 3);
+  ASSERT_EQ(*multiset.lower_bound(3), 4);
+  ASSERT_EQ(*multiset.upper_bound(4), 9);
+  ASSERT_EQ(multiset.upper_bound(9), multiset.end());
+  range = multiset.equal_range(5);
+  ASSERT_EQ(range.first, range.second);
+  ASSERT_EQ(*range.first, 9);
+}
+
+TEST(Multiset, count_and_erase_key) {
+  s21::Multiset<int> multiset{3, 1, 3, 2, 3};
+  ASSERT_EQ(multiset.count(3), 3U);
+  ASSERT_EQ(multiset.count(4), 0U);
+  ASSERT_EQ(multiset.erase(3), 3U);
+  ASSERT_EQ(multiset.erase(3), 0U);
+  ASSERT_EQ(multiset.size(), 2U);
+  ASSERT_FALSE(multiset.contains(3));
+}
+
+template <class Balance>
+void transparentLookup() {
+  s21::Multiset<std::string, Balance, std::less<>> words{
+      "pear", "apple", "pear", "fig", "pear", "apple"};
+  std::string_view pear = "pear";
+  ASSERT_EQ(words.count(pear), 3U);
+  ASSERT_EQ(words.count("apple"), 2U);
+  ASSERT_EQ(words.count(std::string_view("plum")), 0U);
+  ASSERT_TRUE(words.contains(pear));
+  ASSERT_EQ(*words.find("fig"), "fig");
+  ASSERT_EQ(*words.lower_bound(std::string_view("b")), "fig");
+  auto range = words.equal_range(pear);
+  ASSERT_EQ(std::distance(range.first, range.second), 3);
+}
+
+TEST(Multiset, transparent_lookup) {
+  transparentLookup<s21::RedBlackBalance>();
+  transparentLookup<s21::OrderStatistic<s21::AvlBalance>>();
+  transparentLookup<s21::RunLength<>>();
+}
+
+TEST(Multiset, run_length) {
+  s21::Multiset<int, s21::RunLength<>> samples;
+  std::multiset<int> expected;
+  unsigned seed = 21;
+  for (int i = 0; i < 20000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int sample = static_cast<int>((seed >> 16) % 50);
+    samples.insert(sample);
+    expected.insert(sample);
+  }
+  for (int i = 0; i < 3000; ++i) {
+    samples.erase(samples.find(i % 60));
+    if (expected.count(i % 60)) {
+      expected.erase(expected.find(i % 60));
+    }
+  }
+  ASSERT_EQ(samples.erase(7), expected.erase(7));
+  ASSERT_EQ(samples.size(), expected.size());
+  ASSERT_TRUE(comparisonMultiset(samples, expected));
+  for (int key = 0; key < 50; ++key) {
+    ASSERT_EQ(samples.count(key), expected.count(key));
+    ASSERT_EQ(samples.rank(key),
+              std::distance(expected.begin(), expected.lower_bound(key)));
+  }
+  ASSERT_EQ(*samples.nth(expected.size() / 2),
+            *std::next(expected.begin(), expected.size() / 2));
+  ASSERT_EQ(samples.nth(expected.size()), samples.end());
+  ASSERT_EQ(*samples.upper_bound(10), *expected.upper_bound(10));
+  auto range = samples.equal_range(20);
+  size_t copies = 0;
+  for (; range.first != range.second; ++range.first) {
+    ASSERT_EQ(*range.first, 20);
+    ++copies;
+  }
+  ASSERT_EQ(copies, expected.count(20));
+
+  s21::Multiset<int, s21::RunLength<>> copy(samples);
+  s21::Multiset<int, s21::RunLength<>> other{5, 1, 5, 60};
+  copy.merge(other);
+  expected.insert({5, 1, 5, 60});
+  ASSERT_EQ(copy.size(), expected.size());
+  ASSERT_TRUE(comparisonMultiset(copy, expected));
+  std::vector<int> sorted(expected.begin(), expected.end());
+  s21::Multiset<int, s21::RunLength<s21::AvlBalance>> loaded(
+      s21::sorted_equivalent, sorted.begin(), sorted.end());
+  ASSERT_EQ(loaded.count(5), expected.count(5));
+  ASSERT_TRUE(comparisonMultiset(loaded, expected));
+}
+
+template <class Balance>
+void eraseRanges() {
+  s21::Multiset<int, Balance> multiset;
+  std::multiset<int> expected;
+  for (int i = 0; i < 4000; ++i) {
+    multiset.insert(i % 400);
+    expected.insert(i % 400);
+  }
+  ASSERT_EQ(multiset.count(17), 10U);
+  ASSERT_EQ(multiset.erase(17), 10U);
+  expected.erase(17);
+  ASSERT_EQ(multiset.erase(multiset.lower_bound(20), multiset.upper_bound(24)),
+            50U);
+  expected.erase(expected.lower_bound(20), expected.upper_bound(24));
+  ASSERT_EQ(multiset.erase(multiset.lower_bound(100), multiset.end()), 3000U);
+  expected.erase(expected.lower_bound(100), expected.end());
+  ASSERT_EQ(multiset.size(), expected.size());
+  ASSERT_TRUE(comparisonMultiset(multiset, expected));
+  for (int key = 0; key < 400; ++key) {
+    ASSERT_EQ(multiset.count(key), expected.count(key));
+  }
+  for (int i = 0; i < 500; ++i) {
+    multiset.insert(i);
+    expected.insert(i);
+  }
+  ASSERT_EQ(multiset.erase(multiset.begin(), multiset.lower_bound(300)),
+            static_cast<size_t>(std::distance(expected.begin(),
+                                              expected.lower_bound(300))));
+  expected.erase(expected.begin(), expected.lower_bound(300));
+  ASSERT_EQ(multiset.size(), expected.size());
+  ASSERT_TRUE(comparisonMultiset(multiset, expected));
+  size_t index = 0;
+  for (auto it = expected.begin(); it != expected.end(); ++it, ++index) {
+    ASSERT_EQ(*multiset.nth(index), *it);
+  }
+}
+
+TEST(Multiset, erase_range) {
+  eraseRanges<s21::RedBlackBalance>();
+  eraseRanges<s21::AvlBalance>();
+  eraseRanges<s21::TreapBalance>();
+  eraseRanges<s21::NoBalance>();
+  eraseRanges<s21::OrderStatistic<s21::RedBlackBalance>>();
+  eraseRanges<s21::RunLength<>>();
+  eraseRanges<s21::Threaded<s21::AvlBalance>>();
+  eraseRanges<s21::RunLength<s21::Threaded<s21::RedBlackBalance>>>();
+}
+
+template <class Balance>
+void reverseMatchesStd() {
+  s21::Multiset<int, Balance> multiset;
+  std::multiset<int> expected;
+  ASSERT_TRUE(multiset.rbegin() == multiset.rend());
+  for (int i = 0; i < 1000; ++i) {
+    multiset.insert((i * 7) % 90);
+    expected.insert((i * 7) % 90);
+  }
+  auto std_it = expected.rbegin();
+  for (auto it = multiset.rbegin(); it != multiset.rend(); ++it, ++std_it) {
+    ASSERT_EQ(*it, *std_it);
+  }
+  ASSERT_TRUE(std_it == expected.rend());
+  auto it = multiset.end();
+  for (auto back = expected.end(); back != expected.begin();) {
+    ASSERT_EQ(*--it, *--back);
+  }
+  ASSERT_TRUE(it == multiset.begin());
+  auto tail = multiset.lower_bound(89);
+  ASSERT_EQ(std::distance(tail, multiset.end()),
+            static_cast<std::ptrdiff_t>(expected.count(89)));
+  ASSERT_EQ(*std::prev(tail), 88);
+}
+
+TEST(Multiset, reverse_iteration) {
+  reverseMatchesStd<s21::RedBlackBalance>();
+  reverseMatchesStd<s21::AvlBalance>();
+  reverseMatchesStd<s21::Threaded<s21::NoBalance>>();
+  reverseMatchesStd<s21::RunLength<>>();
+  reverseMatchesStd<s21::RunLength<s21::Threaded<s21::AvlBalance>>>();
 }
 
 int main(int argc, char **argv) {
@@ -233,8 +614,8 @@ int main(int argc, char **argv) {
   return RUN_ALL_TESTS();
 }
 
-template <class T>
-bool comparisonMultiset(s21::Multiset<T> &s21_multiset,
+template <class T, class Balance>
+bool comparisonMultiset(s21::Multiset<T, Balance> &s21_multiset,
                         std::multiset<T> &stl_multiset) {
   if (s21_multiset.empty() == true || stl_multiset.empty() == true) {
     return true;
@@ -0,0 +1,220 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_SET_EPOCH_H_
+#define CPP2_S21_CONTAINERS_SRC_SET_EPOCH_H_
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace s21 {
+
+// Epoch-based reclamation for lock-free containers. A thread pins the current
+// epoch while it may hold pointers into a shared structure. Memory unlinked
+// from the structure is retired instead of freed, and freed only once the
+// global epoch has moved two steps past the retiring one. The epoch advances
+// only when every pinned thread has seen the current one, so by then nobody
+// can still hold a pointer to the retired memory. One domain serves the whole
+// process, per-thread records are reused by later threads
+class EpochDomain {
+ public:
+  using Deleter = void (*)(void*);
+
+  static EpochDomain& instance();
+
+  EpochDomain(const EpochDomain&) = delete;
+  EpochDomain& operator=(const EpochDomain&) = delete;
+  ~EpochDomain();
+
+  void enter();
+  void leave();
+  void retire(void* object, Deleter deleter);
+
+ private:
+  static constexpr std::uint64_t kIdle =
+      std::numeric_limits<std::uint64_t>::max();
+  // Retirements between two attempts to advance the epoch
+  static constexpr unsigned kAdvanceEvery = 64;
+
+  struct Retired {
+    void* object;
+    Deleter deleter;
+  };
+
+  // Everything but epoch and used is only touched by the owning thread.
+  // Retired memory is kept in three buckets by epoch modulo three
+  struct Record {
+    std::atomic<std::uint64_t> epoch{kIdle};
+    std::atomic<bool> used{true};
+    Record* next = nullptr;
+    unsigned nesting = 0;
+    unsigned retired = 0;
+    std::uint64_t bucketEpoch[3] = {0, 0, 0};
+    std::vector<Retired> buckets[3];
+  };
+
+  // Gives the record back when its thread exits
+  struct ThreadSlot {
+    Record* record = nullptr;
+    ~ThreadSlot();
+  };
+
+  std::atomic<std::uint64_t> epoch_;
+  std::atomic<Record*> records_;
+
+  EpochDomain() : epoch_(1), records_(nullptr) {}
+
+  Record* local();
+  Record* acquire();
+  bool tryAdvance(std::uint64_t epoch);
+  static void flush(std::vector<Retired>& bucket);
+};
+
+// Pins the calling thread while alive. Guards nest, and copies pin again, so
+// an object holding one, like an iterator, keeps what it points to alive. A
+// guard belongs to the thread that made it
+class EpochGuard {
+ public:
+  EpochGuard() : pinned_(true) { EpochDomain::instance().enter(); }
+  explicit EpochGuard(bool pin) : pinned_(pin) {
+    if (pinned_) {
+      EpochDomain::instance().enter();
+    }
+  }
+  EpochGuard(const EpochGuard& other) : EpochGuard(other.pinned_) {}
+  ~EpochGuard() {
+    if (pinned_) {
+      EpochDomain::instance().leave();
+    }
+  }
+
+  EpochGuard& operator=(const EpochGuard& other) {
+    if (!pinned_ && other.pinned_) {
+      EpochDomain::instance().enter();
+    } else if (pinned_ && !other.pinned_) {
+      EpochDomain::instance().leave();
+    }
+    pinned_ = other.pinned_;
+    return *this;
+  }
+
+ private:
+  bool pinned_;
+};
+
+inline EpochDomain& EpochDomain::instance() {
+  static EpochDomain domain;
+  return domain;
+}
+
+// Only runs at exit, when no other thread uses the domain any more
+inline EpochDomain::~EpochDomain() {
+  Record* record = records_.load(std::memory_order_acquire);
+  while (record) {
+    for (auto& bucket : record->buckets) {
+      flush(bucket);
+    }
+    Record* next = record->next;
+    delete record;
+    record = next;
+  }
+}
+
+// Announces the current epoch. The fence orders the announcement before any
+// load of a shared pointer, which tryAdvance relies on. Announcing and
+// leaving release, and tryAdvance acquires, so everything a thread read
+// while pinned happens before what is freed after the epoch moves on
+inline void EpochDomain::enter() {
+  Record* record = local();
+  if (record->nesting++ == 0) {
+    record->epoch.store(epoch_.load(std::memory_order_relaxed),
+                        std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+}
+
+inline void EpochDomain::leave() {
+  Record* record = local();
+  if (--record->nesting == 0) {
+    record->epoch.store(kIdle, std::memory_order_release);
+  }
+}
+
+// Queues object for deleter once no pinned thread can reach it. object has to
+// be unlinked already, the epoch it is filed under is read after that. Buckets
+// two or more epochs old are freed first
+inline void EpochDomain::retire(void* object, Deleter deleter) {
+  Record* record = local();
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  std::uint64_t epoch = epoch_.load(std::memory_order_acquire);
+  if (++record->retired % kAdvanceEvery == 0 && tryAdvance(epoch)) {
+    ++epoch;
+  }
+  for (int i = 0; i < 3; ++i) {
+    if (record->bucketEpoch[i] + 2 <= epoch) {
+      flush(record->buckets[i]);
+    }
+  }
+  record->bucketEpoch[epoch % 3] = epoch;
+  record->buckets[epoch % 3].push_back({object, deleter});
+}
+
+inline EpochDomain::Record* EpochDomain::local() {
+  thread_local ThreadSlot slot;
+  if (!slot.record) {
+    slot.record = acquire();
+  }
+  return slot.record;
+}
+
+// A record freed by an exited thread, or a new one. Records are never
+// unlinked, so walking the list needs no protection
+inline EpochDomain::Record* EpochDomain::acquire() {
+  for (Record* record = records_.load(std::memory_order_acquire); record;
+       record = record->next) {
+    bool used = false;
+    if (!record->used.load(std::memory_order_relaxed) &&
+        record->used.compare_exchange_strong(used, true,
+                                             std::memory_order_acquire)) {
+      return record;
+    }
+  }
+  Record* record = new Record;
+  record->next = records_.load(std::memory_order_relaxed);
+  while (!records_.compare_exchange_weak(record->next, record,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+  }
+  return record;
+}
+
+// Moves the epoch on if every pinned thread has announced the current one
+inline bool EpochDomain::tryAdvance(std::uint64_t epoch) {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  for (Record* record = records_.load(std::memory_order_acquire); record;
+       record = record->next) {
+    std::uint64_t seen = record->epoch.load(std::memory_order_acquire);
+    if (seen != kIdle && seen != epoch) {
+      return false;
+    }
+  }
+  return epoch_.compare_exchange_strong(epoch, epoch + 1,
+                                        std::memory_order_acq_rel);
+}
+
+inline void EpochDomain::flush(std::vector<Retired>& bucket) {
+  for (const Retired& retired : bucket) {
+    retired.deleter(retired.object);
+  }
+  bucket.clear();
+}
+
+// The record keeps the memory this thread retired, its next owner frees it
+inline EpochDomain::ThreadSlot::~ThreadSlot() {
+  if (record) {
+    record->used.store(false, std::memory_order_release);
+  }
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_SET_EPOCH_H_
@@ -0,0 +1,447 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_SET_S21_CONCURRENT_SET_H_
+#define CPP2_S21_CONTAINERS_SRC_SET_S21_CONCURRENT_SET_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include "Epoch.h"
+
+namespace s21 {
+
+// Ordered set for many concurrent writers, a lock-free skip list. insert,
+// erase and contains never block: each step is a single compare-and-swap on
+// one link, and a thread that finds a half-finished removal completes it
+// instead of waiting. Removal first marks the node's links, which freezes
+// them, then unlinks it. Unlinked nodes are freed through EpochDomain once no
+// thread can still be reading them. Iterators walk the bottom level in key
+// order and see a mix of old and new state under concurrent updates. They pin
+// the calling thread's epoch while alive, so they must stay on that thread
+// and should not be kept long
+template <typename KT, typename Compare = std::less<KT>>
+class ConcurrentSet {
+  using key_type = KT;
+  using value_type = KT;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+
+ public:
+  class iterator;
+  using const_iterator = iterator;
+
+  ConcurrentSet();
+  explicit ConcurrentSet(std::initializer_list<value_type> const &items);
+  ConcurrentSet(const ConcurrentSet &) = delete;
+  ConcurrentSet &operator=(const ConcurrentSet &) = delete;
+  ~ConcurrentSet();
+
+  iterator begin();
+  iterator end();
+
+  bool empty();
+  size_type size();
+
+  std::pair<iterator, bool> insert(const value_type &value);
+  size_type erase(const KT &key);
+  void erase(iterator pos);
+  void clear();
+
+  iterator find(const KT &key);
+  bool contains(const KT &key);
+
+ private:
+  // Levels hold about a quarter of the nodes of the level below, which suits
+  // up to 4^16 elements
+  static constexpr int kMaxLevel = 16;
+  // Low bit of a link, set when the node owning the link is being removed
+  static constexpr std::uintptr_t kMark = 1;
+
+  using Link = std::atomic<std::uintptr_t>;
+
+  // A node is followed in memory by its height links, lowest level first.
+  // The inserter and the remover each hold a share of it, the last to let
+  // go unlinks it everywhere and retires it, because the inserter may link
+  // upper levels after the remover has unlinked the node
+  struct alignas(Link) Node {
+    KT key;
+    int height;
+    std::atomic<int> shares;
+
+    Node(const KT &key, int height) : key(key), height(height), shares(2) {}
+    Link &link(int level) { return reinterpret_cast<Link *>(this + 1)[level]; }
+  };
+
+  Link head_[kMaxLevel];
+  std::atomic<size_type> size_;
+
+  static Node *nodeOf(std::uintptr_t link) {
+    return reinterpret_cast<Node *>(link & ~kMark);
+  }
+  static std::uintptr_t address(Node *node) {
+    return reinterpret_cast<std::uintptr_t>(node);
+  }
+  static bool marked(std::uintptr_t link) { return link & kMark; }
+  static bool less(const KT &a, const KT &b) { return Compare{}(a, b); }
+
+  static Node *createNode(const KT &key, int height);
+  static void destroyNode(void *node);
+  static int randomHeight();
+  static Node *skipMarked(Node *node);
+
+  Link &linkOf(Node *node, int level);
+  bool search(const KT &key, Link **preds, Node **succs, bool past);
+  bool scan(const KT &key, Link **preds, Node **succs, bool past);
+  void linkUpper(Node *node, Link **preds, Node **succs);
+  void release(Node *node);
+};
+
+// Forward iterator over the elements present while it walks
+template <typename KT, typename Compare>
+class ConcurrentSet<KT, Compare>::iterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = KT;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const KT *;
+  using reference = const KT &;
+
+  iterator() : node_(nullptr), guard_(false) {}
+
+  iterator &operator++() {
+    node_ = skipMarked(nodeOf(node_->link(0).load(std::memory_order_acquire)));
+    return *this;
+  }
+
+  iterator operator++(int) {
+    iterator old = *this;
+    ++*this;
+    return old;
+  }
+
+  const KT &operator*() const { return node_->key; }
+
+  bool operator==(const iterator &other) const { return node_ == other.node_; }
+  bool operator!=(const iterator &other) const { return !(*this == other); }
+
+ private:
+  friend class ConcurrentSet;
+
+  iterator(Node *node, const EpochGuard &guard)
+      : node_(node), guard_(node ? guard : EpochGuard(false)) {}
+
+  Node *node_;
+  EpochGuard guard_;
+};
+
+template <typename KT, typename Compare>
+ConcurrentSet<KT, Compare>::ConcurrentSet() : size_(0) {
+  for (Link &link : head_) {
+    link.store(0, std::memory_order_relaxed);
+  }
+}
+
+template <typename KT, typename Compare>
+ConcurrentSet<KT, Compare>::ConcurrentSet(
+    std::initializer_list<value_type> const &items)
+    : ConcurrentSet() {
+  for (const value_type &item : items) {
+    insert(item);
+  }
+}
+
+// Frees the nodes still linked, retired ones belong to EpochDomain. No other
+// thread may use the set any more
+template <typename KT, typename Compare>
+ConcurrentSet<KT, Compare>::~ConcurrentSet() {
+  Node *node = nodeOf(head_[0].load(std::memory_order_acquire));
+  while (node) {
+    Node *next = nodeOf(node->link(0).load(std::memory_order_relaxed));
+    destroyNode(node);
+    node = next;
+  }
+}
+
+template <typename KT, typename Compare>
+typename ConcurrentSet<KT, Compare>::iterator
+ConcurrentSet<KT, Compare>::begin() {
+  EpochGuard guard;
+  return iterator(
+      skipMarked(nodeOf(head_[0].load(std::memory_order_acquire))), guard);
+}
+
+template <typename KT, typename Compare>
+typename ConcurrentSet<KT, Compare>::iterator
+ConcurrentSet<KT, Compare>::end() {
+  return iterator();
+}
+
+template <typename KT, typename Compare>
+bool ConcurrentSet<KT, Compare>::empty() {
+  return size() == 0;
+}
+
+// Exact when no update is in flight
+template <typename KT, typename Compare>
+typename ConcurrentSet<KT, Compare>::size_type
+ConcurrentSet<KT, Compare>::size() {
+  return size_.load(std::memory_order_relaxed);
+}
+
+// Links a new node at the bottom level, which is where it becomes visible,
+// then on the levels above
+template <typename KT, typename Compare>
+std::pair<typename ConcurrentSet<KT, Compare>::iterator, bool>
+ConcurrentSet<KT, Compare>::insert(const value_type &value) {
+  EpochGuard guard;
+  Link *preds[kMaxLevel];
+  Node *succs[kMaxLevel];
+  Node *node = nullptr;
+  while (true) {
+    if (search(value, preds, succs, false)) {
+      if (node) {
+        destroyNode(node);
+      }
+      return {iterator(succs[0], guard), false};
+    }
+    if (!node) {
+      node = createNode(value, randomHeight());
+    }
+    for (int level = 0; level < node->height; ++level) {
+      node->link(level).store(address(succs[level]),
+                              std::memory_order_relaxed);
+    }
+    std::uintptr_t expected = address(succs[0]);
+    if (preds[0]->compare_exchange_strong(expected, address(node),
+                                          std::memory_order_acq_rel)) {
+      break;
+    }
+  }
+  size_.fetch_add(1, std::memory_order_relaxed);
+  linkUpper(node, preds, succs);
+  release(node);
+  return {iterator(node, guard), true};
+}
+
+// Links node on its upper levels until done or until a remover marks it
+template <typename KT, typename Compare>
+void ConcurrentSet<KT, Compare>::linkUpper(Node *node, Link **preds,
+                                           Node **succs) {
+  for (int level = 1; level < node->height; ++level) {
+    while (true) {
+      std::uintptr_t next = node->link(level).load(std::memory_order_acquire);
+      if (marked(next)) {
+        return;
+      }
+      if (nodeOf(next) != succs[level] &&
+          !node->link(level).compare_exchange_strong(
+              next, address(succs[level]), std::memory_order_acq_rel)) {
+        continue;
+      }
+      std::uintptr_t expected = address(succs[level]);
+      if (preds[level]->compare_exchange_strong(expected, address(node),
+                                                std::memory_order_acq_rel)) {
+        break;
+      }
+      search(node->key, preds, succs, false);
+    }
+  }
+}
+
+// Marks the node's links from the top down. Whoever marks the bottom link
+// has removed the element
+template <typename KT, typename Compare>
+typename ConcurrentSet<KT, Compare>::size_type
+ConcurrentSet<KT, Compare>::erase(const KT &key) {
+  EpochGuard guard;
+  Link *preds[kMaxLevel];
+  Node *succs[kMaxLevel];
+  if (!search(key, preds, succs, false)) {
+    return 0;
+  }
+  Node *node = succs[0];
+  for (int level = node->height - 1; level > 0; --level) {
+    Link &link = node->link(level);
+    std::uintptr_t next = link.load(std::memory_order_acquire);
+    while (!marked(next) &&
+           !link.compare_exchange_weak(next, next | kMark,
+                                       std::memory_order_acq_rel)) {
+    }
+  }
+  std::uintptr_t next = node->link(0).load(std::memory_order_acquire);
+  while (!marked(next)) {
+    if (node->link(0).compare_exchange_weak(next, next | kMark,
+                                            std::memory_order_acq_rel)) {
+      size_.fetch_sub(1, std::memory_order_relaxed);
+      release(node);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+template <typename KT, typename Compare>
+void ConcurrentSet<KT, Compare>::erase(iterator pos) {
+  erase(*pos);
+}
+
+// Erases elements one at a time, others may insert meanwhile
+template <typename KT, typename Compare>
+void ConcurrentSet<KT, Compare>::clear() {
+  for (auto it = begin(); it != end(); ++it) {
+    erase(*it);
+  }
+}
+
+template <typename KT, typename Compare>
+typename ConcurrentSet<KT, Compare>::iterator ConcurrentSet<KT, Compare>::find(
+    const KT &key) {
+  EpochGuard guard;
+  Link *preds[kMaxLevel];
+  Node *succs[kMaxLevel];
+  return search(key, preds, succs, false) ? iterator(succs[0], guard) : end();
+}
+
+// Walks past marked nodes without unlinking them, so lookups only read
+template <typename KT, typename Compare>
+bool ConcurrentSet<KT, Compare>::contains(const KT &key) {
+  EpochGuard guard;
+  Node *pred = nullptr;
+  Node *curr = nullptr;
+  for (int level = kMaxLevel - 1; level >= 0; --level) {
+    curr = nodeOf(linkOf(pred, level).load(std::memory_order_acquire));
+    while (curr) {
+      std::uintptr_t next = curr->link(level).load(std::memory_order_acquire);
+      if (!marked(next) && !less(curr->key, key)) {
+        break;
+      }
+      if (!marked(next)) {
+        pred = curr;
+      }
+      curr = nodeOf(next);
+    }
+  }
+  return curr && !less(key, curr->key);
+}
+
+// Storage for the node and its links in one allocation
+template <typename KT, typename Compare>
+typename ConcurrentSet<KT, Compare>::Node *
+ConcurrentSet<KT, Compare>::createNode(const KT &key, int height) {
+  void *raw = ::operator new(sizeof(Node) + height * sizeof(Link));
+  Node *node = new (raw) Node(key, height);
+  for (int level = 0; level < height; ++level) {
+    new (&node->link(level)) Link(0);
+  }
+  return node;
+}
+
+template <typename KT, typename Compare>
+void ConcurrentSet<KT, Compare>::destroyNode(void *raw) {
+  static_cast<Node *>(raw)->~Node();
+  ::operator delete(raw);
+}
+
+// Each extra level with probability 1/4, from a per-thread xorshift
+template <typename KT, typename Compare>
+int ConcurrentSet<KT, Compare>::randomHeight() {
+  thread_local std::uint64_t state =
+      0x9E3779B97F4A7C15ULL ^ reinterpret_cast<std::uintptr_t>(&state);
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  std::uint64_t bits = state;
+  int height = 1;
+  while (height < kMaxLevel && (bits & 3) == 0) {
+    ++height;
+    bits >>= 2;
+  }
+  return height;
+}
+
+// First node from node on that is not being removed
+template <typename KT, typename Compare>
+typename ConcurrentSet<KT, Compare>::Node *
+ConcurrentSet<KT, Compare>::skipMarked(Node *node) {
+  while (node) {
+    std::uintptr_t next = node->link(0).load(std::memory_order_acquire);
+    if (!marked(next)) {
+      break;
+    }
+    node = nodeOf(next);
+  }
+  return node;
+}
+
+// Link of node on level, the head's for nullptr
+template <typename KT, typename Compare>
+typename ConcurrentSet<KT, Compare>::Link &ConcurrentSet<KT, Compare>::linkOf(
+    Node *node, int level) {
+  return node ? node->link(level) : head_[level];
+}
+
+// Fills preds with the links to update and succs with the nodes after them
+// on every level, for a node with key. Returns whether the bottom level holds
+// key. With past set it walks over nodes equal to key too, which unlinks all
+// of them that are marked
+template <typename KT, typename Compare>
+bool ConcurrentSet<KT, Compare>::search(const KT &key, Link **preds,
+                                        Node **succs, bool past) {
+  while (!scan(key, preds, succs, past)) {
+  }
+  return !past && succs[0] && !less(key, succs[0]->key);
+}
+
+// One attempt of search, unlinking marked nodes on the way. Fails when a
+// link changed under it
+template <typename KT, typename Compare>
+bool ConcurrentSet<KT, Compare>::scan(const KT &key, Link **preds,
+                                      Node **succs, bool past) {
+  Node *pred = nullptr;
+  for (int level = kMaxLevel - 1; level >= 0; --level) {
+    Link *link = &linkOf(pred, level);
+    Node *curr = nodeOf(link->load(std::memory_order_acquire));
+    while (curr) {
+      std::uintptr_t next = curr->link(level).load(std::memory_order_acquire);
+      if (marked(next)) {
+        std::uintptr_t expected = address(curr);
+        if (!link->compare_exchange_strong(expected, next & ~kMark,
+                                           std::memory_order_acq_rel)) {
+          return false;
+        }
+        curr = nodeOf(next);
+      } else if (less(curr->key, key) || (past && !less(key, curr->key))) {
+        pred = curr;
+        link = &curr->link(level);
+        curr = nodeOf(next);
+      } else {
+        break;
+      }
+    }
+    preds[level] = link;
+    succs[level] = curr;
+  }
+  return true;
+}
+
+// Drops one share of node. The last one unlinks it from every level, which
+// no other thread can undo by then, and hands it to EpochDomain
+template <typename KT, typename Compare>
+void ConcurrentSet<KT, Compare>::release(Node *node) {
+  if (node->shares.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+  Link *preds[kMaxLevel];
+  Node *succs[kMaxLevel];
+  search(node->key, preds, succs, true);
+  EpochDomain::instance().retire(node, &destroyNode);
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_SET_S21_CONCURRENT_SET_H_
@@ -0,0 +1,146 @@
+#include "s21_concurrent_set.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(ConcurrentSet, single_thread) {
+  s21::ConcurrentSet<int> set{5, 1, 3};
+  ASSERT_EQ(set.size(), 3U);
+  ASSERT_TRUE(set.insert(4).second);
+  auto result = set.insert(3);
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(*result.first, 3);
+  ASSERT_TRUE(set.contains(4));
+  ASSERT_FALSE(set.contains(2));
+  ASSERT_EQ(*set.find(5), 5);
+  ASSERT_TRUE(set.find(2) == set.end());
+  ASSERT_EQ(set.erase(4), 1U);
+  ASSERT_EQ(set.erase(4), 0U);
+  set.erase(set.find(1));
+  std::vector<int> items(set.begin(), set.end());
+  ASSERT_EQ(items, (std::vector<int>{3, 5}));
+  set.clear();
+  ASSERT_TRUE(set.empty());
+  ASSERT_TRUE(set.begin() == set.end());
+}
+
+TEST(ConcurrentSet, erase_under_an_iterator) {
+  s21::ConcurrentSet<std::string, std::greater<std::string>> set;
+  std::vector<std::string> expected;
+  for (int i = 0; i < 1000; ++i) {
+    set.insert(std::to_string(i));
+    expected.push_back(std::to_string(i));
+  }
+  std::sort(expected.begin(), expected.end(), std::greater<std::string>());
+  {
+    // The iterator keeps the node it stands on readable after the node is
+    // unlinked, and its frozen link still leads on to the rest
+    auto it = set.begin();
+    for (size_t i = 0; i < expected.size(); ++i, ++it) {
+      ASSERT_EQ(*it, expected[i]);
+      if (i % 2 == 0) {
+        std::string key = *it;
+        ASSERT_EQ(set.erase(key), 1U);
+        ASSERT_FALSE(set.contains(key));
+      }
+    }
+    ASSERT_TRUE(it == set.end());
+  }
+  ASSERT_EQ(set.size(), 500U);
+  // Erased keys come back as new nodes
+  for (size_t i = 0; i < expected.size(); i += 2) {
+    ASSERT_TRUE(set.insert(expected[i]).second);
+  }
+  ASSERT_EQ(std::vector<std::string>(set.begin(), set.end()), expected);
+  // Taking keys off the front, as a priority queue does
+  for (const std::string &key : expected) {
+    auto front = set.begin();
+    ASSERT_EQ(*front, key);
+    set.erase(front);
+    ASSERT_FALSE(set.contains(key));
+  }
+  ASSERT_TRUE(set.empty());
+  ASSERT_TRUE(set.begin() == set.end());
+}
+
+TEST(ConcurrentSet, parallel_writers) {
+  s21::ConcurrentSet<int> set;
+  const int threads = 8;
+  const int keys = 4000;
+  std::atomic<int> inserted(0);
+  std::atomic<int> erased(0);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      for (int round = 0; round < 3; ++round) {
+        for (int i = t; i < keys; i += 2) {
+          inserted += set.insert(i).second;
+        }
+        for (int i = t; i < keys; i += 3) {
+          erased += static_cast<int>(set.erase(i));
+        }
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  ASSERT_EQ(set.size(), static_cast<size_t>(inserted - erased));
+  int previous = -1;
+  size_t count = 0;
+  for (int key : set) {
+    ASSERT_LT(previous, key);
+    previous = key;
+    ++count;
+  }
+  ASSERT_EQ(count, set.size());
+}
+
+TEST(ConcurrentSet, readers_see_stable_keys) {
+  s21::ConcurrentSet<int> set;
+  for (int i = 0; i < 2000; i += 2) {
+    set.insert(i);
+  }
+  std::atomic<int> wrong(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 3; ++t) {
+    threads.emplace_back([&] {
+      for (int round = 0; round < 30; ++round) {
+        for (int i = 0; i < 2000; i += 2) {
+          wrong += !set.contains(i);
+        }
+        int previous = -1;
+        for (int key : set) {
+          wrong += key <= previous;
+          previous = key;
+        }
+      }
+    });
+  }
+  threads.emplace_back([&] {
+    for (int round = 0; round < 30; ++round) {
+      for (int i = 1; i < 2000; i += 2) {
+        set.insert(i);
+      }
+      for (int i = 1; i < 2000; i += 2) {
+        set.erase(i);
+      }
+    }
+  });
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(wrong, 0);
+  ASSERT_EQ(set.size(), 1000U);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,394 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_SET_S21_FLAT_SET_H_
+#define CPP2_S21_CONTAINERS_SRC_SET_S21_FLAT_SET_H_
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "../Map/SortedSearch.h"
+#include "../Map/ThreeWayCompare.h"
+#include "../Vector/s21_vector.h"
+
+namespace s21 {
+
+// Set kept as one sorted s21::Vector of keys, the key-only counterpart of
+// FlatMap. Iterators are plain pointers into the array. insert and erase
+// shift the array in O(n) and invalidate iterators
+template <typename KT, typename Compare = std::less<KT>>
+class FlatSet {
+  using key_type = KT;
+  using value_type = KT;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+
+ public:
+  using iterator = const KT *;
+  using const_iterator = iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  FlatSet();
+  explicit FlatSet(std::initializer_list<value_type> const &items);
+  FlatSet(const FlatSet &other);
+  FlatSet(FlatSet &&other) noexcept;
+  FlatSet &operator=(const FlatSet &other);
+  FlatSet &operator=(FlatSet &&other) noexcept;
+
+  template <typename It>
+  void build(It first, It last);
+
+  iterator begin();
+  iterator end();
+  reverse_iterator rbegin();
+  reverse_iterator rend();
+
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+  void reserve(size_type count);
+
+  void clear();
+  std::pair<iterator, bool> insert(const value_type &value);
+  template <class... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+  void erase(iterator pos);
+  size_type erase(const KT &key);
+  void swap(FlatSet &other);
+  void merge(FlatSet &other);
+
+  iterator find(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  iterator find(const K &key);
+  bool contains(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  bool contains(const K &key);
+  size_type count(const KT &key);
+  iterator lower_bound(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  iterator lower_bound(const K &key);
+  iterator upper_bound(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  iterator upper_bound(const K &key);
+  std::pair<iterator, iterator> equal_range(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  std::pair<iterator, iterator> equal_range(const K &key);
+
+ private:
+  template <typename K>
+  iterator findKey(const K &key);
+
+  Vector<KT> keys_;
+  Compare compare_;
+};
+
+// Default constructor, creates empty FlatSet
+template <typename KT, typename Compare>
+FlatSet<KT, Compare>::FlatSet() : keys_(), compare_() {}
+
+// Initializer list constructor, built with a single sort
+template <typename KT, typename Compare>
+FlatSet<KT, Compare>::FlatSet(std::initializer_list<value_type> const &items)
+    : FlatSet() {
+  build(items.begin(), items.end());
+}
+
+// Copy constructor
+template <typename KT, typename Compare>
+FlatSet<KT, Compare>::FlatSet(const FlatSet &other)
+    : keys_(other.keys_), compare_(other.compare_) {}
+
+// Move constructor
+template <typename KT, typename Compare>
+FlatSet<KT, Compare>::FlatSet(FlatSet &&other) noexcept : FlatSet() {
+  swap(other);
+}
+
+// Assignment operator overload for copy object
+template <typename KT, typename Compare>
+FlatSet<KT, Compare> &FlatSet<KT, Compare>::operator=(const FlatSet &other) {
+  if (this == &other) return *this;
+  FlatSet tmp(other);
+  swap(tmp);
+  return *this;
+}
+
+// Assignment operator overload for moving object
+template <typename KT, typename Compare>
+FlatSet<KT, Compare> &FlatSet<KT, Compare>::operator=(
+    FlatSet &&other) noexcept {
+  if (this == &other) return *this;
+  swap(other);
+  return *this;
+}
+
+// Replaces the contents with the keys of [first, last), sorted once. Input
+// already in order skips the sort, duplicates are dropped
+template <typename KT, typename Compare>
+template <typename It>
+void FlatSet<KT, Compare>::build(It first, It last) {
+  std::vector<KT> items(first, last);
+  if (!std::is_sorted(items.begin(), items.end(), compare_)) {
+    std::sort(items.begin(), items.end(), compare_);
+  }
+  auto end = std::unique(items.begin(), items.end(),
+                         [this](const KT &left, const KT &right) {
+                           return !compare_(left, right);
+                         });
+  Vector<KT> keys(static_cast<size_type>(end - items.begin()));
+  std::move(items.begin(), end, keys.begin());
+  keys_.swap(keys);
+}
+
+// Returns an iterator to the beginning
+template <typename KT, typename Compare>
+typename FlatSet<KT, Compare>::iterator FlatSet<KT, Compare>::begin() {
+  return keys_.begin();
+}
+
+// Returns an iterator to the end
+template <typename KT, typename Compare>
+typename FlatSet<KT, Compare>::iterator FlatSet<KT, Compare>::end() {
+  return keys_.end();
+}
+
+// Returns a reverse iterator to the last element
+template <typename KT, typename Compare>
+typename FlatSet<KT, Compare>::reverse_iterator FlatSet<KT, Compare>::rbegin() {
+  return reverse_iterator(end());
+}
+
+// Returns a reverse iterator before the first element
+template <typename KT, typename Compare>
+typename FlatSet<KT, Compare>::reverse_iterator FlatSet<KT, Compare>::rend() {
+  return reverse_iterator(begin());
+}
+
+// Checks whether the container is empty
+template <typename KT, typename Compare>
+bool FlatSet<KT, Compare>::empty() const noexcept {
+  return keys_.size() == 0;
+}
+
+// Returns the number of elements
+template <typename KT, typename Compare>
+typename FlatSet<KT, Compare>::size_type FlatSet<KT, Compare>::size()
+    const noexcept {
+  return keys_.size();
+}
+
+// Returns the maximum possible number of elements
+template <typename KT, typename Compare>
+typename FlatSet<KT, Compare>::size_type FlatSet<KT, Compare>::max_size()
+    const noexcept {
+  return keys_.max_size();
+}
+
+// Allocates room for count elements
+template <typename KT, typename Compare>
+void FlatSet<KT, Compare>::reserve(size_type count) {
+  keys_.reserve(count);
+}
+
+// Clears the contents
+template <typename KT, typename Compare>
+void FlatSet<KT, Compare>::clear() {
+  keys_.clear();
+}
+
+// Inserts value unless it is present, shifting the elements after it
+template <typename KT, typename Compare>
+std::pair<typename FlatSet<KT, Compare>::iterator, bool>
+FlatSet<KT, Compare>::insert(const KT &value) {
+  iterator pos = lower_bound(value);
+  size_type index = static_cast<size_type>(pos - begin());
+  if (pos != end() && !compare_(value, *pos)) {
+    return {pos, false};
+  }
+  keys_.push_back(value);
+  std::rotate(keys_.begin() + index, keys_.end() - 1, keys_.end());
+  return {begin() + index, true};
+}
+
+// Inserts the values one by one, as insert does, and returns for each where
+// it ends up and whether it was new. Every insertion shifts the elements
+// after it, so the iterators are looked up after the last one
+template <typename KT, typename Compare>
+template <class... Args>
+std::vector<std::pair<typename FlatSet<KT, Compare>::iterator, bool>>
+FlatSet<KT, Compare>::insert_many(Args &&...args) {
+  std::initializer_list<value_type> items = {
+      value_type(std::forward<Args>(args))...};
+  std::vector<std::pair<iterator, bool>> result;
+  for (const value_type &item : items) {
+    result.push_back(insert(item));
+  }
+  auto position = result.begin();
+  for (const value_type &item : items) {
+    (position++)->first = find(item);
+  }
+  return result;
+}
+
+// Removes the element at pos, shifting the elements after it
+template <typename KT, typename Compare>
+void FlatSet<KT, Compare>::erase(iterator pos) {
+  auto index = pos - begin();
+  std::move(keys_.begin() + index + 1, keys_.end(), keys_.begin() + index);
+  keys_.pop_back();
+}
+
+// Removes key and returns how many elements were removed
+template <typename KT, typename Compare>
+typename FlatSet<KT, Compare>::size_type FlatSet<KT, Compare>::erase(
+    const KT &key) {
+  iterator pos = find(key);
+  if (pos == end()) {
+    return 0;
+  }
+  erase(pos);
+  return 1;
+}
+
+// Swaps the contents
+template <typename KT, typename Compare>
+void FlatSet<KT, Compare>::swap(FlatSet &other) {
+  keys_.swap(other.keys_);
+  std::swap(compare_, other.compare_);
+}
+
+// Moves the values of other that are missing here into this set, the rest
+// stays in other. Both arrays are merged in one pass, O(n + m)
+template <typename KT, typename Compare>
+void FlatSet<KT, Compare>::merge(FlatSet &other) {
+  if (this == &other) return;
+  size_type total = size() + other.size();
+  Vector<KT> keys(total);
+  Vector<KT> kept(other.size());
+  size_type mine = 0, theirs = 0, added = 0, left = 0;
+  while (mine != size() || theirs != other.size()) {
+    bool takeMine =
+        theirs == other.size() ||
+        (mine != size() && !compare_(other.keys_[theirs], keys_[mine]));
+    if (takeMine) {
+      if (theirs != other.size() &&
+          !compare_(keys_[mine], other.keys_[theirs])) {
+        kept[left++] = std::move(other.keys_[theirs++]);
+      }
+      keys[added++] = std::move(keys_[mine++]);
+    } else {
+      keys[added++] = std::move(other.keys_[theirs++]);
+    }
+  }
+  for (; added != total; --total) {
+    keys.pop_back();
+  }
+  for (size_type count = other.size(); count != left; --count) {
+    kept.pop_back();
+  }
+  keys_.swap(keys);
+  other.keys_.swap(kept);
+}
+
+// Finds an element with key equivalent to key
+template <typename KT, typename Compare>
+typename FlatSet<KT, Compare>::iterator FlatSet<KT, Compare>::find(
+    const KT &key) {
+  return findKey(key);
+}
+
+// find for a key of another type under a transparent Compare
+template <typename KT, typename Compare>
+template <typename K, typename>
+typename FlatSet<KT, Compare>::iterator FlatSet<KT, Compare>::find(
+    const K &key) {
+  return findKey(key);
+}
+
+// Checks if there is an element with key equivalent to key in the container
+template <typename KT, typename Compare>
+bool FlatSet<KT, Compare>::contains(const KT &key) {
+  return findKey(key) != end();
+}
+
+// contains for a key of another type under a transparent Compare
+template <typename KT, typename Compare>
+template <typename K, typename>
+bool FlatSet<KT, Compare>::contains(const K &key) {
+  return findKey(key) != end();
+}
+
+// Returns the number of elements equal to key, zero or one
+template <typename KT, typename Compare>
+typename FlatSet<KT, Compare>::size_type FlatSet<KT, Compare>::count(
+    const KT &key) {
+  return contains(key) ? 1 : 0;
+}
+
+// Returns an iterator to the first element not less than key
+template <typename KT, typename Compare>
+typename FlatSet<KT, Compare>::iterator FlatSet<KT, Compare>::lower_bound(
+    const KT &key) {
+  return branchlessLowerBound<KT>(begin(), size(), key, compare_);
+}
+
+// lower_bound for a key of another type under a transparent Compare
+template <typename KT, typename Compare>
+template <typename K, typename>
+typename FlatSet<KT, Compare>::iterator FlatSet<KT, Compare>::lower_bound(
+    const K &key) {
+  return branchlessLowerBound<KT>(begin(), size(), key, compare_);
+}
+
+// Returns an iterator to the first element greater than key
+template <typename KT, typename Compare>
+typename FlatSet<KT, Compare>::iterator FlatSet<KT, Compare>::upper_bound(
+    const KT &key) {
+  return branchlessUpperBound<KT>(begin(), size(), key, compare_);
+}
+
+// upper_bound for a key of another type under a transparent Compare
+template <typename KT, typename Compare>
+template <typename K, typename>
+typename FlatSet<KT, Compare>::iterator FlatSet<KT, Compare>::upper_bound(
+    const K &key) {
+  return branchlessUpperBound<KT>(begin(), size(), key, compare_);
+}
+
+// Returns the range of elements equal to key, empty or a single one
+template <typename KT, typename Compare>
+std::pair<typename FlatSet<KT, Compare>::iterator,
+          typename FlatSet<KT, Compare>::iterator>
+FlatSet<KT, Compare>::equal_range(const KT &key) {
+  iterator pos = lower_bound(key);
+  return {pos, pos + (pos != end() && !compare_(key, *pos))};
+}
+
+// equal_range for a key of another type under a transparent Compare
+template <typename KT, typename Compare>
+template <typename K, typename>
+std::pair<typename FlatSet<KT, Compare>::iterator,
+          typename FlatSet<KT, Compare>::iterator>
+FlatSet<KT, Compare>::equal_range(const K &key) {
+  iterator pos = lower_bound(key);
+  return {pos, pos + (pos != end() && !compare_(key, *pos))};
+}
+
+template <typename KT, typename Compare>
+template <typename K>
+typename FlatSet<KT, Compare>::iterator FlatSet<KT, Compare>::findKey(
+    const K &key) {
+  iterator pos = branchlessLowerBound<KT>(begin(), size(), key, compare_);
+  if (pos != end() && compare_(key, *pos)) {
+    return end();
+  }
+  return pos;
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_SET_S21_FLAT_SET_H_
@@ -0,0 +1,112 @@
+#include "s21_flat_set.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST(FlatSet, basic_operations) {
+  s21::FlatSet<int> set{5, 1, 3, 1};
+  ASSERT_EQ(set.size(), 3U);
+  ASSERT_TRUE(set.insert(4).second);
+  auto result = set.insert(3);
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(*result.first, 3);
+  ASSERT_TRUE(set.contains(4));
+  ASSERT_EQ(set.count(2), 0U);
+  ASSERT_TRUE(set.find(2) == set.end());
+  ASSERT_EQ(*set.lower_bound(2), 3);
+  ASSERT_EQ(*set.upper_bound(4), 5);
+  ASSERT_EQ(set.erase(4), 1U);
+  ASSERT_EQ(set.erase(4), 0U);
+  set.erase(set.find(1));
+  ASSERT_EQ(std::vector<int>(set.begin(), set.end()),
+            (std::vector<int>{3, 5}));
+  ASSERT_EQ(std::vector<int>(set.rbegin(), set.rend()),
+            (std::vector<int>{5, 3}));
+  set.clear();
+  ASSERT_TRUE(set.empty());
+  ASSERT_TRUE(set.begin() == set.end());
+}
+
+TEST(FlatSet, copy_and_move_assignment) {
+  s21::FlatSet<int> set{3, 1, 2};
+  s21::FlatSet<int> copy{9};
+  copy = set;
+  set.insert(4);
+  ASSERT_EQ(std::vector<int>(copy.begin(), copy.end()),
+            (std::vector<int>{1, 2, 3}));
+  auto &self = copy;
+  copy = self;
+  ASSERT_EQ(copy.size(), 3U);
+  s21::FlatSet<int> moved;
+  moved = std::move(set);
+  ASSERT_EQ(moved.size(), 4U);
+  ASSERT_EQ(*moved.upper_bound(3), 4);
+  s21::FlatSet<int> built(std::move(moved));
+  ASSERT_TRUE(built.contains(4));
+}
+
+TEST(FlatSet, build_and_shift) {
+  s21::FlatSet<std::string> set{"stale"};
+  std::vector<std::string> words{"pear", "fig", "apple", "fig", "kiwi",
+                                 "apple", "date", "pear"};
+  set.build(words.begin(), words.end());
+  ASSERT_EQ(std::vector<std::string>(set.begin(), set.end()),
+            (std::vector<std::string>{"apple", "date", "fig", "kiwi",
+                                      "pear"}));
+  // In order with duplicates, so only the duplicates go
+  std::vector<std::string> sorted{"a", "a", "b", "c", "c", "c"};
+  set.build(sorted.begin(), sorted.end());
+  ASSERT_EQ(std::vector<std::string>(set.begin(), set.end()),
+            (std::vector<std::string>{"a", "b", "c"}));
+  // Inserts before the first and after the last key, erases in the middle
+  ASSERT_TRUE(set.insert("0").second);
+  ASSERT_TRUE(set.insert("z").second);
+  ASSERT_TRUE(set.insert("bb").second);
+  ASSERT_EQ(set.erase("b"), 1U);
+  set.erase(set.find("0"));
+  ASSERT_EQ(std::vector<std::string>(set.begin(), set.end()),
+            (std::vector<std::string>{"a", "bb", "c", "z"}));
+  ASSERT_EQ(*set.lower_bound("b"), "bb");
+  ASSERT_EQ(*set.upper_bound("bb"), "c");
+  s21::FlatSet<std::string> empty;
+  empty.build(sorted.end(), sorted.end());
+  ASSERT_TRUE(empty.empty());
+}
+
+TEST(FlatSet, merge_insert_many_and_equal_range) {
+  s21::FlatSet<int> set{1, 3, 5, 7};
+  s21::FlatSet<int> other{0, 3, 4, 7, 9};
+  set.merge(other);
+  ASSERT_EQ(std::vector<int>(set.begin(), set.end()),
+            (std::vector<int>{0, 1, 3, 4, 5, 7, 9}));
+  ASSERT_EQ(std::vector<int>(other.begin(), other.end()),
+            (std::vector<int>{3, 7}));
+  set.merge(set);
+  ASSERT_EQ(set.size(), 7U);
+  auto results = set.insert_many(8, 2, 8, 3);
+  ASSERT_TRUE(results[0].second);
+  ASSERT_EQ(*results[0].first, 8);
+  ASSERT_EQ(*results[1].first, 2);
+  ASSERT_FALSE(results[2].second);
+  ASSERT_FALSE(results[3].second);
+  ASSERT_EQ(*results[3].first, 3);
+  ASSERT_EQ(set.size(), 9U);
+  auto range = set.equal_range(4);
+  ASSERT_EQ(range.second - range.first, 1);
+  ASSERT_EQ(*range.first, 4);
+  range = set.equal_range(6);
+  ASSERT_TRUE(range.first == range.second);
+  ASSERT_EQ(*range.first, 7);
+  s21::FlatSet<std::string, std::less<>> words{"fig", "kiwi"};
+  auto found = words.equal_range(std::string_view("kiwi"));
+  ASSERT_EQ(found.second - found.first, 1);
+  ASSERT_TRUE(found.second == words.end());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,210 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_SET_S21_MAPPED_SET_H_
+#define CPP2_S21_CONTAINERS_SRC_SET_S21_MAPPED_SET_H_
+
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "../Map/Snapshot.h"
+#include "../Map/SortedSearch.h"
+
+namespace s21 {
+
+// Read-only set served straight from a snapshot file written by save(), the
+// key-only counterpart of MappedMap. Iterators are plain pointers into the
+// mapping and stay valid as long as the MappedSet that made them
+template <typename KT, typename Compare = std::less<KT>>
+class MappedSet {
+  static_assert(std::is_trivially_copyable_v<KT>,
+                "MappedSet stores keys as raw bytes");
+
+  using key_type = KT;
+  using value_type = KT;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+
+ public:
+  using iterator = const KT *;
+  using const_iterator = iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  explicit MappedSet(const std::string &path);
+  MappedSet(MappedSet &&other) noexcept;
+  MappedSet &operator=(MappedSet &&other) noexcept;
+
+  template <typename Container>
+  static void save(Container &items, const std::string &path);
+
+  iterator find(const KT &key) const;
+  bool contains(const KT &key) const;
+  size_type count(const KT &key) const;
+  iterator lower_bound(const KT &key) const;
+  iterator upper_bound(const KT &key) const;
+
+  iterator begin() const;
+  iterator end() const;
+  reverse_iterator rbegin() const;
+  reverse_iterator rend() const;
+
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  void swap(MappedSet &other) noexcept;
+
+ private:
+  void bind();
+
+  SnapshotFile file_;
+  const KT *keys_;
+  size_type size_;
+  Compare compare_;
+};
+
+// Maps the snapshot at path, throws std::system_error if it cannot be read
+// and std::runtime_error if it is not a set snapshot of this KT
+template <typename KT, typename Compare>
+MappedSet<KT, Compare>::MappedSet(const std::string &path)
+    : file_(path, sizeof(KT), 0), compare_() {
+  bind();
+}
+
+// Move constructor
+template <typename KT, typename Compare>
+MappedSet<KT, Compare>::MappedSet(MappedSet &&other) noexcept
+    : file_(std::move(other.file_)), compare_(other.compare_) {
+  bind();
+  other.bind();
+}
+
+// Assignment operator overload for moving object
+template <typename KT, typename Compare>
+MappedSet<KT, Compare> &MappedSet<KT, Compare>::operator=(
+    MappedSet &&other) noexcept {
+  swap(other);
+  return *this;
+}
+
+// Writes the keys of items, an ordered set such as Set or FlatSet, to a
+// snapshot at path. Throws std::invalid_argument unless items iterates in
+// ascending order under Compare without duplicates
+template <typename KT, typename Compare>
+template <typename Container>
+void MappedSet<KT, Compare>::save(Container &items, const std::string &path) {
+  SnapshotHeader header = SnapshotHeader::make(sizeof(KT), 0, items.size());
+  SnapshotWriter writer(path);
+  writer.write(&header, sizeof(header));
+  writer.skipTo(header.keysOffset);
+  Compare compare;
+  const KT *previous = nullptr;
+  for (auto it = items.begin(); it != items.end(); ++it) {
+    const KT &key = *it;
+    if (previous && !compare(*previous, key)) {
+      throw std::invalid_argument("s21::MappedSet::save: keys out of order");
+    }
+    writer.write(&key, sizeof(KT));
+    previous = &key;
+  }
+  writer.commit();
+}
+
+// Find element by key
+template <typename KT, typename Compare>
+typename MappedSet<KT, Compare>::iterator MappedSet<KT, Compare>::find(
+    const KT &key) const {
+  iterator it = lower_bound(key);
+  return it == end() || compare_(key, *it) ? end() : it;
+}
+
+// Checks if there is an element with key equivalent to key in the container
+template <typename KT, typename Compare>
+bool MappedSet<KT, Compare>::contains(const KT &key) const {
+  return find(key) != end();
+}
+
+// Returns the number of elements with the key, zero or one
+template <typename KT, typename Compare>
+typename MappedSet<KT, Compare>::size_type MappedSet<KT, Compare>::count(
+    const KT &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+// Returns an iterator to the first element not less than key
+template <typename KT, typename Compare>
+typename MappedSet<KT, Compare>::iterator MappedSet<KT, Compare>::lower_bound(
+    const KT &key) const {
+  return branchlessLowerBound(keys_, size_, key, compare_);
+}
+
+// Returns an iterator to the first element greater than key
+template <typename KT, typename Compare>
+typename MappedSet<KT, Compare>::iterator MappedSet<KT, Compare>::upper_bound(
+    const KT &key) const {
+  return branchlessUpperBound(keys_, size_, key, compare_);
+}
+
+// Returns an iterator to the beginning
+template <typename KT, typename Compare>
+typename MappedSet<KT, Compare>::iterator MappedSet<KT, Compare>::begin()
+    const {
+  return keys_;
+}
+
+// Returns an iterator to the end
+template <typename KT, typename Compare>
+typename MappedSet<KT, Compare>::iterator MappedSet<KT, Compare>::end() const {
+  return keys_ + size_;
+}
+
+// Returns a reverse iterator to the last element
+template <typename KT, typename Compare>
+typename MappedSet<KT, Compare>::reverse_iterator
+MappedSet<KT, Compare>::rbegin() const {
+  return reverse_iterator(end());
+}
+
+// Returns a reverse iterator before the first element
+template <typename KT, typename Compare>
+typename MappedSet<KT, Compare>::reverse_iterator MappedSet<KT, Compare>::rend()
+    const {
+  return reverse_iterator(begin());
+}
+
+// Checks whether the container is empty
+template <typename KT, typename Compare>
+bool MappedSet<KT, Compare>::empty() const noexcept {
+  return size_ == 0;
+}
+
+// Returns the number of elements
+template <typename KT, typename Compare>
+typename MappedSet<KT, Compare>::size_type MappedSet<KT, Compare>::size()
+    const noexcept {
+  return size_;
+}
+
+// Swaps the mappings
+template <typename KT, typename Compare>
+void MappedSet<KT, Compare>::swap(MappedSet &other) noexcept {
+  std::swap(file_, other.file_);
+  std::swap(compare_, other.compare_);
+  bind();
+  other.bind();
+}
+
+// Points the key array at the current mapping, empty after a move
+template <typename KT, typename Compare>
+void MappedSet<KT, Compare>::bind() {
+  if (!file_.mapped()) {
+    keys_ = nullptr;
+    size_ = 0;
+    return;
+  }
+  keys_ = static_cast<const KT *>(file_.at(file_.header().keysOffset));
+  size_ = static_cast<size_type>(file_.header().count);
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_SET_S21_MAPPED_SET_H_
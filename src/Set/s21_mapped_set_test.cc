@@ -0,0 +1,74 @@
+#include "s21_mapped_set.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "s21_flat_set.h"
+#include "s21_set.h"
+
+namespace {
+
+const std::string kPath = "s21_mapped_set_test.snapshot";
+
+}  // namespace
+
+TEST(MappedSet, basic_operations) {
+  s21::Set<int> source{5, 1, 3};
+  s21::MappedSet<int>::save(source, kPath);
+  s21::MappedSet<int> set(kPath);
+  ASSERT_EQ(set.size(), 3U);
+  ASSERT_TRUE(set.contains(3));
+  ASSERT_EQ(set.count(2), 0U);
+  ASSERT_TRUE(set.find(2) == set.end());
+  ASSERT_EQ(*set.lower_bound(2), 3);
+  ASSERT_EQ(*set.upper_bound(3), 5);
+  ASSERT_EQ(std::vector<int>(set.begin(), set.end()),
+            (std::vector<int>{1, 3, 5}));
+  ASSERT_EQ(std::vector<int>(set.rbegin(), set.rend()),
+            (std::vector<int>{5, 3, 1}));
+  s21::MappedSet<int> moved(std::move(set));
+  ASSERT_TRUE(set.empty());
+  ASSERT_EQ(moved.size(), 3U);
+  ASSERT_THROW((s21::MappedSet<double>(kPath)), std::runtime_error);
+  s21::FlatSet<int> unsorted{2, 1};
+  ASSERT_THROW(
+      (s21::MappedSet<int, std::greater<int>>::save(unsorted, kPath)),
+      std::invalid_argument);
+  std::remove(kPath.c_str());
+}
+
+TEST(MappedSet, search_at_every_size) {
+  // The branchless search halves the range without an early exit, so its
+  // edge cases sit at the sizes around powers of two
+  for (unsigned count = 0; count <= 70; ++count) {
+    s21::FlatSet<unsigned, std::greater<unsigned>> source;
+    for (unsigned i = 0; i < count; ++i) {
+      source.insert(2 * i + 1);
+    }
+    s21::MappedSet<unsigned, std::greater<unsigned>>::save(source, kPath);
+    s21::MappedSet<unsigned, std::greater<unsigned>> set(kPath);
+    ASSERT_EQ(set.size(), count);
+    // Keys are odd and descending, so every even key falls into a gap
+    for (unsigned key = 0; key <= 2 * count + 1; ++key) {
+      unsigned greater = count - std::min(count, (key + 1) / 2);
+      auto lower = set.lower_bound(key);
+      ASSERT_EQ(lower - set.begin(), static_cast<std::ptrdiff_t>(greater))
+          << count << " " << key;
+      ASSERT_EQ(set.contains(key), key % 2 == 1 && key < 2 * count);
+      auto upper = set.upper_bound(key);
+      ASSERT_EQ(upper - lower, set.contains(key) ? 1 : 0);
+    }
+  }
+  std::remove(kPath.c_str());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,35 +1,49 @@
 #ifndef CPP2_S21_CONTAINERS_SRC_SET_S21_SET_H_
 #define CPP2_S21_CONTAINERS_SRC_SET_S21_SET_H_
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
 #include <limits>
 
+#include "../Map/BPlusTree.h"
 #include "../Map/BTree.h"
 
 namespace s21 {
 
-template <typename KT>
+template <typename KT, typename Balance = RedBlackBalance,
+          typename Compare = std::less<KT>>
 class Set {
   using key_type = KT;
   using value_type = KT;
   using reference = value_type &;
   using const_reference = const value_type &;
-  using tree_type = s21::BTree<KT>;
+  using tree_type = typename TreeEngine<KT, KeyOnly, Balance, Compare>::type;
   using iterator = typename tree_type::iterator;
   using const_iterator = const typename tree_type::iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
   using size_type = size_t;
 
  public:
+  using node_type = typename tree_type::node_handle;
+  using insert_return_type = InsertReturn<iterator, node_type>;
+
   Set();
-  explicit Set(std::initializer_list<value_type> const &);
+  explicit Set(const Compare &);
+  explicit Set(std::initializer_list<value_type> const &,
+               const Compare & = Compare());
+  template <typename It>
+  Set(sorted_unique_t, It, It, const Compare & = Compare());
   Set(const Set &s);
   Set(Set &&s);
-  ~Set();
-  reference operator=(std::initializer_list<value_type> const &);
-  reference operator=(const Set &);
-  reference operator=(Set &&);
+  Set &operator=(std::initializer_list<value_type> const &);
+  Set &operator=(const Set &);
+  Set &operator=(Set &&);
 
   iterator begin();
   iterator end();
+  reverse_iterator rbegin();
+  reverse_iterator rend();
 
   bool empty();
   size_type size();
@@ -38,13 +52,41 @@ class Set {
   void clear();
 
   std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <class... Args>
+  iterator emplace_hint(iterator hint, Args &&...args);
+  insert_return_type insert(node_type &&node);
+  node_type extract(iterator pos);
+  node_type extract(const KT &key);
   void erase(iterator pos);
   void erase(const value_type &value);
   void swap(Set &other);
   void merge(Set &other);
 
   iterator find(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  iterator find(const K &key);
   bool contains(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  bool contains(const K &key);
+  size_type count(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  size_type count(const K &key);
+
+  iterator lower_bound(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  iterator lower_bound(const K &key);
+  iterator upper_bound(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  iterator upper_bound(const K &key);
+  std::pair<iterator, iterator> equal_range(const KT &key);
+  template <typename K, typename = EnableTransparent<Compare, K>>
+  std::pair<iterator, iterator> equal_range(const K &key);
+
+  iterator nth(size_type index);
+  size_type rank(const KT &key);
 
  private:
   tree_type tree_;
@@ -52,163 +94,359 @@ class Set {
 };
 
 // Default constructor
-template <typename KT>
-s21::Set<KT>::Set() : tree_(), size_(0) {}
-
-// Constructor for initializer list
-template <typename KT>
-s21::Set<KT>::Set(std::initializer_list<value_type> const &items)
-    : tree_(), size_(0) {
+template <typename KT, typename Balance, typename Compare>
+s21::Set<KT, Balance, Compare>::Set() : tree_(), size_(0) {}
+
+// Creates an empty Set ordered by compare
+template <typename KT, typename Balance, typename Compare>
+s21::Set<KT, Balance, Compare>::Set(const Compare &compare)
+    : tree_(compare), size_(0) {}
+
+// Constructor for initializer list, a list already in ascending order is
+// bulk loaded in linear time
+template <typename KT, typename Balance, typename Compare>
+s21::Set<KT, Balance, Compare>::Set(
+    std::initializer_list<value_type> const &items, const Compare &compare)
+    : tree_(compare), size_(0) {
+  auto unsorted = std::adjacent_find(
+      items.begin(), items.end(),
+      [&compare](const value_type &left, const value_type &right) {
+        return !compare(left, right);
+      });
+  if (unsorted == items.end()) {
+    tree_.assignSorted(items.begin(), items.end());
+    size_ = items.size();
+    return;
+  }
   for (auto item : items) {
-    tree_.insert(item, item);
-    size_++;
+    insert(item);
   }
 }
 
+// Bulk loads [first, last), which has to be in ascending order without
+// duplicates, in linear time
+template <typename KT, typename Balance, typename Compare>
+template <typename It>
+s21::Set<KT, Balance, Compare>::Set(sorted_unique_t, It first, It last,
+                                    const Compare &compare)
+    : tree_(compare), size_(std::distance(first, last)) {
+  tree_.assignSorted(first, last);
+}
+
 // Copy constructor
-template <typename KT>
-s21::Set<KT>::Set(const Set &other) : size_(0) {
-  for (auto it = other.tree_.begin(); it != other.tree_.end(); ++it) {
-    tree_.insert(it.getNode()->key, *it);
-    size_++;
-  }
+template <typename KT, typename Balance, typename Compare>
+s21::Set<KT, Balance, Compare>::Set(const Set &other)
+    : tree_(other.tree_.keyCompare()), size_(other.size_) {
+  tree_.assign(other.tree_);
 }
 
 // Move constructor
-template <typename KT>
-s21::Set<KT>::Set(Set &&other) : Set() {
+template <typename KT, typename Balance, typename Compare>
+s21::Set<KT, Balance, Compare>::Set(Set &&other) : Set() {
   swap(other);
 }
 
-// Destructor
-template <typename KT>
-s21::Set<KT>::~Set() {
-  if (size_ > 0 && tree_.getRoot()) {
-    size_ = 0;
-    tree_.destroy(tree_.getRoot());
-  }
-}
-
 // Getter size_
-template <typename KT>
-typename s21::Set<KT>::size_type s21::Set<KT>::size() {
+template <typename KT, typename Balance, typename Compare>
+typename s21::Set<KT, Balance, Compare>::size_type
+s21::Set<KT, Balance, Compare>::size() {
   return size_;
 }
 
 // Getter maxsize
-template <typename KT>
-typename s21::Set<KT>::size_type s21::Set<KT>::max_size() {
-  return ((std::numeric_limits<size_type>::max() / 2) - sizeof(s21::BTree<KT>) -
-          sizeof(s21::Node<KT>)) /
-         sizeof(s21::Node<KT>);
+template <typename KT, typename Balance, typename Compare>
+typename s21::Set<KT, Balance, Compare>::size_type
+s21::Set<KT, Balance, Compare>::max_size() {
+  using node_type = typename tree_type::node_type;
+  return ((std::numeric_limits<size_type>::max() / 2) - sizeof(tree_type) -
+          sizeof(node_type)) /
+         sizeof(node_type);
 }
 
-template <typename KT>
-typename s21::Set<KT>::reference s21::Set<KT>::operator=(
+template <typename KT, typename Balance, typename Compare>
+s21::Set<KT, Balance, Compare> &
+s21::Set<KT, Balance, Compare>::operator=(
     std::initializer_list<value_type> const &items) {
-  swap(Set<KT>(items));
+  Set<KT, Balance, Compare> other(items);
+  swap(other);
   return *this;
 }
 
 // Assignment operator overload for copy object
-template <typename KT>
-typename s21::Set<KT>::reference s21::Set<KT>::operator=(const Set &s) {
+template <typename KT, typename Balance, typename Compare>
+s21::Set<KT, Balance, Compare> &
+s21::Set<KT, Balance, Compare>::operator=(const Set &s) {
   if (this == &s) return *this;
-  for (auto it = s.tree_.begin(); it != s.tree_.end(); ++it) {
-    tree_.insert(it.getNode()->key, *it);
-    size_++;
-  }
+  tree_.assign(s.tree_);
+  size_ = s.size_;
   return *this;
 }
 
-template <typename KT>
-typename s21::Set<KT>::reference s21::Set<KT>::operator=(Set &&s) {
+template <typename KT, typename Balance, typename Compare>
+s21::Set<KT, Balance, Compare> &
+s21::Set<KT, Balance, Compare>::operator=(Set &&s) {
   if (this == &s) return *this;
   swap(s);
   return *this;
 }
 
 // Method to find iterator to specific node
-template <typename KT>
-typename s21::Set<KT>::iterator s21::Set<KT>::find(const KT &key) {
+template <typename KT, typename Balance, typename Compare>
+typename s21::Set<KT, Balance, Compare>::iterator
+s21::Set<KT, Balance, Compare>::find(const KT &key) {
+  return tree_.searchNode(key);
+}
+
+// Method to find iterator to specific node by a key of another type, which
+// Compare has to be transparent for
+template <typename KT, typename Balance, typename Compare>
+template <typename K, typename>
+typename s21::Set<KT, Balance, Compare>::iterator
+s21::Set<KT, Balance, Compare>::find(const K &key) {
   return tree_.searchNode(key);
 }
 
 // Returns iterator to begin
-template <typename KT>
-typename s21::Set<KT>::iterator s21::Set<KT>::begin() {
+template <typename KT, typename Balance, typename Compare>
+typename s21::Set<KT, Balance, Compare>::iterator
+s21::Set<KT, Balance, Compare>::begin() {
   return tree_.begin();
 }
 
 // Returns iterator after end node
-template <typename KT>
-typename s21::Set<KT>::iterator s21::Set<KT>::end() {
+template <typename KT, typename Balance, typename Compare>
+typename s21::Set<KT, Balance, Compare>::iterator
+s21::Set<KT, Balance, Compare>::end() {
   return tree_.end();
 }
 
+// Returns a reverse iterator to the last element
+template <typename KT, typename Balance, typename Compare>
+typename s21::Set<KT, Balance, Compare>::reverse_iterator
+s21::Set<KT, Balance, Compare>::rbegin() {
+  return reverse_iterator(end());
+}
+
+// Returns a reverse iterator before the first element
+template <typename KT, typename Balance, typename Compare>
+typename s21::Set<KT, Balance, Compare>::reverse_iterator
+s21::Set<KT, Balance, Compare>::rend() {
+  return reverse_iterator(begin());
+}
+
 // Method to check, is set empty
-template <typename KT>
-bool s21::Set<KT>::empty() {
+template <typename KT, typename Balance, typename Compare>
+bool s21::Set<KT, Balance, Compare>::empty() {
   return size_ == 0;
 }
 
 // Destroy the all Set
-template <typename KT>
-void s21::Set<KT>::clear() {
-  tree_.destroy(tree_.getRoot());
+template <typename KT, typename Balance, typename Compare>
+void s21::Set<KT, Balance, Compare>::clear() {
+  tree_.clear();
   size_ = 0;
 }
 
-// Insert a new unique value into set
-template <typename KT>
-std::pair<typename s21::Set<KT>::iterator, bool> s21::Set<KT>::insert(
-    const KT &value) {
-  if (tree_.search(value) != nullptr) {
-    return std::pair<iterator, bool>{nullptr, false};
+// Insert a new unique value into set, in one descent
+template <typename KT, typename Balance, typename Compare>
+std::pair<typename s21::Set<KT, Balance, Compare>::iterator, bool>
+s21::Set<KT, Balance, Compare>::insert(const KT &value) {
+  auto result = tree_.emplaceUnique(value);
+  if (result.second) {
+    size_++;
+  }
+  return result;
+}
+
+// Insert a temporary value, which is moved into the node if it is missing
+template <typename KT, typename Balance, typename Compare>
+std::pair<typename s21::Set<KT, Balance, Compare>::iterator, bool>
+s21::Set<KT, Balance, Compare>::insert(KT &&value) {
+  auto result = tree_.emplaceUnique(std::move(value));
+  if (result.second) {
+    size_++;
+  }
+  return result;
+}
+
+// Constructs a value from args and moves it into a node if it is missing
+template <typename KT, typename Balance, typename Compare>
+template <class... Args>
+std::pair<typename s21::Set<KT, Balance, Compare>::iterator, bool>
+s21::Set<KT, Balance, Compare>::emplace(Args &&...args) {
+  return insert(KT(std::forward<Args>(args)...));
+}
+
+// Like emplace, but tries to place the value right before or after hint first,
+// which makes inserting values in order amortized O(1) when the previous
+// result or end() is passed as hint
+template <typename KT, typename Balance, typename Compare>
+template <class... Args>
+typename s21::Set<KT, Balance, Compare>::iterator
+s21::Set<KT, Balance, Compare>::emplace_hint(iterator hint, Args &&...args) {
+  KT value(std::forward<Args>(args)...);
+  auto result = tree_.emplaceHint(hint, std::move(value));
+  if (result.second) {
+    size_++;
   }
-  auto it = tree_.insert(value, value);
-  size_++;
-  return std::pair<iterator, bool>{it, true};
+  return result.first;
+}
+
+// Insert the node owned by the handle if its value is missing, by relinking it
+template <typename KT, typename Balance, typename Compare>
+typename s21::Set<KT, Balance, Compare>::insert_return_type
+s21::Set<KT, Balance, Compare>::insert(node_type &&node) {
+  auto result = tree_.insertUnique(node);
+  if (result.second) {
+    size_++;
+  }
+  return {result.first, result.second, std::move(node)};
+}
+
+// Unlink the value at pos and hand its node over to the caller
+template <typename KT, typename Balance, typename Compare>
+typename s21::Set<KT, Balance, Compare>::node_type
+s21::Set<KT, Balance, Compare>::extract(iterator pos) {
+  node_type node = tree_.extract(pos);
+  if (node) {
+    size_--;
+  }
+  return node;
+}
+
+// Unlink the value equal to key if there is one
+template <typename KT, typename Balance, typename Compare>
+typename s21::Set<KT, Balance, Compare>::node_type
+s21::Set<KT, Balance, Compare>::extract(const KT &key) {
+  return extract(find(key));
 }
 
 // Delete one node by getting iterator
-template <typename KT>
-void s21::Set<KT>::erase(typename s21::Set<KT>::iterator pos) {
-  auto node = pos.getNode();
-  tree_.removeNode(node, node->key);
+template <typename KT, typename Balance, typename Compare>
+void s21::Set<KT, Balance, Compare>::erase(
+    typename s21::Set<KT, Balance, Compare>::iterator pos) {
+  tree_.erase(pos);
   size_--;
 }
 
 // Delete one node by getting value
-template <typename KT>
-void s21::Set<KT>::erase(const typename s21::Set<KT>::value_type &value) {
-  auto node = this->find(value).getNode();
-  tree_.removeNode(node, node->key);
+template <typename KT, typename Balance, typename Compare>
+void s21::Set<KT, Balance, Compare>::erase(
+    const typename s21::Set<KT, Balance, Compare>::value_type &value) {
+  tree_.erase(find(value));
   size_--;
 }
 
 // Swap two sets
-template <typename KT>
-void s21::Set<KT>::swap(Set &other) {
+template <typename KT, typename Balance, typename Compare>
+void s21::Set<KT, Balance, Compare>::swap(Set &other) {
   using std::swap;
   swap(size_, other.size_);
   swap(tree_, other.tree_);
 }
 
-// Merge two sets
-template <typename KT>
-void s21::Set<KT>::merge(Set &other) {
-  for (auto it = other.tree_.begin(); it != other.tree_.end(); ++it) {
-    insert(it.getNode()->key);
-  }
+// Merge two sets, values missing here are relinked from other and the rest
+// stays in other
+template <typename KT, typename Balance, typename Compare>
+void s21::Set<KT, Balance, Compare>::merge(Set &other) {
+  size_type moved = tree_.mergeUnique(other.tree_);
+  size_ += moved;
+  other.size_ -= moved;
 }
 
 // Check is key containing in set
-template <typename KT>
-bool s21::Set<KT>::contains(const KT &key) {
+template <typename KT, typename Balance, typename Compare>
+bool s21::Set<KT, Balance, Compare>::contains(const KT &key) {
+  return (tree_.search(key) != nullptr);
+}
+
+// contains for a key of another type under a transparent Compare
+template <typename KT, typename Balance, typename Compare>
+template <typename K, typename>
+bool s21::Set<KT, Balance, Compare>::contains(const K &key) {
   return (tree_.search(key) != nullptr);
 }
 
+// Returns the number of elements equivalent to key, 0 or 1
+template <typename KT, typename Balance, typename Compare>
+typename s21::Set<KT, Balance, Compare>::size_type
+s21::Set<KT, Balance, Compare>::count(const KT &key) {
+  return contains(key) ? 1 : 0;
+}
+
+// count for a key of another type under a transparent Compare
+template <typename KT, typename Balance, typename Compare>
+template <typename K, typename>
+typename s21::Set<KT, Balance, Compare>::size_type
+s21::Set<KT, Balance, Compare>::count(const K &key) {
+  return contains(key) ? 1 : 0;
+}
+
+// Returns an iterator to the first element not less than key, in O(log n)
+template <typename KT, typename Balance, typename Compare>
+typename s21::Set<KT, Balance, Compare>::iterator
+s21::Set<KT, Balance, Compare>::lower_bound(const KT &key) {
+  return tree_.lowerBound(key);
+}
+
+// lower_bound for a key of another type under a transparent Compare
+template <typename KT, typename Balance, typename Compare>
+template <typename K, typename>
+typename s21::Set<KT, Balance, Compare>::iterator
+s21::Set<KT, Balance, Compare>::lower_bound(const K &key) {
+  return tree_.lowerBound(key);
+}
+
+// Returns an iterator to the first element greater than key, in O(log n)
+template <typename KT, typename Balance, typename Compare>
+typename s21::Set<KT, Balance, Compare>::iterator
+s21::Set<KT, Balance, Compare>::upper_bound(const KT &key) {
+  return tree_.upperBound(key);
+}
+
+// upper_bound for a key of another type under a transparent Compare
+template <typename KT, typename Balance, typename Compare>
+template <typename K, typename>
+typename s21::Set<KT, Balance, Compare>::iterator
+s21::Set<KT, Balance, Compare>::upper_bound(const K &key) {
+  return tree_.upperBound(key);
+}
+
+// Returns the range of the element with key equivalent to key, empty when
+// there is none
+template <typename KT, typename Balance, typename Compare>
+std::pair<typename s21::Set<KT, Balance, Compare>::iterator,
+          typename s21::Set<KT, Balance, Compare>::iterator>
+s21::Set<KT, Balance, Compare>::equal_range(const KT &key) {
+  return tree_.equalRange(key);
+}
+
+// equal_range for a key of another type under a transparent Compare
+template <typename KT, typename Balance, typename Compare>
+template <typename K, typename>
+std::pair<typename s21::Set<KT, Balance, Compare>::iterator,
+          typename s21::Set<KT, Balance, Compare>::iterator>
+s21::Set<KT, Balance, Compare>::equal_range(const K &key) {
+  return tree_.equalRange(key);
+}
+
+// Returns the element with index elements before it in key order, or end().
+// O(log n) with an OrderStatistic balancing policy
+template <typename KT, typename Balance, typename Compare>
+typename s21::Set<KT, Balance, Compare>::iterator
+s21::Set<KT, Balance, Compare>::nth(size_type index) {
+  return tree_.nth(index);
+}
+
+// Returns the number of elements with a key less than key, which is the index
+// of key in key order when it is present. O(log n) with an OrderStatistic
+// balancing policy
+template <typename KT, typename Balance, typename Compare>
+typename s21::Set<KT, Balance, Compare>::size_type
+s21::Set<KT, Balance, Compare>::rank(const KT &key) {
+  return tree_.rank(key);
+}
+
 }  // namespace s21
 
 #endif  // CPP2_S21_CONTAINERS_SRC_SET_S21_SET_H_
@@ -0,0 +1,155 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "s21_concurrent_set.h"
+#include "s21_set.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+template <typename KT>
+void keyOnlyOne(const char *name, const std::vector<KT> &keys) {
+  using node = s21::Node<KT, KT>;
+  auto start = Clock::now();
+  s21::Set<KT> set;
+  for (const KT &key : keys) {
+    set.insert(key);
+  }
+  double insert = secondsSince(start);
+  std::size_t key_only =
+      sizeof(*std::declval<s21::Set<KT> &>().begin().getNode());
+  std::printf("  %-12s node %zu -> %zu bytes, %.1f -> %.1f MiB, insert %.3fs"
+              " size %zu\n",
+              name, sizeof(node), key_only,
+              keys.size() * sizeof(node) / 1048576.0,
+              keys.size() * key_only / 1048576.0, insert, set.size());
+}
+
+// Node memory of Set before and after dropping the value copy of the key
+void keyOnly(int count) {
+  std::mt19937_64 random(23);
+  std::vector<std::uint64_t> numbers(count);
+  std::vector<std::string> strings(count);
+  for (int i = 0; i < count; ++i) {
+    numbers[i] = random();
+    strings[i] = std::to_string(numbers[i] % 1000000000);
+  }
+  std::printf("key_only n=%d\n", count);
+  keyOnlyOne("uint64_t", numbers);
+  keyOnlyOne("std::string", strings);
+}
+
+// One Set behind one mutex, what ConcurrentSet replaces
+class LockedSet {
+ public:
+  bool contains(int key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return set_.contains(key);
+  }
+
+  // The key in place of an iterator, which would outlive the lock
+  std::pair<int, bool> insert(int key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return {key, set_.insert(key).second};
+  }
+
+  size_t erase(int key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = set_.find(key);
+    if (it == set_.end()) {
+      return 0;
+    }
+    set_.erase(it);
+    return 1;
+  }
+
+ private:
+  std::mutex mutex_;
+  s21::Set<int> set_;
+};
+
+// Millions of operations per second with half of them writes, a quarter
+// inserts and a quarter erases
+template <typename SetT>
+double writersRun(SetT &set, int threads, int ops, int keys) {
+  std::atomic<long long> hits(0);
+  std::vector<std::thread> workers;
+  auto start = Clock::now();
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&set, &hits, t, threads, ops, keys] {
+      std::mt19937 random(t + 1);
+      long long local = 0;
+      for (int i = 0; i < ops / threads; ++i) {
+        int key = static_cast<int>(random() % keys);
+        switch (i % 4) {
+          case 0:
+            local += set.insert(key).second;
+            break;
+          case 1:
+            local += set.erase(key);
+            break;
+          default:
+            local += set.contains(key);
+        }
+      }
+      hits += local;
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  double seconds = secondsSince(start);
+  return hits > 0 ? ops / seconds / 1e6 : 0;
+}
+
+// Mutex-wrapped Set against the lock-free skip list from 1 to 64 threads
+void skipList(int count) {
+  int keys = std::min(count, 1 << 20);
+  std::printf("skip_list ops=%d keys=%d, 50%% contains 25%% insert 25%% "
+              "erase, %u cores\n",
+              count, keys, std::thread::hardware_concurrency());
+  LockedSet locked;
+  s21::ConcurrentSet<int> lock_free;
+  for (int key = 0; key < keys; key += 2) {
+    locked.insert(key);
+    lock_free.insert(key);
+  }
+  for (int threads = 1; threads <= 64; threads *= 2) {
+    double global = writersRun(locked, threads, count, keys);
+    double skip = writersRun(lock_free, threads, count, keys);
+    std::printf("  threads %3d  locked Set %6.2f Mops/s", threads, global);
+    std::printf("  skip list %6.2f Mops/s\n", skip);
+  }
+}
+
+}  // namespace
+
+// Usage: s21_set_bench [name] [count]
+int main(int argc, char **argv) {
+  const char *name = argc > 1 ? argv[1] : "all";
+  int count = argc > 2 ? std::atoi(argv[2]) : 10000000;
+  bool all = std::strcmp(name, "all") == 0;
+  if (all || std::strcmp(name, "key_only") == 0) {
+    keyOnly(count);
+  }
+  if (all || std::strcmp(name, "skip_list") == 0) {
+    skipList(count);
+  }
+  return 0;
+}
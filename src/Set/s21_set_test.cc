@@ -2,12 +2,16 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
 #include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 template <class T>
 bool comparisonSet(s21::Set<T> &s21_set, s21::Set<T> &s21_set2);
-template <class T>
-bool comparisonSet(s21::Set<T> &s21_set, std::set<T> &std_set);
+template <class T, class Balance>
+bool comparisonSet(s21::Set<T, Balance> &s21_set, std::set<T> &std_set);
 
 // Constructors
 TEST(Set, base_constructor_int) {
@@ -240,6 +244,282 @@ TEST(Set, merge) {
   s21::Set<int> set1{1, 10, 11};
   set.merge(set1);
   ASSERT_TRUE(set.size() == 5);
+  ASSERT_EQ(set1.size(), 1U);
+  ASSERT_TRUE(set1.contains(11));
+}
+
+TEST(Set, node_handles) {
+  s21::Set<std::string> set{"apple", "banana", "cherry"};
+  s21::Set<std::string> other{"date"};
+  const std::string *address = &*set.find("banana");
+  auto node = set.extract("banana");
+  ASSERT_EQ(node.value(), "banana");
+  ASSERT_EQ(set.size(), 2U);
+  node.value() = "blueberry";
+  auto result = other.insert(std::move(node));
+  ASSERT_TRUE(result.inserted);
+  ASSERT_EQ(&*result.position, address);
+  ASSERT_EQ(other.size(), 2U);
+  result = other.insert(set.extract(set.find("apple")));
+  ASSERT_TRUE(result.inserted);
+  auto duplicate = other.extract("date");
+  duplicate.value() = "apple";
+  result = other.insert(std::move(duplicate));
+  ASSERT_FALSE(result.inserted);
+  ASSERT_EQ(result.node.value(), "apple");
+  ASSERT_EQ(other.size(), 2U);
+  s21::Set<int, s21::BPlusLayout<>> b_plus{1, 2, 3};
+  s21::Set<int, s21::BPlusLayout<>> b_plus_other{3, 4};
+  b_plus.merge(b_plus_other);
+  ASSERT_EQ(b_plus.size(), 4U);
+  ASSERT_EQ(b_plus_other.size(), 1U);
+  ASSERT_TRUE(b_plus_other.contains(3));
+}
+
+TEST(Set, balance_policies) {
+  s21::Set<int, s21::AvlBalance> avl;
+  s21::Set<int, s21::TreapBalance> treap;
+  s21::Set<int, s21::NoBalance> plain;
+  s21::Set<int, s21::BPlusLayout<>> b_plus;
+  s21::Set<int, s21::Threaded<s21::RedBlackBalance>> threaded;
+  std::set<int> stdset;
+  for (int i = 0; i < 500; ++i) {
+    int value = (i * 37) % 211;
+    threaded.insert(value);
+    avl.insert(value);
+    treap.insert(value);
+    plain.insert(value);
+    b_plus.insert(value);
+    stdset.insert(value);
+  }
+  for (int value = 0; value < 211; value += 3) {
+    threaded.erase(value);
+    avl.erase(value);
+    treap.erase(value);
+    plain.erase(value);
+    b_plus.erase(value);
+    stdset.erase(value);
+  }
+  ASSERT_EQ(avl.size(), stdset.size());
+  ASSERT_EQ(threaded.size(), stdset.size());
+  ASSERT_TRUE(comparisonSet(threaded, stdset));
+  ASSERT_EQ(treap.size(), stdset.size());
+  ASSERT_EQ(plain.size(), stdset.size());
+  ASSERT_EQ(b_plus.size(), stdset.size());
+  ASSERT_TRUE(comparisonSet(avl, stdset));
+  ASSERT_TRUE(comparisonSet(treap, stdset));
+  ASSERT_TRUE(comparisonSet(plain, stdset));
+  ASSERT_TRUE(comparisonSet(b_plus, stdset));
+}
+
+template <class Balance>
+void reverseMatchesStd() {
+  s21::Set<int, Balance> set;
+  std::set<int> stdset;
+  for (int i = 0; i < 500; ++i) {
+    set.insert((i * 37) % 211);
+    stdset.insert((i * 37) % 211);
+  }
+  auto std_it = stdset.rbegin();
+  for (auto it = set.rbegin(); it != set.rend(); ++it, ++std_it) {
+    ASSERT_EQ(*it, *std_it);
+  }
+  ASSERT_TRUE(std_it == stdset.rend());
+  auto it = set.end();
+  for (auto std_back = stdset.end(); std_back != stdset.begin();) {
+    ASSERT_EQ(*--it, *--std_back);
+  }
+  ASSERT_TRUE(it == set.begin());
+  ASSERT_EQ(*std::prev(set.end()), 210);
+}
+
+TEST(Set, reverse_iteration) {
+  reverseMatchesStd<s21::RedBlackBalance>();
+  reverseMatchesStd<s21::AvlBalance>();
+  reverseMatchesStd<s21::Threaded<s21::TreapBalance>>();
+  reverseMatchesStd<s21::BPlusLayout<>>();
+  reverseMatchesStd<s21::BPlusLayout<64>>();
+}
+
+// Value counting how often it is copied
+struct Tracked {
+  static int copies;
+  std::string text;
+
+  explicit Tracked(std::string text) : text(std::move(text)) {}
+  Tracked(const Tracked &other) : text(other.text) { ++copies; }
+  Tracked(Tracked &&) = default;
+  Tracked &operator=(const Tracked &other) {
+    text = other.text;
+    ++copies;
+    return *this;
+  }
+  Tracked &operator=(Tracked &&) = default;
+  bool operator<(const Tracked &other) const { return text < other.text; }
+};
+
+int Tracked::copies = 0;
+
+TEST(Set, insert_without_copies) {
+  Tracked::copies = 0;
+  s21::Set<Tracked> set;
+  ASSERT_TRUE(set.insert(Tracked("b")).second);
+  ASSERT_TRUE(set.emplace("a").second);
+  ASSERT_TRUE(set.emplace_hint(set.end(), "c") != set.end());
+  Tracked kept("a");
+  ASSERT_FALSE(set.insert(std::move(kept)).second);
+  ASSERT_EQ(kept.text, "a");
+  ASSERT_EQ(Tracked::copies, 0);
+  ASSERT_EQ(set.size(), 3U);
+  ASSERT_EQ((*set.begin()).text, "a");
+}
+
+TEST(Set, emplace) {
+  s21::Set<std::string> set;
+  ASSERT_TRUE(set.emplace(3, 'a').second);
+  ASSERT_FALSE(set.emplace("aaa").second);
+  auto hint = set.end();
+  for (char c = 'b'; c <= 'z'; ++c) {
+    hint = set.emplace_hint(set.end(), 3, c);
+  }
+  ASSERT_EQ(*hint, "zzz");
+  ASSERT_EQ(set.emplace_hint(set.begin(), "bbb"), set.find("bbb"));
+  ASSERT_EQ(set.size(), 26U);
+  std::string expected = "aaa";
+  for (auto it = set.begin(); it != set.end(); ++it, ++expected[0]) {
+    expected[1] = expected[2] = expected[0];
+    ASSERT_EQ(*it, expected);
+  }
+}
+
+TEST(Set, sorted_unique_constructor) {
+  std::set<int> stdset;
+  for (int i = 0; i < 1000; ++i) {
+    stdset.insert(i * 2);
+  }
+  s21::Set<int> set(s21::sorted_unique, stdset.begin(), stdset.end());
+  s21::Set<int, s21::BPlusLayout<64>> b_plus(s21::sorted_unique,
+                                             stdset.begin(), stdset.end());
+  ASSERT_EQ(set.size(), stdset.size());
+  ASSERT_EQ(b_plus.size(), stdset.size());
+  ASSERT_TRUE(comparisonSet(set, stdset));
+  ASSERT_TRUE(comparisonSet(b_plus, stdset));
+  s21::Set<int> copySet{5, 7};
+  copySet = set;
+  ASSERT_TRUE(comparisonSet(copySet, set));
+  for (int value = 0; value < 2000; value += 3) {
+    set.erase(set.find(value - value % 2));
+    b_plus.erase(b_plus.find(value - value % 2));
+    stdset.erase(value - value % 2);
+  }
+  ASSERT_TRUE(comparisonSet(set, stdset));
+  ASSERT_TRUE(comparisonSet(b_plus, stdset));
+}
+
+TEST(Set, greater_compare) {
+  s21::Set<int, s21::AvlBalance, std::greater<int>> set{5, 1, 4, 1, 3};
+  s21::Set<int, s21::BPlusLayout<64>, std::greater<int>> b_plus;
+  for (int i = 0; i < 1000; ++i) {
+    b_plus.insert(i * 7 % 1000);
+  }
+  ASSERT_EQ(set.size(), 4U);
+  int expected[] = {5, 4, 3, 1};
+  int index = 0;
+  for (auto it = set.begin(); it != set.end(); ++it) {
+    ASSERT_EQ(*it, expected[index++]);
+  }
+  int previous = 1000;
+  for (auto it = b_plus.begin(); it != b_plus.end(); ++it) {
+    ASSERT_EQ(*it, previous - 1);
+    previous = *it;
+  }
+  ASSERT_EQ(previous, 0);
+}
+
+// Ordering whose direction is chosen at run time
+struct Direction {
+  bool descending;
+  bool operator()(int left, int right) const {
+    return descending ? right < left : left < right;
+  }
+};
+
+TEST(Set, stored_compare) {
+  s21::Set<int, s21::RedBlackBalance, Direction> set({5, 1, 4, 1, 3},
+                                                     Direction{true});
+  s21::Set<int, s21::BPlusLayout<64>, Direction> b_plus(Direction{true});
+  for (int i = 0; i < 1000; ++i) {
+    b_plus.insert(i * 7 % 1000);
+  }
+  ASSERT_EQ(std::vector<int>(set.begin(), set.end()),
+            (std::vector<int>{5, 4, 3, 1}));
+  s21::Set<int, s21::RedBlackBalance, Direction> copy(set);
+  ASSERT_EQ(*copy.insert(2).first, 2);
+  ASSERT_EQ(*std::prev(copy.end()), 1);
+  ASSERT_EQ(*b_plus.begin(), 999);
+  ASSERT_EQ(*b_plus.lower_bound(500), 500);
+  ASSERT_EQ(*b_plus.upper_bound(500), 499);
+}
+
+TEST(Set, transparent_lookup) {
+  s21::Set<std::string, s21::RedBlackBalance, std::less<>> set{"get", "post",
+                                                              "put"};
+  ASSERT_NE(set.find(std::string_view("post")), set.end());
+  ASSERT_TRUE(set.contains("put"));
+  ASSERT_FALSE(set.contains("patch"));
+  ASSERT_EQ(set.count("get"), 1U);
+  ASSERT_EQ(set.count(std::string("delete")), 0U);
+}
+
+TEST(Set, order_statistic) {
+  s21::Set<int, s21::OrderStatistic<s21::AvlBalance>> set;
+  for (int i = 100; i > 0; --i) {
+    set.insert(i * 10);
+  }
+  set.erase(500);
+  ASSERT_EQ(*set.nth(0), 10);
+  ASSERT_EQ(*set.nth(49), 510);
+  ASSERT_EQ(set.nth(99), set.end());
+  ASSERT_EQ(set.rank(500), 49U);
+  ASSERT_EQ(set.rank(510), 49U);
+  ASSERT_EQ(set.rank(1001), 99U);
+}
+
+TEST(Set, lower_upper_bound) {
+  s21::Set<int> set{10, 20, 30, 40};
+  s21::Set<int, s21::BPlusLayout<64>> b_plus{10, 20, 30, 40};
+  ASSERT_EQ(*set.lower_bound(20), 20);
+  ASSERT_EQ(*set.upper_bound(20), 30);
+  ASSERT_EQ(*b_plus.lower_bound(21), 30);
+  ASSERT_EQ(b_plus.upper_bound(40), b_plus.end());
+  auto range = set.equal_range(30);
+  ASSERT_EQ(*range.first, 30);
+  ASSERT_EQ(*range.second, 40);
+  range = set.equal_range(35);
+  ASSERT_EQ(range.first, range.second);
+}
+
+TEST(Set, key_only_nodes) {
+  using Wide = s21::Set<std::uint64_t>;
+  using Strings = s21::Set<std::string>;
+  using WideNode = std::remove_pointer_t<decltype(Wide().begin().getNode())>;
+  using StringNode =
+      std::remove_pointer_t<decltype(Strings().begin().getNode())>;
+  ASSERT_EQ(sizeof(WideNode) + sizeof(std::uint64_t),
+            sizeof(s21::Node<std::uint64_t, std::uint64_t>));
+  ASSERT_EQ(sizeof(StringNode) + sizeof(std::string),
+            sizeof(s21::Node<std::string, std::string>));
+  std::vector<std::string> strings{"a", "b", "c"};
+  s21::Set<std::string, s21::BPlusLayout<128>> b_plus(s21::sorted_unique,
+                                                      strings.begin(),
+                                                      strings.end());
+  b_plus.insert("d");
+  std::string joined;
+  for (auto it = b_plus.begin(); it != b_plus.end(); ++it) {
+    joined += *it;
+  }
+  ASSERT_EQ(joined, "abcd");
+  ASSERT_TRUE(b_plus.contains("c"));
 }
 
 int main(int argc, char **argv) {
@@ -247,8 +527,8 @@ int main(int argc, char **argv) {
   return RUN_ALL_TESTS();
 }
 
-template <class T>
-bool comparisonSet(s21::Set<T> &s21_set, std::set<T> &stl_set) {
+template <class T, class Balance>
+bool comparisonSet(s21::Set<T, Balance> &s21_set, std::set<T> &stl_set) {
   if (s21_set.empty() == true || stl_set.empty() == true) {
     return true;
   }
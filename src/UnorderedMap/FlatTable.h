@@ -0,0 +1,544 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_UNORDEREDMAP_FLATTABLE_H_
+#define CPP2_S21_CONTAINERS_SRC_UNORDEREDMAP_FLATTABLE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "../Map/Node.h"
+
+namespace s21 {
+
+// Control bytes of kWidth consecutive slots, compared in one instruction
+// where the target has vector registers: 32 slots with AVX2, 16 with SSE2,
+// 8 in a plain loop elsewhere. A full slot holds seven bits of its key's
+// hash, an empty one kEmpty, the only value with the sign bit set. Masks
+// have bit i set for slot i of the group
+class ControlGroup {
+ public:
+  using mask_type = std::uint32_t;
+
+  static constexpr std::int8_t kEmpty = -128;
+
+#if defined(__AVX2__)
+  static constexpr std::size_t kWidth = 32;
+
+  explicit ControlGroup(const std::int8_t* bytes)
+      : bytes_(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes))) {}
+
+  mask_type match(std::int8_t fingerprint) const {
+    return static_cast<mask_type>(_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(bytes_, _mm256_set1_epi8(fingerprint))));
+  }
+
+  mask_type empty() const {
+    return static_cast<mask_type>(_mm256_movemask_epi8(bytes_));
+  }
+
+ private:
+  __m256i bytes_;
+#elif defined(__SSE2__)
+  static constexpr std::size_t kWidth = 16;
+
+  explicit ControlGroup(const std::int8_t* bytes)
+      : bytes_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes))) {}
+
+  mask_type match(std::int8_t fingerprint) const {
+    return static_cast<mask_type>(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(bytes_, _mm_set1_epi8(fingerprint))));
+  }
+
+  mask_type empty() const {
+    return static_cast<mask_type>(_mm_movemask_epi8(bytes_));
+  }
+
+ private:
+  __m128i bytes_;
+#else
+  static constexpr std::size_t kWidth = 8;
+
+  explicit ControlGroup(const std::int8_t* bytes) {
+    std::memcpy(bytes_, bytes, kWidth);
+  }
+
+  mask_type match(std::int8_t fingerprint) const {
+    mask_type mask = 0;
+    for (std::size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<mask_type>(bytes_[i] == fingerprint) << i;
+    }
+    return mask;
+  }
+
+  mask_type empty() const {
+    mask_type mask = 0;
+    for (std::size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<mask_type>(bytes_[i] < 0) << i;
+    }
+    return mask;
+  }
+
+ private:
+  std::int8_t bytes_[kWidth];
+#endif
+
+ public:
+  mask_type full() const { return ~empty() & kAll; }
+
+  // Index of the lowest set bit, mask must not be zero
+  static std::size_t lowest(mask_type mask) {
+    return static_cast<std::size_t>(__builtin_ctz(mask));
+  }
+
+ private:
+  static constexpr mask_type kAll =
+      static_cast<mask_type>(~std::uint64_t{0} >> (64 - kWidth));
+};
+
+// Open addressing hash table behind UnorderedMap and UnorderedSet. Entries
+// live in one flat array next to an array of one control byte per slot. A
+// key goes to the first empty slot at or after its home slot, so a lookup
+// scans control bytes from the home slot a group at a time, compares keys
+// only where the hash bits match, and stops at the first group with an
+// empty slot. The first kWidth - 1 control bytes are mirrored past the end,
+// so a group can start at any slot without wrapping around. Erasing shifts
+// the rest of the run back into the gap instead of leaving a tombstone, so
+// churn never lengthens lookups and never forces a cleanup rehash. Entries
+// move on insert and erase, which invalidates iterators
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+class FlatTable {
+ public:
+  class iterator;
+
+  using entry_type = NodeEntry<KT, VT>;
+  using size_type = std::size_t;
+  // What iterators hand out as the value, the key itself in a key-only table
+  using mapped_type =
+      std::conditional_t<std::is_same_v<VT, KeyOnly>, const KT, VT>;
+
+  FlatTable() noexcept;
+  FlatTable(const FlatTable&);
+  FlatTable(FlatTable&&) noexcept;
+  ~FlatTable();
+  FlatTable& operator=(const FlatTable&);
+  FlatTable& operator=(FlatTable&&) noexcept;
+
+  iterator find(const KT&) const;
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplaceUnique(K&&, Args&&...);
+  void erase(iterator);
+  size_type erase(const KT&);
+  void reserve(size_type);
+  void clear() noexcept;
+  void swap(FlatTable&) noexcept;
+  iterator begin() const;
+  iterator end() const;
+  size_type size() const noexcept;
+  size_type capacity() const noexcept;
+
+  // Most entries a table can address, one control byte and one slot each
+  static size_type maxSize() {
+    return static_cast<size_type>(std::numeric_limits<std::ptrdiff_t>::max()) /
+           (sizeof(entry_type) + 1);
+  }
+
+ private:
+  static constexpr size_type kWidth = ControlGroup::kWidth;
+
+  // Entries a table of capacity slots holds before it grows, seven eighths
+  static size_type maxLoad(size_type capacity) {
+    return capacity - capacity / 8;
+  }
+
+  std::uint64_t hashOf(const KT&) const;
+  static std::int8_t fingerprint(std::uint64_t hash) {
+    return static_cast<std::int8_t>(hash & 0x7F);
+  }
+  size_type home(std::uint64_t hash) const {
+    return static_cast<size_type>(hash >> 7) & (capacity_ - 1);
+  }
+  bool isFull(size_type index) const { return ctrl_[index] >= 0; }
+  void setControl(size_type, std::int8_t);
+  size_type findIndex(const KT&, std::uint64_t) const;
+  size_type emptyIndex(std::uint64_t) const;
+  template <typename... Args>
+  size_type place(std::uint64_t, Args&&...);
+  size_type nextFull(size_type) const;
+  void eraseAt(size_type);
+  void allocate(size_type);
+  void release() noexcept;
+  void rehash(size_type);
+
+  std::int8_t* ctrl_;
+  entry_type* slots_;
+  size_type capacity_;  // zero or a power of two, at least kWidth
+  size_type size_;
+  Hash hash_;
+  KeyEqual equal_;
+};
+
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+class FlatTable<KT, VT, Hash, KeyEqual>::iterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = std::remove_const_t<mapped_type>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = mapped_type*;
+  using reference = mapped_type&;
+
+  iterator() : table_(nullptr), index_(0) {}
+  iterator(const FlatTable* table, size_type index)
+      : table_(table), index_(index) {}
+
+  iterator& operator++() {
+    index_ = table_->nextFull(index_ + 1);
+    return *this;
+  }
+
+  iterator operator++(int) {
+    iterator old = *this;
+    ++*this;
+    return old;
+  }
+
+  mapped_type& operator*() const { return table_->slots_[index_].mapped(); }
+
+  bool operator==(const iterator& other) const {
+    return index_ == other.index_ && table_ == other.table_;
+  }
+
+  bool operator!=(const iterator& other) const { return !(*this == other); }
+
+  const KT& first() const { return table_->slots_[index_].key; }
+  mapped_type& second() const { return table_->slots_[index_].mapped(); }
+
+ private:
+  friend class FlatTable;
+
+  const FlatTable* table_;
+  size_type index_;
+};
+
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+FlatTable<KT, VT, Hash, KeyEqual>::FlatTable() noexcept
+    : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0) {}
+
+// Copies entries into the same slots, so nothing is rehashed
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+FlatTable<KT, VT, Hash, KeyEqual>::FlatTable(const FlatTable& other)
+    : FlatTable() {
+  hash_ = other.hash_;
+  equal_ = other.equal_;
+  if (other.size_ == 0) {
+    return;
+  }
+  allocate(other.capacity_);
+  for (size_type i = 0; i < capacity_; ++i) {
+    if (other.isFull(i)) {
+      new (slots_ + i) entry_type(other.slots_[i]);
+      setControl(i, other.ctrl_[i]);
+      ++size_;
+    }
+  }
+}
+
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+FlatTable<KT, VT, Hash, KeyEqual>::FlatTable(FlatTable&& other) noexcept
+    : FlatTable() {
+  swap(other);
+}
+
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+FlatTable<KT, VT, Hash, KeyEqual>::~FlatTable() {
+  release();
+}
+
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+FlatTable<KT, VT, Hash, KeyEqual>& FlatTable<KT, VT, Hash, KeyEqual>::operator=(
+    const FlatTable& other) {
+  if (this != &other) {
+    FlatTable copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+FlatTable<KT, VT, Hash, KeyEqual>& FlatTable<KT, VT, Hash, KeyEqual>::operator=(
+    FlatTable&& other) noexcept {
+  swap(other);
+  return *this;
+}
+
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+typename FlatTable<KT, VT, Hash, KeyEqual>::iterator
+FlatTable<KT, VT, Hash, KeyEqual>::find(const KT& key) const {
+  if (size_ == 0) {
+    return end();
+  }
+  return iterator(this, findIndex(key, hashOf(key)));
+}
+
+// Inserts an entry built from key and args unless the key is present. The
+// table grows before the new entry would push it past its maximum load. The
+// arguments may refer to entries of this table, so when it grows the entry
+// is built first and moved in after the rehash
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+template <typename K, typename... Args>
+std::pair<typename FlatTable<KT, VT, Hash, KeyEqual>::iterator, bool>
+FlatTable<KT, VT, Hash, KeyEqual>::emplaceUnique(K&& key, Args&&... args) {
+  std::uint64_t hash = hashOf(key);
+  if (size_ != 0) {
+    size_type index = findIndex(key, hash);
+    if (index != capacity_) {
+      return {iterator(this, index), false};
+    }
+  }
+  if (size_ < maxLoad(capacity_)) {
+    size_type index = place(hash, std::piecewise_construct,
+                            std::forward<K>(key), std::forward<Args>(args)...);
+    return {iterator(this, index), true};
+  }
+  entry_type entry(std::piecewise_construct, std::forward<K>(key),
+                   std::forward<Args>(args)...);
+  rehash(capacity_ ? capacity_ * 2 : kWidth);
+  return {iterator(this, place(hash, std::move(entry))), true};
+}
+
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+void FlatTable<KT, VT, Hash, KeyEqual>::erase(iterator pos) {
+  eraseAt(pos.index_);
+}
+
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+typename FlatTable<KT, VT, Hash, KeyEqual>::size_type
+FlatTable<KT, VT, Hash, KeyEqual>::erase(const KT& key) {
+  if (size_ == 0) {
+    return 0;
+  }
+  size_type index = findIndex(key, hashOf(key));
+  if (index == capacity_) {
+    return 0;
+  }
+  eraseAt(index);
+  return 1;
+}
+
+// Makes room for count entries without growing again, throws
+// std::length_error if count is more than a table can address
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+void FlatTable<KT, VT, Hash, KeyEqual>::reserve(size_type count) {
+  if (count > maxSize()) {
+    throw std::length_error("s21::FlatTable::reserve");
+  }
+  size_type capacity = std::max(capacity_, kWidth);
+  while (maxLoad(capacity) < count) {
+    capacity *= 2;
+  }
+  if (capacity != capacity_) {
+    rehash(capacity);
+  }
+}
+
+// Destroys the entries and keeps the slots for reuse
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+void FlatTable<KT, VT, Hash, KeyEqual>::clear() noexcept {
+  for (size_type i = 0; size_ != 0 && i < capacity_; ++i) {
+    if (isFull(i)) {
+      slots_[i].~entry_type();
+      --size_;
+    }
+  }
+  if (ctrl_) {
+    std::memset(ctrl_, ControlGroup::kEmpty, capacity_ + kWidth - 1);
+  }
+}
+
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+void FlatTable<KT, VT, Hash, KeyEqual>::swap(FlatTable& other) noexcept {
+  using std::swap;
+  swap(ctrl_, other.ctrl_);
+  swap(slots_, other.slots_);
+  swap(capacity_, other.capacity_);
+  swap(size_, other.size_);
+  swap(hash_, other.hash_);
+  swap(equal_, other.equal_);
+}
+
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+typename FlatTable<KT, VT, Hash, KeyEqual>::iterator
+FlatTable<KT, VT, Hash, KeyEqual>::begin() const {
+  return iterator(this, nextFull(0));
+}
+
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+typename FlatTable<KT, VT, Hash, KeyEqual>::iterator
+FlatTable<KT, VT, Hash, KeyEqual>::end() const {
+  return iterator(this, capacity_);
+}
+
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+typename FlatTable<KT, VT, Hash, KeyEqual>::size_type
+FlatTable<KT, VT, Hash, KeyEqual>::size() const noexcept {
+  return size_;
+}
+
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+typename FlatTable<KT, VT, Hash, KeyEqual>::size_type
+FlatTable<KT, VT, Hash, KeyEqual>::capacity() const noexcept {
+  return capacity_;
+}
+
+// Spreads the bits of Hash, which is the identity for integers in common
+// standard libraries, over the whole word: the home slot comes from the high
+// bits and the control byte from the low ones
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+std::uint64_t FlatTable<KT, VT, Hash, KeyEqual>::hashOf(const KT& key) const {
+  std::uint64_t hash =
+      static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ULL;
+  return hash ^ (hash >> 32);
+}
+
+// Writes the control byte of a slot and its mirror past the end
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+void FlatTable<KT, VT, Hash, KeyEqual>::setControl(size_type index,
+                                                    std::int8_t control) {
+  ctrl_[index] = control;
+  if (index < kWidth - 1) {
+    ctrl_[capacity_ + index] = control;
+  }
+}
+
+// Slot holding key, or capacity_ if it is missing
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+typename FlatTable<KT, VT, Hash, KeyEqual>::size_type
+FlatTable<KT, VT, Hash, KeyEqual>::findIndex(const KT& key,
+                                             std::uint64_t hash) const {
+  size_type mask = capacity_ - 1;
+  std::int8_t control = fingerprint(hash);
+  for (size_type pos = home(hash);; pos = (pos + kWidth) & mask) {
+    ControlGroup group(ctrl_ + pos);
+    for (auto match = group.match(control); match; match &= match - 1) {
+      size_type index = (pos + ControlGroup::lowest(match)) & mask;
+      if (equal_(slots_[index].key, key)) {
+        return index;
+      }
+    }
+    if (group.empty()) {
+      return capacity_;
+    }
+  }
+}
+
+// First empty slot at or after the home slot of hash
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+typename FlatTable<KT, VT, Hash, KeyEqual>::size_type
+FlatTable<KT, VT, Hash, KeyEqual>::emptyIndex(std::uint64_t hash) const {
+  size_type mask = capacity_ - 1;
+  for (size_type pos = home(hash);; pos = (pos + kWidth) & mask) {
+    auto empty = ControlGroup(ctrl_ + pos).empty();
+    if (empty) {
+      return (pos + ControlGroup::lowest(empty)) & mask;
+    }
+  }
+}
+
+// First full slot at or after index, or capacity_. Mirrored bytes past the
+// end stand for slots already passed, so matches there are cut off
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+typename FlatTable<KT, VT, Hash, KeyEqual>::size_type
+FlatTable<KT, VT, Hash, KeyEqual>::nextFull(size_type index) const {
+  for (; index < capacity_; index += kWidth) {
+    auto full = ControlGroup(ctrl_ + index).full();
+    if (full) {
+      return std::min(index + ControlGroup::lowest(full), capacity_);
+    }
+  }
+  return capacity_;
+}
+
+// Backward shift deletion. Walks the run after the freed slot and moves each
+// entry whose home slot is not past the gap into it, which leaves every
+// remaining entry reachable from its home slot without gaps in between
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+void FlatTable<KT, VT, Hash, KeyEqual>::eraseAt(size_type gap) {
+  size_type mask = capacity_ - 1;
+  slots_[gap].~entry_type();
+  setControl(gap, ControlGroup::kEmpty);
+  --size_;
+  for (size_type next = (gap + 1) & mask; isFull(next);
+       next = (next + 1) & mask) {
+    size_type wanted = home(hashOf(slots_[next].key));
+    if (((next - wanted) & mask) >= ((next - gap) & mask)) {
+      new (slots_ + gap) entry_type(std::move(slots_[next]));
+      slots_[next].~entry_type();
+      setControl(gap, ctrl_[next]);
+      setControl(next, ControlGroup::kEmpty);
+      gap = next;
+    }
+  }
+}
+
+// Sets up empty arrays of capacity slots, the table has to hold none
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+void FlatTable<KT, VT, Hash, KeyEqual>::allocate(size_type capacity) {
+  ctrl_ = new std::int8_t[capacity + kWidth - 1];
+  std::memset(ctrl_, ControlGroup::kEmpty, capacity + kWidth - 1);
+  slots_ = std::allocator<entry_type>().allocate(capacity);
+  capacity_ = capacity;
+}
+
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+void FlatTable<KT, VT, Hash, KeyEqual>::release() noexcept {
+  clear();
+  if (ctrl_) {
+    delete[] ctrl_;
+    std::allocator<entry_type>().deallocate(slots_, capacity_);
+  }
+  ctrl_ = nullptr;
+  slots_ = nullptr;
+  capacity_ = 0;
+}
+
+// Builds an entry from args in the first empty slot for hash, which the
+// table has room for, and returns the slot
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+template <typename... Args>
+typename FlatTable<KT, VT, Hash, KeyEqual>::size_type
+FlatTable<KT, VT, Hash, KeyEqual>::place(std::uint64_t hash, Args&&... args) {
+  size_type index = emptyIndex(hash);
+  new (slots_ + index) entry_type(std::forward<Args>(args)...);
+  setControl(index, fingerprint(hash));
+  ++size_;
+  return index;
+}
+
+// Moves every entry into fresh arrays of capacity slots
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+void FlatTable<KT, VT, Hash, KeyEqual>::rehash(size_type capacity) {
+  FlatTable old;
+  swap(old);
+  hash_ = old.hash_;
+  equal_ = old.equal_;
+  allocate(capacity);
+  for (size_type i = 0; i < old.capacity_; ++i) {
+    if (old.isFull(i)) {
+      place(hashOf(old.slots_[i].key), std::move(old.slots_[i]));
+    }
+  }
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_UNORDEREDMAP_FLATTABLE_H_
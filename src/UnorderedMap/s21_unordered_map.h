@@ -0,0 +1,298 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_UNORDEREDMAP_S21_UNORDERED_MAP_H_
+#define CPP2_S21_CONTAINERS_SRC_UNORDEREDMAP_S21_UNORDERED_MAP_H_
+
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "FlatTable.h"
+
+namespace s21 {
+
+// Hash map with the lookup surface of Map and no key order. Entries are
+// stored inline in one open addressing table, see FlatTable, so a lookup
+// usually costs one hash, one group compare and one key compare instead of
+// a chain of node visits. Inserting and erasing move entries around and
+// invalidate iterators
+template <typename KT, typename VT, typename Hash = std::hash<KT>,
+          typename KeyEqual = std::equal_to<KT>>
+class UnorderedMap {
+  using key_type = KT;
+  using mapped_type = VT;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using table_type = FlatTable<KT, VT, Hash, KeyEqual>;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+
+ public:
+  using iterator = typename table_type::iterator;
+  using const_iterator = iterator;
+
+  UnorderedMap();
+  explicit UnorderedMap(std::initializer_list<value_type> const &items);
+  UnorderedMap(const UnorderedMap &other);
+  UnorderedMap(UnorderedMap &&other) noexcept;
+  UnorderedMap &operator=(const UnorderedMap &other);
+  UnorderedMap &operator=(UnorderedMap &&other) noexcept;
+
+  VT &at(const KT &key);
+  VT &operator[](const KT &key);
+  VT &operator[](KT &&key);
+  iterator find(const KT &key);
+  bool contains(const KT &key);
+  size_type count(const KT &key);
+
+  iterator begin();
+  iterator end();
+
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+  size_type bucket_count() const noexcept;
+  float load_factor() const noexcept;
+  void reserve(size_type count);
+
+  void clear();
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  std::pair<iterator, bool> insert(const KT &key, const VT &value);
+  std::pair<iterator, bool> insert_or_assign(const KT &key, const VT &value);
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const KT &key, Args &&...args);
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(KT &&key, Args &&...args);
+  void erase(iterator pos);
+  size_type erase(const KT &key);
+  void swap(UnorderedMap &other) noexcept;
+
+ private:
+  table_type table_;
+};
+
+// Default constructor, creates an empty map without allocating
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+UnorderedMap<KT, VT, Hash, KeyEqual>::UnorderedMap() : table_() {}
+
+// Initializer list constructor, sized for the list up front. Later duplicates
+// of a key are ignored
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+UnorderedMap<KT, VT, Hash, KeyEqual>::UnorderedMap(
+    std::initializer_list<value_type> const &items)
+    : table_() {
+  reserve(items.size());
+  for (const auto &item : items) {
+    insert(item);
+  }
+}
+
+// Copy constructor
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+UnorderedMap<KT, VT, Hash, KeyEqual>::UnorderedMap(const UnorderedMap &other)
+    : table_(other.table_) {}
+
+// Move constructor
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+UnorderedMap<KT, VT, Hash, KeyEqual>::UnorderedMap(
+    UnorderedMap &&other) noexcept
+    : table_(std::move(other.table_)) {}
+
+// Assignment operator overload for copy object
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+UnorderedMap<KT, VT, Hash, KeyEqual> &
+UnorderedMap<KT, VT, Hash, KeyEqual>::operator=(const UnorderedMap &other) {
+  table_ = other.table_;
+  return *this;
+}
+
+// Assignment operator overload for moving object
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+UnorderedMap<KT, VT, Hash, KeyEqual> &
+UnorderedMap<KT, VT, Hash, KeyEqual>::operator=(
+    UnorderedMap &&other) noexcept {
+  if (this != &other) {
+    table_.swap(other.table_);
+  }
+  return *this;
+}
+
+// Access specified element with bounds checking
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+VT &UnorderedMap<KT, VT, Hash, KeyEqual>::at(const KT &key) {
+  auto it = table_.find(key);
+  if (it == table_.end()) {
+    throw std::out_of_range("s21::UnorderedMap::at");
+  }
+  return *it;
+}
+
+// Access or insert specified element, in one probe
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+VT &UnorderedMap<KT, VT, Hash, KeyEqual>::operator[](const KT &key) {
+  return table_.emplaceUnique(key).first.second();
+}
+
+// Like operator[] for a temporary key, which is moved into the new element
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+VT &UnorderedMap<KT, VT, Hash, KeyEqual>::operator[](KT &&key) {
+  return table_.emplaceUnique(std::move(key)).first.second();
+}
+
+// Find element by key
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+typename UnorderedMap<KT, VT, Hash, KeyEqual>::iterator
+UnorderedMap<KT, VT, Hash, KeyEqual>::find(const KT &key) {
+  return table_.find(key);
+}
+
+// Checks if there is an element with key equivalent to key in the container
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+bool UnorderedMap<KT, VT, Hash, KeyEqual>::contains(const KT &key) {
+  return table_.find(key) != table_.end();
+}
+
+// Returns the number of elements with the key, zero or one
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+typename UnorderedMap<KT, VT, Hash, KeyEqual>::size_type
+UnorderedMap<KT, VT, Hash, KeyEqual>::count(const KT &key) {
+  return contains(key) ? 1 : 0;
+}
+
+// Returns an iterator to the first element in slot order
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+typename UnorderedMap<KT, VT, Hash, KeyEqual>::iterator
+UnorderedMap<KT, VT, Hash, KeyEqual>::begin() {
+  return table_.begin();
+}
+
+// Returns an iterator to the end
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+typename UnorderedMap<KT, VT, Hash, KeyEqual>::iterator
+UnorderedMap<KT, VT, Hash, KeyEqual>::end() {
+  return table_.end();
+}
+
+// Checks whether the container is empty
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+bool UnorderedMap<KT, VT, Hash, KeyEqual>::empty() const noexcept {
+  return table_.size() == 0;
+}
+
+// Returns the number of elements
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+typename UnorderedMap<KT, VT, Hash, KeyEqual>::size_type
+UnorderedMap<KT, VT, Hash, KeyEqual>::size() const noexcept {
+  return table_.size();
+}
+
+// Returns the maximum possible number of elements
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+typename UnorderedMap<KT, VT, Hash, KeyEqual>::size_type
+UnorderedMap<KT, VT, Hash, KeyEqual>::max_size() const noexcept {
+  return table_type::maxSize();
+}
+
+// Returns the number of slots in the table
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+typename UnorderedMap<KT, VT, Hash, KeyEqual>::size_type
+UnorderedMap<KT, VT, Hash, KeyEqual>::bucket_count() const noexcept {
+  return table_.capacity();
+}
+
+// Returns the share of slots in use
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+float UnorderedMap<KT, VT, Hash, KeyEqual>::load_factor() const noexcept {
+  return table_.capacity() ? static_cast<float>(table_.size()) /
+                                 static_cast<float>(table_.capacity())
+                           : 0.0f;
+}
+
+// Makes room for count elements, so inserting up to that many never rehashes
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+void UnorderedMap<KT, VT, Hash, KeyEqual>::reserve(size_type count) {
+  table_.reserve(count);
+}
+
+// Clears the contents, the table keeps its slots
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+void UnorderedMap<KT, VT, Hash, KeyEqual>::clear() {
+  table_.clear();
+}
+
+// Inserts value and returns iterator to where the element is in the
+// container and bool denoting whether the insertion took place
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+std::pair<typename UnorderedMap<KT, VT, Hash, KeyEqual>::iterator, bool>
+UnorderedMap<KT, VT, Hash, KeyEqual>::insert(const value_type &value) {
+  return table_.emplaceUnique(value.first, value.second);
+}
+
+// Inserts a temporary element, moving its value into the table. The key of a
+// value_type is const and still gets copied
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+std::pair<typename UnorderedMap<KT, VT, Hash, KeyEqual>::iterator, bool>
+UnorderedMap<KT, VT, Hash, KeyEqual>::insert(value_type &&value) {
+  return table_.emplaceUnique(value.first, std::move(value.second));
+}
+
+// Inserts value by key unless the key is present
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+std::pair<typename UnorderedMap<KT, VT, Hash, KeyEqual>::iterator, bool>
+UnorderedMap<KT, VT, Hash, KeyEqual>::insert(const KT &key, const VT &value) {
+  return table_.emplaceUnique(key, value);
+}
+
+// Inserts an element or assigns to the current one if the key already
+// exists. The bool tells whether the key was new
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+std::pair<typename UnorderedMap<KT, VT, Hash, KeyEqual>::iterator, bool>
+UnorderedMap<KT, VT, Hash, KeyEqual>::insert_or_assign(const KT &key,
+                                                       const VT &value) {
+  auto result = table_.emplaceUnique(key, value);
+  if (!result.second) {
+    result.first.second() = value;
+  }
+  return result;
+}
+
+// Constructs the value from args in place if the key is missing
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+template <class... Args>
+std::pair<typename UnorderedMap<KT, VT, Hash, KeyEqual>::iterator, bool>
+UnorderedMap<KT, VT, Hash, KeyEqual>::try_emplace(const KT &key,
+                                                  Args &&...args) {
+  return table_.emplaceUnique(key, std::forward<Args>(args)...);
+}
+
+// try_emplace for a temporary key, which is moved only if it gets inserted
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+template <class... Args>
+std::pair<typename UnorderedMap<KT, VT, Hash, KeyEqual>::iterator, bool>
+UnorderedMap<KT, VT, Hash, KeyEqual>::try_emplace(KT &&key, Args &&...args) {
+  return table_.emplaceUnique(std::move(key), std::forward<Args>(args)...);
+}
+
+// Removes the element at pos
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+void UnorderedMap<KT, VT, Hash, KeyEqual>::erase(iterator pos) {
+  table_.erase(pos);
+}
+
+// Removes the element with key and returns how many were removed
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+typename UnorderedMap<KT, VT, Hash, KeyEqual>::size_type
+UnorderedMap<KT, VT, Hash, KeyEqual>::erase(const KT &key) {
+  return table_.erase(key);
+}
+
+// Swaps the contents
+template <typename KT, typename VT, typename Hash, typename KeyEqual>
+void UnorderedMap<KT, VT, Hash, KeyEqual>::swap(UnorderedMap &other) noexcept {
+  table_.swap(other.table_);
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_UNORDEREDMAP_S21_UNORDERED_MAP_H_
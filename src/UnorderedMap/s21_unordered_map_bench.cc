@@ -0,0 +1,92 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "../Map/s21_map.h"
+#include "s21_unordered_map.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+template <typename MapT>
+void unorderedOne(const char *name, const std::vector<int> &keys,
+                  const std::vector<int> &misses, bool reserve) {
+  MapT map;
+  auto start = Clock::now();
+  if constexpr (!std::is_same_v<MapT, s21::Map<int, int>>) {
+    if (reserve) {
+      map.reserve(keys.size());
+    }
+  }
+  for (int key : keys) {
+    map[key] = key;
+  }
+  double insert = secondsSince(start);
+  long long found = 0;
+  start = Clock::now();
+  for (int key : keys) {
+    found += map.find(key) != map.end();
+  }
+  double hit = secondsSince(start);
+  start = Clock::now();
+  for (int key : misses) {
+    found += map.find(key) != map.end();
+  }
+  double miss = secondsSince(start);
+  start = Clock::now();
+  for (size_t i = 0; i < keys.size(); ++i) {
+    auto it = map.find(keys[i]);
+    if (it != map.end()) {
+      map.erase(it);
+    }
+    map[misses[i]] = 0;
+  }
+  double churn = secondsSince(start);
+  std::printf("  %-26s insert %.3fs hit %.3fs miss %.3fs churn %.3fs (%lld)\n",
+              name, insert, hit, miss, churn, found);
+}
+
+// Random int keys: building, successful and failed lookups, then replacing
+// every key by erasing it and inserting a new one at constant size
+void unordered(int count) {
+  int size = std::min(count, 1 << 22);
+  std::mt19937 random(37);
+  std::vector<int> keys(size);
+  std::vector<int> misses(size);
+  for (int i = 0; i < size; ++i) {
+    keys[i] = static_cast<int>(random() >> 1);
+    misses[i] = -static_cast<int>(random() >> 1) - 1;
+  }
+  std::printf("unordered n=%d\n", size);
+  unorderedOne<s21::Map<int, int>>("Map", keys, misses, false);
+  unorderedOne<std::unordered_map<int, int>>("std::unordered_map", keys,
+                                             misses, false);
+  unorderedOne<s21::UnorderedMap<int, int>>("UnorderedMap", keys, misses,
+                                            false);
+  unorderedOne<s21::UnorderedMap<int, int>>("UnorderedMap reserved", keys,
+                                            misses, true);
+}
+
+}  // namespace
+
+// Usage: s21_unordered_map_bench [name] [count]
+int main(int argc, char **argv) {
+  const char *name = argc > 1 ? argv[1] : "all";
+  int count = argc > 2 ? std::atoi(argv[2]) : 10000000;
+  bool all = std::strcmp(name, "all") == 0;
+  if (all || std::strcmp(name, "unordered") == 0) {
+    unordered(count);
+  }
+  return 0;
+}
@@ -0,0 +1,171 @@
+#include "s21_unordered_map.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+
+// Sends keys to a handful of home slots, so runs get long, wrap around the
+// end of the table and overlap each other
+struct ClusteringHash {
+  size_t operator()(int key) const { return static_cast<size_t>(key % 5); }
+};
+
+// Gives the keys of each thousand one home slot
+struct GroupHash {
+  size_t operator()(int key) const { return static_cast<size_t>(key / 1000); }
+};
+
+// Checks that the map holds exactly the items of expected
+template <class Hash>
+void assertHolds(s21::UnorderedMap<int, int, Hash> &map,
+                 const std::map<int, int> &expected) {
+  ASSERT_EQ(map.size(), expected.size());
+  for (const auto &item : expected) {
+    ASSERT_TRUE(map.contains(item.first)) << item.first;
+    ASSERT_EQ(map.at(item.first), item.second);
+  }
+}
+
+TEST(UnorderedMap, string_keys_copy_and_move) {
+  s21::UnorderedMap<std::string, int> map{{"one", 1}, {"two", 2}};
+  ASSERT_FALSE(map.insert({"two", 20}).second);
+  ASSERT_FALSE(map.try_emplace("two", 20).second);
+  ASSERT_EQ(map["two"], 2);
+  ASSERT_THROW(map.at("three"), std::out_of_range);
+  map.erase(map.find("one"));
+  // The copy owns its own table
+  s21::UnorderedMap<std::string, int> copy(map);
+  map.clear();
+  ASSERT_TRUE(map.begin() == map.end());
+  ASSERT_EQ(copy.at("two"), 2);
+  map = std::move(copy);
+  ASSERT_EQ(map.size(), 1U);
+}
+
+TEST(UnorderedMap, runs_wrap_around_the_end) {
+  const int kRun = 24;
+  s21::UnorderedMap<int, int, GroupHash> map;
+  map.reserve(40);
+  const size_t buckets = map.bucket_count();
+  // Iteration goes by slot, so a run that crosses the end of the table
+  // shows up as a later key of the group coming first
+  int group = 0;
+  for (; group < 1000; ++group) {
+    map.clear();
+    for (int i = 0; i < kRun; ++i) {
+      map.insert(group * 1000 + i, i);
+    }
+    if (map.begin().first() != group * 1000) {
+      break;
+    }
+  }
+  ASSERT_LT(group, 1000);
+  ASSERT_EQ(map.bucket_count(), buckets);
+  const int base = group * 1000;
+  std::map<int, int> expected;
+  for (int i = 0; i < kRun; ++i) {
+    expected[base + i] = i;
+  }
+  // Erasing the head of the run, in the last slots, shifts the wrapped keys
+  // back across the end
+  ASSERT_EQ(map.erase(base), 1U);
+  expected.erase(base);
+  assertHolds(map, expected);
+  for (int i = 1; i < kRun; i += 3) {
+    ASSERT_EQ(map.erase(base + i), 1U);
+    expected.erase(base + i);
+    assertHolds(map, expected);
+  }
+  // A miss in the group scans the whole run, across the end
+  ASSERT_FALSE(map.contains(base + 500));
+  ASSERT_EQ(map.erase(base + 500), 0U);
+  // Filling the gaps back in, while another group's run may meet this one
+  for (int i = 0; i < kRun; ++i) {
+    map[base + i] = -i;
+    expected[base + i] = -i;
+    map[base + 1000 + i] = i;
+    expected[base + 1000 + i] = i;
+  }
+  assertHolds(map, expected);
+  ASSERT_EQ(map.bucket_count(), buckets);
+  while (!expected.empty()) {
+    auto it = map.begin();
+    ASSERT_EQ(expected.erase(it.first()), 1U);
+    map.erase(it);
+    assertHolds(map, expected);
+  }
+}
+
+TEST(UnorderedMap, long_runs_survive_erasing) {
+  s21::UnorderedMap<int, int, ClusteringHash> map;
+  std::map<int, int> expected;
+  for (int round = 0; round < 4; ++round) {
+    for (int i = 0; i < 200; ++i) {
+      map[i * 3 + round] = i;
+      expected[i * 3 + round] = i;
+    }
+    for (int i = 0; i < 600; i += 7) {
+      ASSERT_EQ(map.erase(i), expected.erase(i));
+    }
+    assertHolds(map, expected);
+  }
+  while (!expected.empty()) {
+    auto it = map.begin();
+    ASSERT_EQ(expected.erase(it.first()), 1U);
+    map.erase(it);
+    ASSERT_EQ(map.size(), expected.size());
+  }
+  ASSERT_TRUE(map.begin() == map.end());
+}
+
+TEST(UnorderedMap, reserve_keeps_slots) {
+  s21::UnorderedMap<int, std::string> map;
+  ASSERT_EQ(map.bucket_count(), 0U);
+  map.reserve(1000);
+  size_t buckets = map.bucket_count();
+  ASSERT_GE(buckets, 1000U);
+  for (int i = 0; i < 1000; ++i) {
+    map.insert(i, std::to_string(i));
+  }
+  ASSERT_EQ(map.bucket_count(), buckets);
+  ASSERT_LE(map.load_factor(), 1.0f);
+  for (int i = 0; i < 1000; i += 2) {
+    map.erase(i);
+  }
+  for (int i = 1; i < 1000; i += 2) {
+    ASSERT_EQ(map.at(i), std::to_string(i));
+  }
+  map.clear();
+  ASSERT_EQ(map.bucket_count(), buckets);
+}
+
+TEST(UnorderedMap, insert_copies_own_element_while_growing) {
+  // Long strings live on the heap, so a copy read after the rehash freed
+  // the old slots shows up as a wrong value or under a sanitizer
+  const std::string first(100, 'a');
+  const std::string second(100, 'b');
+  s21::UnorderedMap<int, std::string> map{{0, first}, {1, second}};
+  for (int key = 2; key < 300; ++key) {
+    size_t buckets = map.bucket_count();
+    if (key % 2) {
+      ASSERT_TRUE(map.insert(key, map.at(0)).second);
+    } else {
+      ASSERT_TRUE(map.try_emplace(key, map.at(1)).second);
+    }
+    ASSERT_EQ(map.at(key), key % 2 ? first : second) << key << " " << buckets;
+  }
+  ASSERT_GT(map.bucket_count(), 256U);
+}
+
+TEST(UnorderedMap, reserve_too_much) {
+  s21::UnorderedMap<int, int> map{{1, 1}};
+  ASSERT_THROW(map.reserve(map.max_size() + 1), std::length_error);
+  ASSERT_THROW(map.reserve(static_cast<size_t>(-1) / 2), std::length_error);
+  ASSERT_EQ(map.at(1), 1);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
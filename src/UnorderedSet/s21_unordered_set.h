@@ -0,0 +1,222 @@
+#ifndef CPP2_S21_CONTAINERS_SRC_UNORDEREDSET_S21_UNORDERED_SET_H_
+#define CPP2_S21_CONTAINERS_SRC_UNORDEREDSET_S21_UNORDERED_SET_H_
+
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+#include "../UnorderedMap/FlatTable.h"
+
+namespace s21 {
+
+// Hash set with the surface of Set and no key order, on the same open
+// addressing table as UnorderedMap. Inserting and erasing invalidate
+// iterators
+template <typename KT, typename Hash = std::hash<KT>,
+          typename KeyEqual = std::equal_to<KT>>
+class UnorderedSet {
+  using key_type = KT;
+  using value_type = KT;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using table_type = FlatTable<KT, KeyOnly, Hash, KeyEqual>;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+
+ public:
+  using iterator = typename table_type::iterator;
+  using const_iterator = iterator;
+
+  UnorderedSet();
+  explicit UnorderedSet(std::initializer_list<value_type> const &items);
+  UnorderedSet(const UnorderedSet &other);
+  UnorderedSet(UnorderedSet &&other) noexcept;
+  UnorderedSet &operator=(const UnorderedSet &other);
+  UnorderedSet &operator=(UnorderedSet &&other) noexcept;
+
+  iterator begin();
+  iterator end();
+
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+  size_type bucket_count() const noexcept;
+  void reserve(size_type count);
+
+  void clear();
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  void erase(iterator pos);
+  size_type erase(const KT &key);
+  void swap(UnorderedSet &other) noexcept;
+
+  iterator find(const KT &key);
+  bool contains(const KT &key);
+  size_type count(const KT &key);
+
+ private:
+  table_type table_;
+};
+
+// Default constructor, creates an empty set without allocating
+template <typename KT, typename Hash, typename KeyEqual>
+UnorderedSet<KT, Hash, KeyEqual>::UnorderedSet() : table_() {}
+
+// Initializer list constructor, sized for the list up front
+template <typename KT, typename Hash, typename KeyEqual>
+UnorderedSet<KT, Hash, KeyEqual>::UnorderedSet(
+    std::initializer_list<value_type> const &items)
+    : table_() {
+  reserve(items.size());
+  for (const auto &item : items) {
+    insert(item);
+  }
+}
+
+// Copy constructor
+template <typename KT, typename Hash, typename KeyEqual>
+UnorderedSet<KT, Hash, KeyEqual>::UnorderedSet(const UnorderedSet &other)
+    : table_(other.table_) {}
+
+// Move constructor
+template <typename KT, typename Hash, typename KeyEqual>
+UnorderedSet<KT, Hash, KeyEqual>::UnorderedSet(UnorderedSet &&other) noexcept
+    : table_(std::move(other.table_)) {}
+
+// Assignment operator overload for copy object
+template <typename KT, typename Hash, typename KeyEqual>
+UnorderedSet<KT, Hash, KeyEqual> &UnorderedSet<KT, Hash, KeyEqual>::operator=(
+    const UnorderedSet &other) {
+  table_ = other.table_;
+  return *this;
+}
+
+// Assignment operator overload for moving object
+template <typename KT, typename Hash, typename KeyEqual>
+UnorderedSet<KT, Hash, KeyEqual> &UnorderedSet<KT, Hash, KeyEqual>::operator=(
+    UnorderedSet &&other) noexcept {
+  if (this != &other) {
+    table_.swap(other.table_);
+  }
+  return *this;
+}
+
+// Returns an iterator to the first element in slot order
+template <typename KT, typename Hash, typename KeyEqual>
+typename UnorderedSet<KT, Hash, KeyEqual>::iterator
+UnorderedSet<KT, Hash, KeyEqual>::begin() {
+  return table_.begin();
+}
+
+// Returns an iterator to the end
+template <typename KT, typename Hash, typename KeyEqual>
+typename UnorderedSet<KT, Hash, KeyEqual>::iterator
+UnorderedSet<KT, Hash, KeyEqual>::end() {
+  return table_.end();
+}
+
+// Checks whether the container is empty
+template <typename KT, typename Hash, typename KeyEqual>
+bool UnorderedSet<KT, Hash, KeyEqual>::empty() const noexcept {
+  return table_.size() == 0;
+}
+
+// Returns the number of elements
+template <typename KT, typename Hash, typename KeyEqual>
+typename UnorderedSet<KT, Hash, KeyEqual>::size_type
+UnorderedSet<KT, Hash, KeyEqual>::size() const noexcept {
+  return table_.size();
+}
+
+// Returns the maximum possible number of elements
+template <typename KT, typename Hash, typename KeyEqual>
+typename UnorderedSet<KT, Hash, KeyEqual>::size_type
+UnorderedSet<KT, Hash, KeyEqual>::max_size() const noexcept {
+  return table_type::maxSize();
+}
+
+// Returns the number of slots in the table
+template <typename KT, typename Hash, typename KeyEqual>
+typename UnorderedSet<KT, Hash, KeyEqual>::size_type
+UnorderedSet<KT, Hash, KeyEqual>::bucket_count() const noexcept {
+  return table_.capacity();
+}
+
+// Makes room for count elements, so inserting up to that many never rehashes
+template <typename KT, typename Hash, typename KeyEqual>
+void UnorderedSet<KT, Hash, KeyEqual>::reserve(size_type count) {
+  table_.reserve(count);
+}
+
+// Clears the contents, the table keeps its slots
+template <typename KT, typename Hash, typename KeyEqual>
+void UnorderedSet<KT, Hash, KeyEqual>::clear() {
+  table_.clear();
+}
+
+// Inserts value unless it is present
+template <typename KT, typename Hash, typename KeyEqual>
+std::pair<typename UnorderedSet<KT, Hash, KeyEqual>::iterator, bool>
+UnorderedSet<KT, Hash, KeyEqual>::insert(const KT &value) {
+  return table_.emplaceUnique(value);
+}
+
+// Inserts a temporary value, which is moved into the table if it is missing
+template <typename KT, typename Hash, typename KeyEqual>
+std::pair<typename UnorderedSet<KT, Hash, KeyEqual>::iterator, bool>
+UnorderedSet<KT, Hash, KeyEqual>::insert(KT &&value) {
+  return table_.emplaceUnique(std::move(value));
+}
+
+// Constructs a value from args and moves it into the table if it is missing
+template <typename KT, typename Hash, typename KeyEqual>
+template <class... Args>
+std::pair<typename UnorderedSet<KT, Hash, KeyEqual>::iterator, bool>
+UnorderedSet<KT, Hash, KeyEqual>::emplace(Args &&...args) {
+  return table_.emplaceUnique(KT(std::forward<Args>(args)...));
+}
+
+// Removes the element at pos
+template <typename KT, typename Hash, typename KeyEqual>
+void UnorderedSet<KT, Hash, KeyEqual>::erase(iterator pos) {
+  table_.erase(pos);
+}
+
+// Removes key and returns how many elements were removed
+template <typename KT, typename Hash, typename KeyEqual>
+typename UnorderedSet<KT, Hash, KeyEqual>::size_type
+UnorderedSet<KT, Hash, KeyEqual>::erase(const KT &key) {
+  return table_.erase(key);
+}
+
+// Swaps the contents
+template <typename KT, typename Hash, typename KeyEqual>
+void UnorderedSet<KT, Hash, KeyEqual>::swap(UnorderedSet &other) noexcept {
+  table_.swap(other.table_);
+}
+
+// Finds an element with key equivalent to key
+template <typename KT, typename Hash, typename KeyEqual>
+typename UnorderedSet<KT, Hash, KeyEqual>::iterator
+UnorderedSet<KT, Hash, KeyEqual>::find(const KT &key) {
+  return table_.find(key);
+}
+
+// Checks if there is an element with key equivalent to key in the container
+template <typename KT, typename Hash, typename KeyEqual>
+bool UnorderedSet<KT, Hash, KeyEqual>::contains(const KT &key) {
+  return table_.find(key) != table_.end();
+}
+
+// Returns the number of elements equal to key, zero or one
+template <typename KT, typename Hash, typename KeyEqual>
+typename UnorderedSet<KT, Hash, KeyEqual>::size_type
+UnorderedSet<KT, Hash, KeyEqual>::count(const KT &key) {
+  return contains(key) ? 1 : 0;
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_UNORDEREDSET_S21_UNORDERED_SET_H_
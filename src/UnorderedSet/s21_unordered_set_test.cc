@@ -0,0 +1,88 @@
+#include "s21_unordered_set.h"
+
+#include <gtest/gtest.h>
+
+#include <cctype>
+#include <set>
+#include <string>
+
+// Hashes every key to the same value, so all keys share one run and every
+// probe matches on the hash bits and falls through to the key comparison
+struct SameHash {
+  size_t operator()(const std::string &) const { return 42; }
+};
+
+// Compares ASCII letters case-insensitively
+struct NoCaseEqual {
+  bool operator()(const std::string &left, const std::string &right) const {
+    if (left.size() != right.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < left.size(); ++i) {
+      if (std::tolower(static_cast<unsigned char>(left[i])) !=
+          std::tolower(static_cast<unsigned char>(right[i]))) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+TEST(UnorderedSet, basic_operations) {
+  s21::UnorderedSet<int> set{5, 1, 3, 1};
+  ASSERT_EQ(set.size(), 3U);
+  ASSERT_TRUE(set.insert(4).second);
+  auto result = set.insert(3);
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(*result.first, 3);
+  ASSERT_TRUE(set.emplace(2).second);
+  ASSERT_TRUE(set.contains(2));
+  ASSERT_EQ(set.count(6), 0U);
+  ASSERT_EQ(*set.find(5), 5);
+  ASSERT_TRUE(set.find(6) == set.end());
+  ASSERT_EQ(set.erase(4), 1U);
+  ASSERT_EQ(set.erase(4), 0U);
+  set.erase(set.find(1));
+  std::set<int> items(set.begin(), set.end());
+  ASSERT_EQ(items, (std::set<int>{2, 3, 5}));
+
+  s21::UnorderedSet<int> other{7};
+  set.swap(other);
+  ASSERT_EQ(set.size(), 1U);
+  ASSERT_EQ(other.size(), 3U);
+  set.clear();
+  ASSERT_TRUE(set.empty());
+  ASSERT_TRUE(set.begin() == set.end());
+}
+
+TEST(UnorderedSet, colliding_hashes_use_key_equal) {
+  s21::UnorderedSet<std::string, SameHash, NoCaseEqual> set;
+  std::set<std::string> expected;
+  // More keys than a control group holds, so the run spans several groups
+  for (int i = 0; i < 100; ++i) {
+    std::string key = "key" + std::to_string(i);
+    ASSERT_TRUE(set.insert(key).second);
+    expected.insert(key);
+  }
+  ASSERT_FALSE(set.insert("KEY7").second);
+  ASSERT_EQ(*set.find("Key7"), "key7");
+  ASSERT_FALSE(set.contains("key100"));
+  for (int i = 0; i < 100; i += 3) {
+    ASSERT_EQ(set.erase("KEY" + std::to_string(i)), 1U);
+    expected.erase("key" + std::to_string(i));
+  }
+  ASSERT_EQ(set.size(), expected.size());
+  ASSERT_EQ(std::set<std::string>(set.begin(), set.end()), expected);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(set.contains("Key" + std::to_string(i)), i % 3 != 0);
+  }
+  s21::UnorderedSet<std::string, SameHash, NoCaseEqual> copy(set);
+  ASSERT_TRUE(copy.insert("Key0").second);
+  ASSERT_EQ(copy.count("kEy0"), 1U);
+  ASSERT_EQ(set.count("kEy0"), 0U);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -103,7 +103,8 @@ Vector<T>::Vector(Vector &&origin) noexcept : Vector() {
 template <class T>
 Vector<T> &Vector<T>::operator=(
     std::initializer_list<value_type> const &items) {
-  swap(Vector<T>(items));
+  Vector<T> tmp(items);
+  swap(tmp);
   return *this;
 }
 
@@ -111,7 +112,8 @@ Vector<T> &Vector<T>::operator=(
 template <class T>
 Vector<T> &Vector<T>::operator=(const Vector<T> &origin) {
   if (this == &origin) return *this;
-  swap(Vector<T>(origin));
+  Vector<T> tmp(origin);
+  swap(tmp);
   return *this;
 }
 
@@ -216,11 +218,12 @@ void Vector<T>::shrink_to_fit() {
   tmp.swap(*this);
 }
 
-// Clears the contents
+// Clears the contents. The storage comes from new[], which destroys every
+// slot itself, so elements are reset to T() rather than destroyed here
 template <class T>
 void Vector<T>::clear() noexcept {
   for (size_type i = 0; i < size_; ++i) {
-    storage_[i].~T();
+    storage_[i] = T();
   }
   size_ = 0;
 }
@@ -289,20 +292,25 @@ void Vector<T>::erase(iterator pos) {
   tmp.swap(*this);
 }
 
-// Adds an element to the end
+// Adds an element to the end. value may be an element of this vector, so
+// when the storage grows it is copied before the old storage is freed
 template <class T>
 void Vector<T>::push_back(const_reference value) {
   if (size_ + 1 > capacity_) {
-    reserve(capacity_ * 2);  // Increase capacity if needed
+    s21::Vector<T> tmp;
+    tmp.reallocate(capacity_ ? capacity_ * 2 : 1, size_, storage_);
+    tmp.storage_[size_] = value;
+    tmp.swap(*this);
+  } else {
+    storage_[size_] = value;
   }
-  storage_[size_] = value;
   ++size_;
 }
 
-// Removes the last element
+// Removes the last element, resetting its slot like clear
 template <class T>
 void Vector<T>::pop_back() {
-  storage_[--size_].~T();
+  storage_[--size_] = T();
 }
 
 // Swaps the contents
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include <cstring>
+#include <string>
 #include <vector>
 
 // Constructors
@@ -229,6 +230,30 @@ TEST(Vector, Modifier_push_back) {
   EXPECT_TRUE(vec.data()[3] == std_vec.data()[3]);
 }
 
+TEST(Vector, Modifier_push_back_own_element) {
+  s21::Vector<std::string> vec{std::string(32, 'x')};
+  for (int i = 0; i < 20; ++i) {
+    vec.push_back(vec[0]);
+  }
+  EXPECT_EQ(vec.size(), 21U);
+  EXPECT_EQ(vec[20], std::string(32, 'x'));
+}
+
+TEST(Vector, Modifier_push_back_strings) {
+  s21::Vector<std::string> vec;
+  for (int i = 0; i < 20; ++i) {
+    vec.push_back(std::string(32, static_cast<char>('a' + i)));
+  }
+  vec.pop_back();
+  vec.push_back("last");
+  EXPECT_EQ(vec.size(), 20U);
+  EXPECT_EQ(vec[0], std::string(32, 'a'));
+  EXPECT_EQ(vec[19], "last");
+  vec.clear();
+  vec.push_back("again");
+  EXPECT_EQ(vec[0], "again");
+}
+
 TEST(Vector, Modifier_pop_back) {
   s21::Vector<int> vec{100, 200, 300};
   std::vector<int> std_vec{100, 200, 300};
@@ -16,6 +16,16 @@
 #define CPP2_S21_CONTAINERS_SRC_S21_CONTAINERSPLUS_H_
 
 #include "./Array/s21_array.h"
+#include "./Map/s21_concurrent_map.h"
+#include "./Map/s21_flat_map.h"
+#include "./Map/s21_mapped_map.h"
+#include "./Map/s21_persistent_map.h"
+#include "./Map/s21_radix_map.h"
+#include "./Set/s21_concurrent_set.h"
+#include "./Set/s21_flat_set.h"
+#include "./Set/s21_mapped_set.h"
+#include "./UnorderedMap/s21_unordered_map.h"
+#include "./UnorderedSet/s21_unordered_set.h"
 #include "./Multiset/s21_multiset.h"
 
 #endif  // CPP2_S21_CONTAINERS_SRC_S21_CONTAINERSPLUS_H_